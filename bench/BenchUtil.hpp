@@ -0,0 +1,44 @@
+// bench/BenchUtil.hpp
+#ifndef BENCH_UTIL_HPP
+#define BENCH_UTIL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench {
+
+// Prevent the optimiser from discarding a computed value
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run fn `iterations` times after a short warm-up and return the mean ns/op
+template<typename Fn>
+double measureNsPerOp(std::size_t iterations, Fn&& fn) {
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    return static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+}
+
+inline void report(const std::string& name, double nsPerOp) {
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << nsPerOp << " ns/op" << std::endl;
+}
+
+} // namespace bench
+
+#endif // BENCH_UTIL_HPP
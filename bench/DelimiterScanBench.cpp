@@ -0,0 +1,56 @@
+// bench/DelimiterScanBench.cpp
+#include "BenchUtil.hpp"
+#include "DelimiterScanner.hpp"
+#include "MarketDataProcessor.hpp"
+#include <sstream>
+
+int main() {
+    constexpr std::size_t kIterations = 1'000'000;
+
+    // A long FIX message with 30+ tags
+    std::string fixMessage = "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    for (int tag = 5000; tag < 5030; ++tag) {
+        fixMessage += std::to_string(tag) + "=VALUE" + std::to_string(tag) + "|";
+    }
+
+    bench::report("getline '|' + find '=' (baseline)",
+        bench::measureNsPerOp(kIterations, [&] {
+            std::istringstream stream(fixMessage);
+            std::string field;
+            std::size_t count = 0;
+            while (std::getline(stream, field, '|')) {
+                count += field.find('=');
+            }
+            bench::doNotOptimize(count);
+        }));
+
+    for (auto isa : {simd::Isa::SCALAR, simd::Isa::SSE2, simd::Isa::AVX2}) {
+        if (!simd::isaSupported(isa)) {
+            continue;
+        }
+        bench::report(std::string("DelimiterScanner '=' '|' ") + simd::isaName(isa),
+            bench::measureNsPerOp(kIterations, [&] {
+                DelimiterScanner scanner(fixMessage, '=', '|', isa);
+                std::size_t count = 0;
+                for (std::size_t pos = scanner.next(); pos != DelimiterScanner::npos; pos = scanner.next()) {
+                    count += pos;
+                }
+                bench::doNotOptimize(count);
+            }));
+    }
+
+    std::string marketData;
+    for (int i = 0; i < 30; ++i) {
+        marketData += "SYM" + std::to_string(i) + "," + std::to_string(100 + i) + ".25,";
+    }
+
+    MarketDataProcessor processor;
+    bench::report("MarketDataProcessor::process (60 fields)",
+        bench::measureNsPerOp(kIterations / 10, [&] {
+            auto fields = processor.process(marketData);
+            bench::doNotOptimize(fields);
+        }));
+
+    std::cout << "Active ISA: " << simd::isaName(simd::activeIsa()) << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+// bench/FixEncodeBench.cpp
+#include "BenchUtil.hpp"
+#include "FixEncoder.hpp"
+#include "FixMessageHandler.hpp"
+#include "FixSchema.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    constexpr std::size_t kIterations = 1'000'000;
+
+    std::unordered_map<std::string, std::string> fields = {
+        {"35", "8"}, {"37", "1"}, {"11", "ORDER123"}, {"17", "E1"}, {"150", "F"},
+        {"39", "2"}, {"55", "AAPL"}, {"54", "1"}, {"38", "100"}, {"32", "100"},
+        {"31", "150.50"}, {"151", "0"}, {"14", "100"}
+    };
+
+    FixMessageHandler handler;
+    std::size_t before = allocations.load();
+    double ns = bench::measureNsPerOp(kIterations, [&] {
+        auto message = handler.buildFixMessage(fields);
+        bench::doNotOptimize(message);
+    });
+    bench::report("buildFixMessage (unordered_map)", ns);
+    std::cout << "  allocations/op: "
+              << static_cast<double>(allocations.load() - before) / (kIterations * 1.1) << std::endl;
+
+    fix::ExecutionReport report;
+    report.orderId = "1";
+    report.clOrdId = "ORDER123";
+    report.execId = "E1";
+    report.execType = 'F';
+    report.ordStatus = '2';
+    report.symbol = "AAPL";
+    report.side = '1';
+    report.orderQty = Qty(100);
+    report.lastQty = Qty(100);
+    report.lastPx = Price(15050, 2);
+    report.cumQty = Qty(100);
+
+    char buffer[512];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    before = allocations.load();
+    ns = bench::measureNsPerOp(kIterations, [&] {
+        std::string_view message = fix::encode(report, encoder);
+        bench::doNotOptimize(message);
+    });
+    bench::report("fix::encode<ExecutionReport> (with 9 and 10)", ns);
+    std::cout << "  allocations/op: "
+              << static_cast<double>(allocations.load() - before) / (kIterations * 1.1) << std::endl;
+
+    ns = bench::measureNsPerOp(kIterations, [&] {
+        char out[48];
+        std::size_t length = FixEncoder::formatDecimal(out, 15050, 2);
+        bench::doNotOptimize(out[length - 1]);
+    });
+    bench::report("FixEncoder::formatDecimal", ns);
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+// bench/FixParseBench.cpp
+#include "BenchUtil.hpp"
+#include "FixMessageHandler.hpp"
+#include "FixSchema.hpp"
+
+int main() {
+    constexpr std::size_t kIterations = 1'000'000;
+
+    const std::string newOrder =
+        "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
+
+    // A long message with 30+ tags, as seen in bursts from some venues
+    std::string longMessage = newOrder;
+    for (int tag = 5000; tag < 5030; ++tag) {
+        longMessage += std::to_string(tag) + "=VALUE" + std::to_string(tag) + "|";
+    }
+
+    FixMessageHandler handler;
+
+    auto runCase = [&](const std::string& message, const std::string& label) {
+        bench::report("parseFixMessage map " + label,
+            bench::measureNsPerOp(kIterations, [&] {
+                auto fields = handler.parseFixMessage(message);
+                bench::doNotOptimize(fields);
+            }));
+
+        bench::report("parseFixMessageView " + label,
+            bench::measureNsPerOp(kIterations, [&] {
+                auto view = handler.parseFixMessageView(message);
+                bench::doNotOptimize(view.get(11));
+            }));
+    };
+
+    runCase(newOrder, "(NewOrderSingle)");
+
+    bench::report("fix::decode<NewOrderSingle> (typed)",
+        bench::measureNsPerOp(kIterations, [&] {
+            auto order = fix::decode<fix::NewOrderSingle>(newOrder);
+            bench::doNotOptimize(order.orderQty);
+        }));
+
+    runCase(longMessage, "(39 tags)");
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+// bench/FixedPointBench.cpp
+#include "BenchUtil.hpp"
+#include "FixedPoint.hpp"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+int main() {
+    constexpr std::size_t kIterations = 5'000'000;
+
+    const char* prices[] = {"150.50", "2750.00", "330.25", "0.0005", "3400.125", "98765.4321"};
+    constexpr std::size_t kPriceCount = sizeof(prices) / sizeof(prices[0]);
+    std::size_t i = 0;
+
+    bench::report("strtod",
+        bench::measureNsPerOp(kIterations, [&] {
+            double value = std::strtod(prices[i++ % kPriceCount], nullptr);
+            bench::doNotOptimize(value);
+        }));
+
+    bench::report("std::from_chars (double)",
+        bench::measureNsPerOp(kIterations, [&] {
+            const char* text = prices[i++ % kPriceCount];
+            double value = 0;
+            std::from_chars(text, text + std::char_traits<char>::length(text), value);
+            bench::doNotOptimize(value);
+        }));
+
+    bench::report("Price::tryParse",
+        bench::measureNsPerOp(kIterations, [&] {
+            Price price;
+            Price::tryParse(prices[i++ % kPriceCount], price);
+            bench::doNotOptimize(price.mantissa);
+        }));
+
+    bench::report("Price::tryParse (instrument scale 4)",
+        bench::measureNsPerOp(kIterations, [&] {
+            Price price;
+            Price::tryParse(prices[i++ % kPriceCount], price, 4);
+            bench::doNotOptimize(price.mantissa);
+        }));
+
+    char out[64];
+    double doubles[] = {150.50, 2750.00, 330.25, 0.05, 3400.12};
+    const Price fixedPrices[] = {Price(15050, 2), Price(275000, 2), Price(33025, 2), Price(5, 2), Price(340012, 2)};
+
+    bench::report("snprintf %.2f",
+        bench::measureNsPerOp(kIterations, [&] {
+            int length = std::snprintf(out, sizeof(out), "%.2f", doubles[i++ % 5]);
+            bench::doNotOptimize(out[length - 1]);
+        }));
+
+    bench::report("std::to_chars (double, fixed, 2)",
+        bench::measureNsPerOp(kIterations, [&] {
+            auto result = std::to_chars(out, out + sizeof(out), doubles[i++ % 5], std::chars_format::fixed, 2);
+            bench::doNotOptimize(*(result.ptr - 1));
+        }));
+
+    bench::report("Price::format",
+        bench::measureNsPerOp(kIterations, [&] {
+            std::size_t length = fixedPrices[i++ % 5].format(out);
+            bench::doNotOptimize(out[length - 1]);
+        }));
+
+    const char* quantities[] = {"100", "50", "75", "25", "150", "1000000"};
+    bench::report("std::from_chars (int64)",
+        bench::measureNsPerOp(kIterations, [&] {
+            const char* text = quantities[i++ % 6];
+            int64_t value = 0;
+            std::from_chars(text, text + std::char_traits<char>::length(text), value);
+            bench::doNotOptimize(value);
+        }));
+
+    bench::report("Qty::tryParse",
+        bench::measureNsPerOp(kIterations, [&] {
+            Qty qty;
+            Qty::tryParse(quantities[i++ % 6], qty);
+            bench::doNotOptimize(qty.value);
+        }));
+
+    bench::report("std::to_chars (int64)",
+        bench::measureNsPerOp(kIterations, [&] {
+            auto result = std::to_chars(out, out + sizeof(out), static_cast<int64_t>(100 + i++ % 1000));
+            bench::doNotOptimize(*(result.ptr - 1));
+        }));
+
+    bench::report("Qty::format",
+        bench::measureNsPerOp(kIterations, [&] {
+            std::size_t length = Qty(static_cast<int64_t>(100 + i++ % 1000)).format(out);
+            bench::doNotOptimize(out[length - 1]);
+        }));
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+// bench/IoThreadsBench.cpp
+#include "BenchUtil.hpp"
+#include "NetworkServer.hpp"
+#include <atomic>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using boost::asio::ip::tcp;
+
+    constexpr std::size_t kMessages = 40'000;
+
+    // Swallows the server's per-message log lines while it runs
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    struct Result {
+        std::size_t connections;   // Seen by the server once every client is in
+        double connectUs;          // Until the server has accepted them all, per connection
+        double messagesPerSecond;
+        std::size_t naks;
+    };
+
+    // `clients` connections are opened together, then each sends new orders
+    // one at a time and waits for the ACK, the way NetworkClient does
+    Result run(std::size_t ioThreads, bool reusePort, std::size_t clients) {
+        network::ServerConfig config;
+        config.port = 0;
+        config.io_threads = ioThreads;
+        config.reuse_port_listeners = reusePort;
+        config.thread_pool_size = 2;
+        config.bounded_ingress_queue = true;
+        config.expected_orders = kMessages;
+        auto orders = std::make_shared<OrderManager>(config.expected_orders, config.order_manager_shards);
+        NetworkServer server(config, orders, std::make_shared<Logger>());
+        std::thread serverThread([&] { server.start(); });
+
+        std::atomic<std::size_t> naks{0};
+        std::atomic<bool> go{false};
+        std::size_t perClient = kMessages / clients;
+        auto connectStart = Clock::now();
+        std::vector<std::thread> senders;
+        for (std::size_t c = 0; c < clients; ++c) {
+            senders.emplace_back([&, c] {
+                boost::asio::io_context context;
+                tcp::socket socket(context);
+                socket.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), server.port()));
+                socket.set_option(tcp::no_delay(true));
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                boost::asio::streambuf ack;
+                for (std::size_t i = 0; i < perClient; ++i) {
+                    std::string request = "35=D|49=SENDER|56=TARGET|11=C" + std::to_string(c) + "-" +
+                                          std::to_string(i) + "|55=AAPL|54=1|44=150.50|38=100|40=2|\n";
+                    boost::asio::write(socket, boost::asio::buffer(request));
+                    std::size_t length = boost::asio::read_until(socket, ack, '\n');
+                    if (*boost::asio::buffers_begin(ack.data()) == 'N') {
+                        naks.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    ack.consume(length);
+                }
+            });
+        }
+        while (server.getStatistics().active_connections < clients) {
+            std::this_thread::yield();
+        }
+        double connectUs = std::chrono::duration<double, std::micro>(Clock::now() - connectStart).count() /
+                           static_cast<double>(clients);
+        std::size_t connections = server.getStatistics().active_connections;
+
+        auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& sender : senders) {
+            sender.join();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        server.stop();
+        serverThread.join();
+        return Result{connections, connectUs, static_cast<double>(perClient * clients) / seconds, naks.load()};
+    }
+}
+
+int main() {
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer discard;
+    std::cout.rdbuf(&discard);
+
+    out << "Server io threads: " << kMessages << " orders, one in flight per connection, "
+        << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    out << std::left << std::setw(10) << "IO" << std::setw(14) << "Accept" << std::right
+        << std::setw(8) << "Conns" << std::setw(14) << "us/connect" << std::setw(14) << "msgs/s"
+        << std::setw(8) << "NAKs" << std::endl;
+
+    for (std::size_t clients : {1, 8, 64}) {
+        for (std::size_t ioThreads : {1, 2, 4}) {
+            for (bool reusePort : {true, false}) {
+                if (ioThreads == 1 && !reusePort) {
+                    continue;  // One listener either way
+                }
+                Result result = run(ioThreads, reusePort, clients);
+                out << std::left << std::setw(10) << ioThreads
+                    << std::setw(14) << (ioThreads == 1 ? "single" : reusePort ? "SO_REUSEPORT" : "round-robin")
+                    << std::right << std::setw(8) << result.connections
+                    << std::setw(14) << std::fixed << std::setprecision(1) << result.connectUs
+                    << std::setw(14) << std::setprecision(0) << result.messagesPerSecond
+                    << std::setw(8) << result.naks << std::endl;
+            }
+        }
+    }
+
+    std::cout.rdbuf(out.rdbuf());
+    return 0;
+}
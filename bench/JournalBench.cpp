@@ -0,0 +1,109 @@
+// bench/JournalBench.cpp
+#include "BenchUtil.hpp"
+#include "OrderJournal.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Mode {
+        const char* name;
+        bool fsync;
+        std::size_t groupEvents;
+        std::chrono::microseconds interval;
+        bool ackAfterDurable;
+        std::size_t events;
+    };
+
+    double percentile(std::vector<double> values, double p) {
+        std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+
+    // One writer appends as fast as it can while an acker thread waits for
+    // each event to become durable, as the network thread would before an
+    // ACK. The ACK latency added is the time from the start of the append to
+    // the ACK being released.
+    void run(const Mode& mode, const std::string& path, const JournalRecord& record) {
+        std::remove(path.c_str());
+        JournalConfig config;
+        config.path = path;
+        config.capacity = mode.events;
+        config.fsync = mode.fsync;
+        config.groupCommitEvents = mode.groupEvents;
+        config.groupCommitInterval = mode.interval;
+        OrderJournal journal(config);
+
+        std::vector<Clock::time_point> appended(mode.events);
+        std::vector<double> ackNs(mode.events);
+
+        std::thread acker;
+        if (mode.ackAfterDurable) {
+            acker = std::thread([&] {
+                for (std::size_t i = 0; i < mode.events; ++i) {
+                    while (journal.lastSequence() < i + 1) {
+                        std::this_thread::yield();
+                    }
+                    journal.waitDurable(i + 1);
+                    ackNs[i] = std::chrono::duration<double, std::nano>(Clock::now() - appended[i]).count();
+                }
+            });
+        }
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < mode.events; ++i) {
+            appended[i] = Clock::now();
+            journal.append(record);
+            if (!mode.ackAfterDurable) {
+                ackNs[i] = std::chrono::duration<double, std::nano>(Clock::now() - appended[i]).count();
+            }
+        }
+        if (acker.joinable()) {
+            acker.join();
+        }
+        journal.flush();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << std::left << std::setw(40) << mode.name
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(0)
+                  << static_cast<double>(mode.events) / seconds
+                  << std::setw(12) << percentile(ackNs, 0.50)
+                  << std::setw(12) << percentile(ackNs, 0.99) << std::endl;
+        std::remove(path.c_str());
+    }
+}
+
+int main(int argc, char** argv) {
+    // Pass a directory on the disk to be measured; defaults to the working directory
+    std::string path = std::string(argc > 1 ? argv[1] : ".") + "/journal_bench.bin";
+
+    fix::NewOrderSingle order;
+    order.clOrdId = "BENCH0000001";
+    order.symbol = "AAPL";
+    order.side = fix::side::Buy;
+    order.ordType = fix::ord_type::Limit;
+    order.price = Price::parse("150.25");
+    order.orderQty = Qty(100);
+    JournalRecord record = JournalRecord::newOrder(order);
+
+    const Mode modes[] = {
+        {"page cache only, ACK immediately", false, 64, std::chrono::microseconds(200), false, 1'000'000},
+        {"group commit 64/200us, ACK immediately", true, 64, std::chrono::microseconds(200), false, 1'000'000},
+        {"group commit 64/200us, ACK on durable", true, 64, std::chrono::microseconds(200), true, 200'000},
+        {"group commit 1024/1ms, ACK on durable", true, 1024, std::chrono::microseconds(1000), true, 200'000},
+        {"fsync every event, ACK on durable", true, 1, std::chrono::microseconds(0), true, 2'000},
+    };
+
+    std::cout << "Order journal (" << sizeof(JournalRecord) << "-byte records) at " << path << std::endl;
+    std::cout << std::left << std::setw(40) << "mode" << std::right << std::setw(14) << "events/sec"
+              << std::setw(12) << "ack p50 ns" << std::setw(12) << "ack p99 ns" << std::endl;
+    for (const Mode& mode : modes) {
+        run(mode, path, record);
+    }
+    return 0;
+}
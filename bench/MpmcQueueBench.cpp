@@ -0,0 +1,92 @@
+// bench/MpmcQueueBench.cpp
+#include "BenchUtil.hpp"
+#include "MessageQueue.hpp"
+#include "MpmcQueue.hpp"
+#include "NetworkTypes.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kMessages = 400'000;
+    constexpr std::size_t kBatch = 32;
+    const std::string kPayload = "35=D|49=SENDER|56=TARGET|11=ORD1|55=AAPL|54=1|44=150.50|38=100|40=2|";
+
+    // Messages per second through the queue with `threads` producers and as
+    // many consumers, each moving a network::Message like NetworkServer does
+    template<typename Push, typename Drain>
+    double run(std::size_t threads, Push&& push, Drain&& drain) {
+        std::atomic<std::size_t> received{0};
+        std::size_t perProducer = kMessages / threads;
+        std::size_t total = perProducer * threads;
+
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (std::size_t i = 0; i < perProducer; ++i) {
+                    push(network::Message(network::Message::Type::FIX, kPayload));
+                }
+            });
+            workers.emplace_back([&] {
+                std::vector<network::Message> batch;
+                batch.reserve(kBatch);
+                while (received.load(std::memory_order_relaxed) < total) {
+                    batch.clear();
+                    drain(batch);
+                    for (const auto& message : batch) {
+                        bench::doNotOptimize(message.payload.size());
+                    }
+                    received.fetch_add(batch.size(), std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return static_cast<double>(total) / std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+int main() {
+    std::size_t maxThreads = std::max<std::size_t>(4, std::thread::hardware_concurrency());
+    std::cout << "Ingress queue: " << kMessages << " messages, N producers + N consumers, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::left << std::setw(6) << "N" << std::right << std::setw(18) << "MessageQueue/s"
+              << std::setw(18) << "MpmcQueue/s" << std::setw(22) << "MpmcQueue pop_n/s" << std::endl;
+
+    for (std::size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        MessageQueue<network::Message> locked;
+        double lockedRate = run(threads,
+            [&](network::Message message) { locked.push(std::move(message)); },
+            [&](std::vector<network::Message>& batch) {
+                if (auto message = locked.pop(std::chrono::milliseconds(1))) {
+                    batch.push_back(std::move(*message));
+                }
+            });
+
+        MpmcQueue<network::Message> single(4096);
+        double singleRate = run(threads,
+            [&](network::Message message) { single.push(std::move(message)); },
+            [&](std::vector<network::Message>& batch) {
+                if (auto message = single.pop(std::chrono::milliseconds(1))) {
+                    batch.push_back(std::move(*message));
+                }
+            });
+
+        MpmcQueue<network::Message> batched(4096);
+        double batchedRate = run(threads,
+            [&](network::Message message) { batched.push(std::move(message)); },
+            [&](std::vector<network::Message>& batch) {
+                batched.pop_n(std::back_inserter(batch), kBatch, std::chrono::milliseconds(1));
+            });
+
+        std::cout << std::left << std::setw(6) << threads << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(18) << lockedRate << std::setw(18) << singleRate
+                  << std::setw(22) << batchedRate << std::endl;
+    }
+    return 0;
+}
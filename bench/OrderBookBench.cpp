@@ -0,0 +1,147 @@
+// bench/OrderBookBench.cpp
+#include "BenchUtil.hpp"
+#include "MatchingEngine.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Message mix loosely following public exchange feeds: mostly passive adds
+    // and cancels near the touch, with a minority of marketable orders
+    constexpr std::size_t kOperations = 1'000'000;
+    constexpr std::size_t kInitialDepth = 10'000;
+    constexpr int kAddPercent = 50;
+    constexpr int kCancelPercent = 40;  // The remaining 10% cross the spread
+
+    constexpr int64_t kMidTicks = 15000;  // 150.00 at a 0.01 tick
+    constexpr int64_t kBandTicks = 50;
+
+    enum class Op { Add, Cancel, Execute };
+
+    struct Sample {
+        Op op;
+        double ns;
+    };
+
+    double percentile(std::vector<double>& values, double p) {
+        if (values.empty()) {
+            return 0;
+        }
+        std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + rank, values.end());
+        return values[rank];
+    }
+}
+
+int main() {
+    MatchingEngine engine(kInitialDepth * 4);
+    engine.addSymbol("AAPL", BookConfig{Price(1, 2), Price(1000000, 2), Price(1, 2)});
+
+    std::mt19937_64 rng(7);
+    std::vector<std::string> ids;
+    ids.reserve(kInitialDepth + kOperations);
+    std::vector<std::size_t> live;  // Indices into ids that may still be resting
+    std::vector<Execution> reports;
+    reports.reserve(256);
+
+    auto makeOrder = [&](bool aggressive) {
+        ids.push_back("O" + std::to_string(ids.size()));
+        fix::NewOrderSingle order;
+        order.clOrdId = ids.back();
+        order.symbol = "AAPL";
+        order.side = (rng() & 1) ? fix::side::Buy : fix::side::Sell;
+        order.ordType = fix::ord_type::Limit;
+        int64_t offset = 1 + static_cast<int64_t>(rng() % kBandTicks);
+        bool buy = order.side == fix::side::Buy;
+        // Passive orders rest on their own side; aggressive ones reach across
+        int64_t ticks = (buy != aggressive) ? kMidTicks - offset : kMidTicks + offset;
+        order.price = Price(ticks, 2);
+        order.orderQty = Qty(100 * (1 + static_cast<int64_t>(rng() % 10)));
+        return order;
+    };
+
+    for (std::size_t i = 0; i < kInitialDepth; ++i) {
+        engine.submit(makeOrder(false), reports);
+        live.push_back(ids.size() - 1);
+        reports.clear();
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(kOperations);
+    std::size_t fills = 0;
+
+    for (std::size_t i = 0; i < kOperations; ++i) {
+        int roll = static_cast<int>(rng() % 100);
+        Op op = roll < kAddPercent ? Op::Add
+              : roll < kAddPercent + kCancelPercent ? Op::Cancel : Op::Execute;
+
+        fix::NewOrderSingle order;
+        fix::OrderCancelRequest cancel;
+        if (op == Op::Cancel) {
+            // Pick a random order that is still resting; fills remove some
+            while (!live.empty()) {
+                std::size_t pick = rng() % live.size();
+                std::swap(live[pick], live.back());
+                if (engine.findOrder(ids[live.back()])) {
+                    break;
+                }
+                live.pop_back();
+            }
+            if (live.empty()) {
+                continue;
+            }
+            cancel.clOrdId = "CXL";
+            cancel.origClOrdId = ids[live.back()];
+            live.pop_back();
+        } else {
+            order = makeOrder(op == Op::Execute);
+        }
+
+        reports.clear();
+        auto start = std::chrono::steady_clock::now();
+        if (op == Op::Cancel) {
+            engine.cancel(cancel, reports);
+        } else {
+            engine.submit(order, reports);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        samples.push_back({op, static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())});
+        fills += reports.size() > 1 ? (reports.size() - 1) / 2 : 0;
+        if (op == Op::Add) {
+            live.push_back(ids.size() - 1);
+        }
+    }
+
+    std::cout << "Order book, " << samples.size() << " operations ("
+              << kAddPercent << "% add, " << kCancelPercent << "% cancel, "
+              << (100 - kAddPercent - kCancelPercent) << "% marketable), "
+              << fills << " fills, " << engine.restingOrders() << " resting at end" << std::endl;
+
+    const std::pair<Op, const char*> kinds[] = {
+        {Op::Add, "add"}, {Op::Cancel, "cancel"}, {Op::Execute, "marketable"}};
+    std::vector<double> all;
+    for (const auto& [kind, name] : kinds) {
+        std::vector<double> values;
+        for (const auto& sample : samples) {
+            if (sample.op == kind) {
+                values.push_back(sample.ns);
+            }
+        }
+        all.insert(all.end(), values.begin(), values.end());
+        double mean = 0;
+        for (double v : values) {
+            mean += v;
+        }
+        mean /= static_cast<double>(std::max<std::size_t>(values.size(), 1));
+        bench::report(std::string(name) + " mean", mean);
+        bench::report(std::string(name) + " p99", percentile(values, 0.99));
+    }
+    bench::report("all p50", percentile(all, 0.50));
+    bench::report("all p99", percentile(all, 0.99));
+    bench::report("all p99.9", percentile(all, 0.999));
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+// bench/OrderIndexBench.cpp
+#include "BenchUtil.hpp"
+#include "OrderIndex.hpp"
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kEntries = 1'000'000;
+
+    using Clock = std::chrono::steady_clock;
+
+    double nsSince(Clock::time_point start) {
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    // Inserts every id one at a time, starting from a small table so growth
+    // happens during the run, and records the slowest single insert
+    template<typename InsertFn>
+    void runInserts(const std::string& name, std::size_t count, InsertFn&& insert) {
+        double worst = 0;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto before = Clock::now();
+            insert(i);
+            worst = std::max(worst, nsSince(before));
+        }
+        bench::report(name + " insert", nsSince(start) / static_cast<double>(count));
+        bench::report(name + " worst single insert", worst);
+    }
+}
+
+int main() {
+    std::vector<std::string> ids;
+    std::vector<ClOrdId> keys;
+    ids.reserve(kEntries);
+    keys.reserve(kEntries);
+    for (std::size_t i = 0; i < kEntries; ++i) {
+        ids.push_back("CLIENT-" + std::to_string(i * 7919 % 10'000'019));
+        keys.emplace_back(ids.back());
+    }
+
+    std::cout << "ClOrdID index, " << kEntries << " entries" << std::endl;
+
+    std::unordered_map<std::string, uint32_t> map;
+    runInserts("unordered_map<string>", kEntries, [&](std::size_t i) {
+        map.emplace(ids[i], static_cast<uint32_t>(i));
+    });
+
+    OrderIndex index;
+    runInserts("OrderIndex", kEntries, [&](std::size_t i) {
+        index.insert(keys[i], static_cast<uint32_t>(i));
+    });
+
+    std::size_t cursor = 0;
+    bench::report("unordered_map<string> find", bench::measureNsPerOp(kEntries, [&] {
+        bench::doNotOptimize(map.find(ids[cursor])->second);
+        cursor = (cursor + 1) % kEntries;
+    }));
+    cursor = 0;
+    bench::report("OrderIndex find", bench::measureNsPerOp(kEntries, [&] {
+        bench::doNotOptimize(index.find(keys[cursor]));
+        cursor = (cursor + 1) % kEntries;
+    }));
+
+    // Lookups of absent keys walk a full probe sequence
+    ClOrdId missing("MISSING");
+    std::string missingText("MISSING");
+    bench::report("unordered_map<string> find (miss)", bench::measureNsPerOp(kEntries, [&] {
+        bench::doNotOptimize(map.find(missingText) == map.end());
+    }));
+    bench::report("OrderIndex find (miss)", bench::measureNsPerOp(kEntries, [&] {
+        bench::doNotOptimize(index.find(missing));
+    }));
+
+    auto start = Clock::now();
+    for (const auto& id : ids) {
+        map.erase(id);
+    }
+    bench::report("unordered_map<string> erase", nsSince(start) / static_cast<double>(kEntries));
+
+    start = Clock::now();
+    for (const auto& key : keys) {
+        index.erase(key);
+    }
+    bench::report("OrderIndex erase", nsSince(start) / static_cast<double>(kEntries));
+
+    return 0;
+}
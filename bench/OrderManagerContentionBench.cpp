@@ -0,0 +1,65 @@
+// bench/OrderManagerContentionBench.cpp
+#include "BenchUtil.hpp"
+#include "OrderManager.hpp"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Each worker inserts then cancels its own orders, like processMessages
+    // workers handling independent clients
+    double runWorkers(std::size_t workers, std::size_t shards, std::size_t ordersPerWorker) {
+        OrderManager manager(workers * ordersPerWorker, shards);
+
+        std::vector<std::vector<std::string>> messages(workers);
+        std::vector<std::vector<std::string>> ids(workers);
+        for (std::size_t w = 0; w < workers; ++w) {
+            for (std::size_t i = 0; i < ordersPerWorker; ++i) {
+                std::string id = "W" + std::to_string(w) + "-" + std::to_string(i);
+                messages[w].push_back("35=D|49=SENDER|56=TARGET|11=" + id +
+                                      "|55=AAPL|54=1|44=150.50|38=100|40=2|");
+                ids[w].push_back(std::move(id));
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w] {
+                for (std::size_t i = 0; i < ordersPerWorker; ++i) {
+                    manager.processOrder(messages[w][i]);
+                    bench::doNotOptimize(manager.getOrder(ids[w][i]));
+                    manager.cancelOrder(ids[w][i]);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        return static_cast<double>(workers * ordersPerWorker) / elapsed;
+    }
+}
+
+int main() {
+    constexpr std::size_t kOrdersPerWorker = 200'000;
+    std::size_t maxWorkers = std::max(4u, std::thread::hardware_concurrency());
+
+    std::cout << "Orders/sec (insert + lookup + cancel), " << kOrdersPerWorker
+              << " orders per worker, " << std::thread::hardware_concurrency()
+              << " hardware threads" << std::endl;
+    std::cout << std::left << std::setw(10) << "workers"
+              << std::right << std::setw(16) << "1 shard"
+              << std::setw(16) << "16 shards" << std::endl;
+
+    for (std::size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+        double single = runWorkers(workers, 1, kOrdersPerWorker);
+        double sharded = runWorkers(workers, 16, kOrdersPerWorker);
+        std::cout << std::left << std::setw(10) << workers
+                  << std::right << std::setw(16) << std::fixed << std::setprecision(0) << single
+                  << std::setw(16) << sharded << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+// bench/ParseOnceBench.cpp
+#include "BenchUtil.hpp"
+#include "MessagePool.hpp"
+#include "MpmcQueue.hpp"
+#include "NetworkTypes.hpp"
+#include "OrderManager.hpp"
+#include <ctime>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kMessages = 400'000;
+    constexpr std::size_t kBatch = 32;
+
+    // Four new orders, then a cancel of the first of them
+    std::vector<std::string> buildMessages() {
+        std::vector<std::string> messages;
+        messages.reserve(kMessages);
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            if (i % 5 == 4) {
+                messages.push_back("35=F|49=SENDER|56=TARGET|11=CXL" + std::to_string(i) +
+                                   "|41=ORD" + std::to_string(i - 4) + "|55=AAPL|54=1|");
+            } else {
+                messages.push_back("35=D|49=SENDER|56=TARGET|11=ORD" + std::to_string(i) +
+                                   "|55=AAPL|54=1|44=150.50|38=100|40=2|");
+            }
+        }
+        return messages;
+    }
+
+    // The reader's share of the work: decode, answer from the decoded fields
+    JournalRecord decodeAndAck(const std::string& message, InstrumentRegistry& instruments) {
+        std::ostringstream response;
+        JournalRecord record;
+        if (fix::messageType(message) == fix::OrderCancelRequest::kMsgType) {
+            auto cancel = fix::decode<fix::OrderCancelRequest>(message, instruments);
+            record = JournalRecord::cancel(cancel);
+            response << "ACK|OrderID=" << cancel.clOrdId << "|OrigOrderID=" << cancel.origClOrdId
+                     << "|Status=CANCEL_ACCEPTED|";
+        } else {
+            auto order = fix::decode<fix::NewOrderSingle>(message, instruments);
+            record = JournalRecord::newOrder(order);
+            response << "ACK|OrderID=" << order.clOrdId << "|Symbol=" << order.symbol
+                     << "|Quantity=" << order.orderQty.value << "|Price=" << order.price.toString()
+                     << "|Status=ACCEPTED|";
+        }
+        bench::doNotOptimize(response.str().size());
+        return record;
+    }
+
+    double cpuSeconds() {
+        timespec now{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+    }
+
+    struct Result {
+        double messagesPerSecond;
+        double cpuNsPerMessage;
+    };
+
+    // One reader thread feeding `workers` threads through the bounded
+    // ingress queue, the way NetworkServer does. enqueue() runs on the reader
+    // after decoding; apply() on a worker for each message it takes.
+    template<typename Enqueue, typename Apply>
+    Result run(const std::vector<std::string>& messages, std::size_t workers,
+               InstrumentRegistry& instruments, MpmcQueue<network::Message>& queue,
+               Enqueue&& enqueue, Apply&& apply) {
+        std::atomic<std::size_t> applied{0};
+        double cpuStart = cpuSeconds();
+        auto start = Clock::now();
+
+        std::vector<std::thread> pool;
+        for (std::size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([&] {
+                std::vector<network::Message> batch;
+                batch.reserve(kBatch);
+                while (applied.load(std::memory_order_relaxed) < messages.size()) {
+                    batch.clear();
+                    queue.pop_n(std::back_inserter(batch), kBatch, std::chrono::milliseconds(1));
+                    for (const auto& message : batch) {
+                        apply(message);
+                    }
+                    applied.fetch_add(batch.size(), std::memory_order_relaxed);
+                }
+            });
+        }
+        for (const auto& message : messages) {
+            enqueue(message, decodeAndAck(message, instruments));
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return Result{static_cast<double>(messages.size()) / seconds,
+                      (cpuSeconds() - cpuStart) * 1e9 / static_cast<double>(messages.size())};
+    }
+
+    void print(const std::string& model, std::size_t workers, const Result& result) {
+        std::cout << std::left << std::setw(26) << model << std::right << std::setw(8) << workers
+                  << std::setw(14) << std::fixed << std::setprecision(0) << result.messagesPerSecond
+                  << std::setw(16) << result.cpuNsPerMessage << std::endl;
+    }
+}
+
+int main() {
+    auto messages = buildMessages();
+    std::cout << "Parse once: " << kMessages << " requests, one reader thread + N workers, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::left << std::setw(26) << "Model" << std::right << std::setw(8) << "N"
+              << std::setw(14) << "msgs/s" << std::setw(16) << "CPU ns/msg" << std::endl;
+
+    for (std::size_t workers = 1; workers <= 4; workers *= 2) {
+        // Before: the reader decodes for the ACK and queues the raw text,
+        // which the worker parses again
+        {
+            auto orders = std::make_shared<OrderManager>(kMessages);
+            MpmcQueue<network::Message> queue(65536);
+            print("queue text, parse twice", workers,
+                  run(messages, workers, orders->instruments(), queue,
+                      [&](const std::string& message, const JournalRecord&) {
+                          queue.push(network::Message(network::Message::Type::FIX, message));
+                      },
+                      [&](const network::Message& message) {
+                          // With several workers a cancel can overtake its order, as in the server
+                          try {
+                              orders->processOrder(message.payload);
+                          } catch (const std::exception&) {
+                          }
+                      }));
+        }
+        // After: the decoded record is queued by handle and applied as is
+        {
+            auto orders = std::make_shared<OrderManager>(kMessages);
+            MpmcQueue<network::Message> queue(65536);
+            MessagePool<JournalRecord> decoded(65536);
+            print("queue decoded, parse once", workers,
+                  run(messages, workers, orders->instruments(), queue,
+                      [&](const std::string&, const JournalRecord& record) {
+                          auto handle = decoded.acquire();
+                          decoded[handle] = record;
+                          queue.push(network::Message(network::Message::Type::FIX, handle));
+                      },
+                      [&](const network::Message& message) {
+                          orders->apply(decoded[message.decoded]);
+                          decoded.release(message.decoded);
+                      }));
+        }
+    }
+    return 0;
+}
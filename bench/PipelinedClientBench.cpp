@@ -0,0 +1,91 @@
+// bench/PipelinedClientBench.cpp
+#include "BenchUtil.hpp"
+#include "NetworkClient.hpp"
+#include "NetworkServer.hpp"
+#include <atomic>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kMessages = 50'000;
+
+    // Swallows the client's and server's log lines while they run
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    std::string newOrder(std::size_t window, std::size_t i) {
+        return "35=D|49=SENDER|56=TARGET|11=W" + std::to_string(window) + "-" + std::to_string(i) +
+               "|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    }
+
+    // ACKed orders per second over one connection; window 0 is send()
+    // waiting for each ACK, as before
+    double run(uint16_t port, std::size_t window, std::size_t messages, std::size_t& acked) {
+        auto logger = std::make_shared<Logger>();
+        network::ClientConfig config;
+        config.port = port;
+        config.pipeline_window = window;
+        NetworkClient client(config, logger);
+        if (!client.connect()) {
+            throw std::runtime_error("Could not connect: " + client.getLastError());
+        }
+
+        std::atomic<std::size_t> accepted{0};
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < messages; ++i) {
+            network::Message message(network::Message::Type::FIX, newOrder(window, i));
+            if (window == 0) {
+                accepted += client.send(message) ? 1 : 0;
+            } else {
+                client.sendPipelined(message, [&accepted](bool ok, const std::string&) {
+                    accepted.fetch_add(ok ? 1 : 0, std::memory_order_relaxed);
+                });
+            }
+        }
+        client.flush();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        acked = accepted.load();
+        return static_cast<double>(messages) / seconds;
+    }
+}
+
+int main() {
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer discard;
+    std::cout.rdbuf(&discard);
+
+    network::ServerConfig serverConfig;
+    serverConfig.port = 0;
+    serverConfig.thread_pool_size = 2;
+    serverConfig.bounded_ingress_queue = true;
+    serverConfig.expected_orders = kMessages * 6;
+    NetworkServer server(serverConfig,
+                         std::make_shared<OrderManager>(serverConfig.expected_orders, serverConfig.order_manager_shards),
+                         std::make_shared<Logger>());
+    std::thread serverThread([&] { server.start(); });
+
+    out << "Client pipelining: " << kMessages << " new orders over one loopback connection, "
+        << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    out << std::left << std::setw(12) << "Window" << std::right << std::setw(14) << "orders/s"
+        << std::setw(10) << "ACKed" << std::endl;
+    for (std::size_t window : {0, 1, 16, 256, 4096}) {
+        // One at a time is slow enough that a fifth of the orders shows the rate
+        std::size_t messages = window <= 1 ? kMessages / 5 : kMessages;
+        std::size_t acked = 0;
+        double rate = run(server.port(), window, messages, acked);
+        out << std::left << std::setw(12) << (window == 0 ? "send()" : std::to_string(window))
+            << std::right << std::setw(14) << std::fixed << std::setprecision(0) << rate
+            << std::setw(10) << acked << std::endl;
+    }
+
+    server.stop();
+    serverThread.join();
+    std::cout.rdbuf(out.rdbuf());
+    return 0;
+}
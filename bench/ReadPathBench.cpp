@@ -0,0 +1,82 @@
+// bench/ReadPathBench.cpp
+#include "BenchUtil.hpp"
+#include "NetworkServer.hpp"
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using boost::asio::ip::tcp;
+
+    constexpr std::size_t kBursts = 50;
+
+    // Swallows the server's per-message log lines while it runs
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+}
+
+int main() {
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer discard;
+    std::cout.rdbuf(&discard);
+
+    out << "Server socket path: " << kBursts << " bursts per size, each sent in one write, "
+        << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    out << std::left << std::setw(10) << "Burst" << std::right << std::setw(14) << "orders/s"
+        << std::setw(10) << "reads" << std::setw(14) << "orders/read"
+        << std::setw(10) << "writes" << std::setw(14) << "orders/write" << std::endl;
+
+    for (std::size_t burst : {1, 10, 100, 1000}) {
+        network::ServerConfig config;
+        config.port = 0;
+        config.thread_pool_size = 2;
+        config.bounded_ingress_queue = true;
+        config.expected_orders = burst * kBursts;
+        NetworkServer server(config,
+                             std::make_shared<OrderManager>(config.expected_orders, config.order_manager_shards),
+                             std::make_shared<Logger>());
+        std::thread serverThread([&] { server.start(); });
+
+        boost::asio::io_context context;
+        tcp::socket socket(context);
+        socket.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), server.port()));
+        socket.set_option(tcp::no_delay(true));
+
+        // Built up front so the client does as little as possible while timed
+        std::vector<std::string> bursts(kBursts);
+        for (std::size_t b = 0; b < kBursts; ++b) {
+            for (std::size_t i = 0; i < burst; ++i) {
+                bursts[b] += "35=D|49=SENDER|56=TARGET|11=B" + std::to_string(b) + "-" + std::to_string(i) +
+                             "|55=AAPL|54=1|44=150.50|38=100|40=2|\n";
+            }
+        }
+
+        boost::asio::streambuf acks;
+        auto start = Clock::now();
+        for (const auto& requests : bursts) {
+            boost::asio::write(socket, boost::asio::buffer(requests));
+            for (std::size_t i = 0; i < burst; ++i) {
+                acks.consume(boost::asio::read_until(socket, acks, '\n'));
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        auto stats = server.getStatistics();
+
+        socket.close();
+        server.stop();
+        serverThread.join();
+        out << std::left << std::setw(10) << burst << std::right << std::setw(14) << std::fixed
+            << std::setprecision(0) << static_cast<double>(burst * kBursts) / seconds
+            << std::setw(10) << stats.socket_reads << std::setw(14) << std::setprecision(1)
+            << static_cast<double>(burst * kBursts) / static_cast<double>(stats.socket_reads)
+            << std::setw(10) << stats.socket_writes << std::setw(14)
+            << static_cast<double>(burst * kBursts) / static_cast<double>(stats.socket_writes) << std::endl;
+    }
+
+    std::cout.rdbuf(out.rdbuf());
+    return 0;
+}
@@ -0,0 +1,94 @@
+// bench/RestartBench.cpp
+#include "BenchUtil.hpp"
+#include "OrderSnapshot.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void line(const std::string& name, double ms, std::size_t orders, uint64_t events) {
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(12) << orders << std::setw(14) << events << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    // A day's worth of events leaving most orders resting, then a short tail
+    // since the last snapshot
+    const std::size_t kEvents = 2'000'000;
+    const std::size_t kTail = 20'000;
+    std::string directory = std::string(argc > 1 ? argv[1] : ".") + "/restart_bench";
+    std::filesystem::remove_all(directory);
+
+    JournalConfig journalConfig;
+    journalConfig.path = directory + "/journal.bin";
+    journalConfig.capacity = kEvents;
+    journalConfig.fsync = false;
+    std::filesystem::create_directories(directory);
+    OrderJournal journal(journalConfig);
+
+    const char* symbols[] = {"AAPL", "MSFT", "IBM", "GOOG", "AMZN", "TSLA", "NVDA", "META"};
+    OrderManager live(kEvents, OrderManager::kDefaultShards);
+    char id[24];
+    char cancelId[24];
+    SnapshotInfo snapshot;
+    double snapshotMs = 0;
+    for (std::size_t i = 0; i < kEvents; ++i) {
+        JournalRecord record;
+        // One event in five cancels the order placed four events earlier
+        if (i % 5 == 4) {
+            std::snprintf(id, sizeof(id), "ORD%zu", i - 4);
+            std::snprintf(cancelId, sizeof(cancelId), "CXL%zu", i);
+            fix::OrderCancelRequest cancel;
+            cancel.clOrdId = cancelId;
+            cancel.origClOrdId = id;
+            record = JournalRecord::cancel(cancel);
+        } else {
+            std::snprintf(id, sizeof(id), "ORD%zu", i);
+            fix::NewOrderSingle order;
+            order.clOrdId = id;
+            order.symbol = symbols[i % 8];
+            order.side = (i & 1) ? fix::side::Sell : fix::side::Buy;
+            order.ordType = fix::ord_type::Limit;
+            order.price = Price(10000 + static_cast<int64_t>(i % 500), 2);
+            order.orderQty = Qty(100);
+            record = JournalRecord::newOrder(order);
+        }
+        live.apply(journal.record(journal.append(record)));
+
+        if (i + 1 == kEvents - kTail) {
+            auto start = Clock::now();
+            snapshot = writeOrderSnapshot(directory + "/snapshots", live, journal.lastSequence(), &journal);
+            snapshotMs = millisSince(start);
+        }
+    }
+    journal.flush();
+
+    std::cout << "Restart with " << kEvents << " journal events, " << live.size() << " live orders" << std::endl;
+    std::cout << std::left << std::setw(36) << "step" << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "orders" << std::setw(14) << "events" << std::endl;
+    line("write snapshot", snapshotMs, snapshot.orders, 0);
+
+    {
+        OrderManager recovered(kEvents, OrderManager::kDefaultShards);
+        auto start = Clock::now();
+        RecoveryResult result = recoverOrders("", journal, recovered);
+        line("full journal replay", millisSince(start), recovered.size(), result.replayedEvents);
+    }
+    {
+        OrderManager recovered(kEvents, OrderManager::kDefaultShards);
+        auto start = Clock::now();
+        RecoveryResult result = recoverOrders(directory + "/snapshots", journal, recovered);
+        line("snapshot + journal tail", millisSince(start), recovered.size(), result.replayedEvents);
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// bench/RiskCheckBench.cpp
+#include "BenchUtil.hpp"
+#include "RiskChecker.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kIterations = 2'000'000;
+
+    void reportAgainstBudget(const std::string& name, double nsPerOp, double budgetNs) {
+        std::cout << std::left << std::setw(44) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(1) << nsPerOp
+                  << " ns/op  (budget " << std::setprecision(0) << budgetNs << " ns"
+                  << (nsPerOp <= budgetNs ? ", ok)" : ", OVER)") << std::endl;
+    }
+}
+
+int main() {
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    InstrumentId aapl = instruments->intern("AAPL");
+
+    RiskLimits limits;
+    limits.maxOrdersPerSecond = UINT32_MAX;
+    RiskChecker risk(instruments, limits);
+    risk.onTrade(aapl, Price::parse("150.00"));
+
+    std::vector<std::string> accounts;
+    for (int i = 0; i < 64; ++i) {
+        accounts.push_back("ACCOUNT" + std::to_string(i));
+        risk.account(accounts.back());
+    }
+    AccountId account = risk.account(accounts[0]);
+
+    fix::NewOrderSingle order;
+    order.account = accounts[0];
+    order.symbol = "AAPL";
+    order.instrument = aapl;
+    order.side = fix::side::Buy;
+    order.ordType = fix::ord_type::Limit;
+    order.price = Price::parse("150.25");
+    order.orderQty = Qty(100);
+
+    int64_t now = 0;
+    std::size_t next = 0;
+
+    std::cout << "Pre-trade risk checks, single thread" << std::endl;
+    reportAgainstBudget("account lookup (64 accounts)", bench::measureNsPerOp(kIterations, [&] {
+        bench::doNotOptimize(risk.account(accounts[next++ & 63]));
+    }), risk_budget::kAccountLookupNs);
+    reportAgainstBudget("order qty + notional", bench::measureNsPerOp(kIterations, [&] {
+        bench::doNotOptimize(risk.checkOrderLimits(order.price, order.orderQty));
+    }), risk_budget::kOrderLimitsNs);
+    reportAgainstBudget("price band vs last trade", bench::measureNsPerOp(kIterations, [&] {
+        bench::doNotOptimize(risk.checkPriceBand(aapl, order.price));
+    }), risk_budget::kPriceBandNs);
+    reportAgainstBudget("order rate", bench::measureNsPerOp(kIterations, [&] {
+        bench::doNotOptimize(risk.checkOrderRate(account, ++now));
+    }), risk_budget::kOrderRateNs);
+
+    int64_t amount = RiskChecker::notional(order.price, order.orderQty);
+    reportAgainstBudget("open exposure reserve + release", bench::measureNsPerOp(kIterations, [&] {
+        bench::doNotOptimize(risk.reserveExposure(account, amount));
+        risk.adjustExposure(account, -amount);
+    }), risk_budget::kOpenExposureNs);
+
+    reportAgainstBudget("checkNewOrder, all checks + release", bench::measureNsPerOp(kIterations, [&] {
+        AccountId id = risk.account(order.account);
+        bench::doNotOptimize(risk.checkNewOrder(order, id, ++now));
+        risk.release(id, order.price, order.orderQty);
+    }), risk_budget::kTotalNs);
+
+    return 0;
+}
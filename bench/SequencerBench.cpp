@@ -0,0 +1,200 @@
+// bench/SequencerBench.cpp
+#include "BenchUtil.hpp"
+#include "MessageQueue.hpp"
+#include "OrderPipeline.hpp"
+#include "OrderSequencer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kMessages = 400'000;
+    // The network thread sends a burst, then waits for it to be applied, so
+    // latency reflects the hand-off rather than an ever-growing backlog
+    constexpr std::size_t kBurst = 32;
+
+    // Four new orders, then a cancel of the first of them
+    std::vector<std::string> buildMessages() {
+        std::vector<std::string> messages;
+        messages.reserve(kMessages);
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            if (i % 5 == 4) {
+                messages.push_back("35=F|49=SENDER|56=TARGET|11=CXL" + std::to_string(i) +
+                                   "|41=ORD" + std::to_string(i - 4) + "|55=AAPL|54=1|");
+            } else {
+                messages.push_back("35=D|49=SENDER|56=TARGET|11=ORD" + std::to_string(i) +
+                                   "|55=AAPL|54=1|44=150.50|38=100|40=2|");
+            }
+        }
+        return messages;
+    }
+
+    // What the network thread does before handing off: decode for the ACK
+    JournalRecord decodeRecord(const std::string& message, InstrumentRegistry& instruments) {
+        if (fix::messageType(message) == fix::OrderCancelRequest::kMsgType) {
+            return JournalRecord::cancel(fix::decode<fix::OrderCancelRequest>(message));
+        }
+        return JournalRecord::newOrder(fix::decode<fix::NewOrderSingle>(message, instruments));
+    }
+
+    struct Result {
+        double messagesPerSecond;
+        double p50Ns;
+        double p99Ns;
+        std::size_t rejected;
+    };
+
+    Result summarise(double seconds, std::vector<double> latencies, std::size_t rejected) {
+        std::sort(latencies.begin(), latencies.end());
+        return Result{static_cast<double>(kMessages) / seconds,
+                      latencies[latencies.size() / 2],
+                      latencies[latencies.size() * 99 / 100], rejected};
+    }
+
+    void print(const std::string& model, const Result& result) {
+        std::cout << std::left << std::setw(28) << model
+                  << std::right << std::setw(14) << std::fixed << std::setprecision(0) << result.messagesPerSecond
+                  << std::setw(12) << result.p50Ns << std::setw(12) << result.p99Ns
+                  << std::setw(10) << result.rejected << std::endl;
+    }
+
+    template<typename Wait>
+    void sendBursts(const std::vector<std::string>& messages, std::vector<Clock::time_point>& sent,
+                    Wait&& waitFor, const std::function<void(std::size_t)>& send) {
+        for (std::size_t first = 0; first < messages.size(); first += kBurst) {
+            std::size_t end = std::min(first + kBurst, messages.size());
+            for (std::size_t i = first; i < end; ++i) {
+                sent[i] = Clock::now();
+                send(i);
+            }
+            waitFor(end);
+        }
+    }
+
+    // Today's model: the network thread decodes for the ACK and queues the
+    // raw text; workers re-parse it into a locked, sharded OrderManager
+    Result runWorkers(const std::vector<std::string>& messages, std::size_t workers) {
+        struct Queued {
+            std::size_t index;
+            std::string payload;
+        };
+        OrderManager orders(kMessages, OrderManager::kDefaultShards);
+        MessageQueue<Queued> queue;
+        std::vector<Clock::time_point> sent(kMessages);
+        std::vector<double> latencies(kMessages);
+        std::atomic<std::size_t> done{0};
+        std::atomic<std::size_t> rejected{0};
+        std::atomic<bool> running{true};
+
+        std::vector<std::thread> threads;
+        for (std::size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&] {
+                while (running.load(std::memory_order_relaxed)) {
+                    if (auto message = queue.pop()) {
+                        try {
+                            orders.processOrder(message->payload);
+                        } catch (const std::exception&) {
+                            rejected.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        latencies[message->index] =
+                            std::chrono::duration<double, std::nano>(Clock::now() - sent[message->index]).count();
+                        done.fetch_add(1, std::memory_order_release);
+                    }
+                }
+            });
+        }
+
+        auto start = Clock::now();
+        sendBursts(messages, sent,
+                   [&](std::size_t count) {
+                       while (done.load(std::memory_order_acquire) < count) {
+                           std::this_thread::yield();
+                       }
+                   },
+                   [&](std::size_t i) {
+                       bench::doNotOptimize(decodeRecord(messages[i], orders.instruments()));
+                       queue.push(Queued{i, messages[i]});
+                   });
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        running = false;
+        queue.stop();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return summarise(seconds, std::move(latencies), rejected.load());
+    }
+
+    // Sequencer model: the decoded record goes through the ring to the one
+    // thread that owns order state
+    Result runSequencer(const std::vector<std::string>& messages) {
+        auto orders = std::make_shared<OrderManager>(kMessages, OrderManager::kDefaultShards, nullptr,
+                                                     OrderManager::Concurrency::SINGLE_WRITER);
+        std::vector<Clock::time_point> sent(kMessages);
+        std::vector<double> latencies(kMessages);
+
+        SequencerConfig config;
+        config.capacity = 1024;
+        config.onProcessed = [&](uint64_t ticket, bool) {
+            latencies[ticket - 1] = std::chrono::duration<double, std::nano>(Clock::now() - sent[ticket - 1]).count();
+        };
+        OrderSequencer sequencer(config, orders);
+        // Decoding interns symbols; only the sequencer may touch the manager now
+        InstrumentRegistry instruments;
+
+        auto start = Clock::now();
+        sendBursts(messages, sent,
+                   [&](std::size_t count) { sequencer.waitProcessed(count); },
+                   [&](std::size_t i) { sequencer.publish(decodeRecord(messages[i], instruments)); });
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return summarise(seconds, std::move(latencies), sequencer.rejected());
+    }
+
+    // Staged pipeline: the raw text goes into the ring and every stage,
+    // decode included, runs on its own thread
+    Result runPipeline(const std::vector<std::string>& messages, PipelineStats& stats) {
+        auto orders = std::make_shared<OrderManager>(kMessages, OrderManager::kDefaultShards, nullptr,
+                                                     OrderManager::Concurrency::SINGLE_WRITER);
+        std::vector<Clock::time_point> sent(kMessages);
+        std::vector<double> latencies(kMessages);
+
+        PipelineConfig config;
+        config.capacity = 1024;
+        std::size_t emitted = 0;
+        config.onResponse = [&](const PipelineEvent&) {
+            latencies[emitted] = std::chrono::duration<double, std::nano>(Clock::now() - sent[emitted]).count();
+            ++emitted;
+        };
+        OrderPipeline pipeline(config, orders);
+
+        auto start = Clock::now();
+        sendBursts(messages, sent,
+                   [&](std::size_t count) { pipeline.waitCompleted(count); },
+                   [&](std::size_t i) { pipeline.publish(messages[i]); });
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        stats = pipeline.stats();
+        return summarise(seconds, std::move(latencies), stats.rejected);
+    }
+}
+
+int main() {
+    std::vector<std::string> messages = buildMessages();
+
+    std::cout << "Order path: " << kMessages << " messages (4 new : 1 cancel) in bursts of " << kBurst
+              << ", " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::left << std::setw(28) << "model" << std::right << std::setw(14) << "msgs/sec"
+              << std::setw(12) << "p50 ns" << std::setw(12) << "p99 ns" << std::setw(10) << "rejected" << std::endl;
+    print("worker pool, 1 worker", runWorkers(messages, 1));
+    print("worker pool, 4 workers", runWorkers(messages, 4));
+    print("single-writer sequencer", runSequencer(messages));
+    PipelineStats stats;
+    print("staged pipeline", runPipeline(messages, stats));
+    for (const auto& stage : stats.stages) {
+        std::cout << "  " << std::left << std::setw(14) << pipelineStageName(stage.stage) << std::right
+                  << std::setprecision(0) << std::setw(8) << stage.averageNs << " ns/event busy" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// bench/SpscQueueBench.cpp
+#include "BenchUtil.hpp"
+#include "MessageQueue.hpp"
+#include "SpscQueue.hpp"
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kItems = 2'000'000;
+
+    // One producer thread, one consumer thread; ns per item handed over
+    template<typename Push, typename Pop>
+    double handOff(Push&& push, Pop&& pop) {
+        auto start = std::chrono::steady_clock::now();
+        std::thread producer([&] {
+            for (std::size_t i = 0; i < kItems; ++i) {
+                push(i);
+            }
+        });
+        for (std::size_t received = 0; received < kItems;) {
+            received += pop();
+        }
+        producer.join();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / kItems;
+    }
+}
+
+int main() {
+    std::cout << "Queue hand-off, " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+
+    {
+        SpscQueue<std::size_t> queue(1024);
+        bench::report("SpscQueue try_push + try_pop (same thread)", bench::measureNsPerOp(kItems, [&] {
+            queue.try_push(1);
+            bench::doNotOptimize(queue.try_pop());
+        }));
+    }
+    {
+        MessageQueue<std::size_t> queue;
+        bench::report("MessageQueue push + pop (same thread)", bench::measureNsPerOp(kItems, [&] {
+            queue.push(1);
+            bench::doNotOptimize(queue.pop());
+        }));
+    }
+
+    {
+        MessageQueue<std::size_t> queue;
+        bench::report("MessageQueue across threads", handOff(
+            [&](std::size_t i) { queue.push(i); },
+            [&] { return queue.pop() ? std::size_t{1} : std::size_t{0}; }));
+    }
+    {
+        SpscQueue<std::size_t> queue(1024);
+        bench::report("SpscQueue push/pop across threads", handOff(
+            [&](std::size_t i) { queue.push(i); },
+            [&] { return queue.pop() ? std::size_t{1} : std::size_t{0}; }));
+    }
+    {
+        SpscQueue<std::size_t> queue(1024);
+        std::vector<std::size_t> batch;
+        batch.reserve(64);
+        bench::report("SpscQueue pop_n(64) across threads", handOff(
+            [&](std::size_t i) { queue.push(i); },
+            [&] {
+                batch.clear();
+                std::size_t count = queue.pop_n(std::back_inserter(batch), 64);
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+                return count;
+            }));
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+// bench/WaitStrategyBench.cpp
+#include "BenchUtil.hpp"
+#include "SpscQueue.hpp"
+#include "WaitStrategy.hpp"
+#include <algorithm>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t kMessages = 2000;
+    // Gap between messages, so the consumer goes idle before each one
+    constexpr auto kGap = std::chrono::microseconds(200);
+
+    double threadCpuSeconds() {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) / 1e9;
+    }
+
+    struct Result {
+        double p50Ns;
+        double p99Ns;
+        double cpuPercent;  // Consumer CPU time over wall time
+    };
+
+    // The producer sleeps between messages; the consumer records how long
+    // after the push it got each one, and how much CPU it used meanwhile
+    Result run(WaitStrategy strategy) {
+        SpscQueue<Clock::time_point> queue(64, strategy);
+        std::vector<double> latencies;
+        latencies.reserve(kMessages);
+        double cpuSeconds = 0;
+
+        auto start = Clock::now();
+        std::thread consumer([&] {
+            double cpuStart = threadCpuSeconds();
+            while (latencies.size() < kMessages) {
+                if (auto sent = queue.pop(std::chrono::milliseconds(100))) {
+                    latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - *sent).count());
+                }
+            }
+            cpuSeconds = threadCpuSeconds() - cpuStart;
+        });
+        for (std::size_t i = 0; i < kMessages; ++i) {
+            std::this_thread::sleep_for(kGap);
+            queue.push(Clock::now());
+        }
+        consumer.join();
+        double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::sort(latencies.begin(), latencies.end());
+        return Result{latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+                      100.0 * cpuSeconds / wallSeconds};
+    }
+}
+
+int main() {
+    std::cout << "Consumer wake-up: " << kMessages << " messages " << kGap.count() << "us apart, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::left << std::setw(14) << "strategy" << std::right << std::setw(12) << "p50 ns"
+              << std::setw(12) << "p99 ns" << std::setw(12) << "cpu %" << std::endl;
+    for (WaitStrategy strategy : {WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD,
+                                  WaitStrategy::SPIN_PARK, WaitStrategy::BLOCKING}) {
+        Result result = run(strategy);
+        std::cout << std::left << std::setw(14) << waitStrategyName(strategy) << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(12) << result.p50Ns << std::setw(12) << result.p99Ns
+                  << std::setprecision(1) << std::setw(12) << result.cpuPercent << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+// bench/WireEncodingBench.cpp
+#include "BenchUtil.hpp"
+#include "BinaryProtocol.hpp"
+#include "NetworkClient.hpp"
+#include "NetworkServer.hpp"
+#include <atomic>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using boost::asio::ip::tcp;
+
+    constexpr std::size_t kCodecIterations = 1'000'000;
+    constexpr std::size_t kBursts = 50;
+    constexpr std::size_t kBurst = 1000;
+    constexpr std::size_t kClientOrders = 50'000;
+    constexpr std::size_t kClientWindow = 256;
+
+    // Swallows the client's log lines while it runs
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    std::string newOrder(const std::string& clOrdId) {
+        return "35=D|49=SENDER|56=TARGET|11=" + clOrdId + "|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    }
+
+    const char* name(network::Encoding encoding) {
+        return encoding == network::Encoding::BINARY ? "binary" : "text";
+    }
+
+    // Decoding a NewOrderSingle and encoding its answer, as the io thread does
+    void runCodec(std::ostream& out) {
+        InstrumentRegistry instruments;
+        const std::string text = newOrder("ORDER123");
+        std::string wire;
+        binary::appendFromFix(text, wire);
+
+        std::string response;
+        response.reserve(256);
+        double textNs = bench::measureNsPerOp(kCodecIterations, [&] {
+            auto order = fix::decode<fix::NewOrderSingle>(text, instruments);
+            char digits[32];
+            response.clear();
+            response.append("ACK|OrderID=").append(order.clOrdId)
+                    .append("|Symbol=").append(order.symbol)
+                    .append("|Side=").append(order.side == fix::side::Buy ? "BUY" : "SELL")
+                    .append("|Quantity=").append(digits, order.orderQty.format(digits))
+                    .append("|Price=").append(digits, order.price.format(digits))
+                    .append("|Status=ACCEPTED|");
+            bench::doNotOptimize(response.data());
+        });
+        std::size_t textResponseSize = response.size() + 1;
+
+        binary::ExecutionReport report{};
+        double binaryNs = bench::measureNsPerOp(kCodecIterations, [&] {
+            const auto& in = binary::overlay<binary::NewOrder>(wire);
+            auto order = binary::decode(in, instruments);
+            binary::initHeader(report);
+            std::memcpy(report.clOrdId, in.clOrdId, sizeof report.clOrdId);
+            std::memcpy(report.symbol, in.symbol, sizeof report.symbol);
+            report.side = order.side;
+            report.price = in.price;
+            report.priceScale = in.priceScale;
+            report.orderQty = order.orderQty.value;
+            report.execType = report.ordStatus = fix::status::New;
+            bench::doNotOptimize(report);
+        });
+
+        out << "Codec: decode a NewOrderSingle and encode its ACK, one thread" << std::endl;
+        out << std::left << std::setw(10) << "Encoding" << std::right << std::setw(12) << "ns/order"
+            << std::setw(16) << "request bytes" << std::setw(16) << "response bytes" << std::endl;
+        out << std::left << std::setw(10) << "text" << std::right << std::setw(12) << std::fixed
+            << std::setprecision(1) << textNs << std::setw(16) << text.size() + 1
+            << std::setw(16) << textResponseSize << std::endl;
+        out << std::left << std::setw(10) << "binary" << std::right << std::setw(12) << binaryNs
+            << std::setw(16) << wire.size() << std::setw(16) << sizeof(binary::ExecutionReport) << std::endl;
+    }
+
+    // Pre-encoded bursts straight onto the socket, so the client costs the same for both
+    double runBursts(uint16_t port, network::Encoding encoding) {
+        boost::asio::io_context context;
+        tcp::socket socket(context);
+        socket.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+        socket.set_option(tcp::no_delay(true));
+        if (encoding == network::Encoding::BINARY) {
+            const std::string logon = "35=A|5000=BINARY|\n";
+            boost::asio::write(socket, boost::asio::buffer(logon));
+            std::string ack(std::string_view("ACK|Status=LOGGED_ON|Encoding=BINARY|\n").size(), '\0');
+            boost::asio::read(socket, boost::asio::buffer(ack));
+        }
+
+        std::vector<std::string> bursts(kBursts);
+        for (std::size_t b = 0; b < kBursts; ++b) {
+            for (std::size_t i = 0; i < kBurst; ++i) {
+                std::string order = newOrder(std::string(1, name(encoding)[0]) + std::to_string(b) + "-" +
+                                             std::to_string(i));
+                if (encoding == network::Encoding::BINARY) {
+                    binary::appendFromFix(order, bursts[b]);
+                } else {
+                    bursts[b] += order + "\n";
+                }
+            }
+        }
+
+        std::vector<char> responses(sizeof(binary::ExecutionReport) * kBurst);
+        boost::asio::streambuf acks;
+        auto start = Clock::now();
+        for (const auto& requests : bursts) {
+            boost::asio::write(socket, boost::asio::buffer(requests));
+            if (encoding == network::Encoding::BINARY) {
+                boost::asio::read(socket, boost::asio::buffer(responses));
+            } else {
+                for (std::size_t i = 0; i < kBurst; ++i) {
+                    acks.consume(boost::asio::read_until(socket, acks, '\n'));
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return static_cast<double>(kBursts * kBurst) / seconds;
+    }
+
+    // NetworkClient pipelining FIX text requests, sent in either encoding
+    double runClient(uint16_t port, network::Encoding encoding, std::size_t& acked) {
+        network::ClientConfig config;
+        config.port = port;
+        config.pipeline_window = kClientWindow;
+        config.encoding = encoding;
+        NetworkClient client(config, std::make_shared<Logger>());
+        if (!client.connect()) {
+            throw std::runtime_error("Could not connect: " + client.getLastError());
+        }
+
+        std::atomic<std::size_t> accepted{0};
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < kClientOrders; ++i) {
+            network::Message message(network::Message::Type::FIX,
+                                     newOrder(std::string("C") + name(encoding)[0] + std::to_string(i)));
+            client.sendPipelined(message, [&accepted](bool ok, const std::string&) {
+                accepted.fetch_add(ok ? 1 : 0, std::memory_order_relaxed);
+            });
+        }
+        client.flush();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        acked = accepted.load();
+        return static_cast<double>(kClientOrders) / seconds;
+    }
+}
+
+int main() {
+    std::ostream out(std::cout.rdbuf());
+    NullBuffer discard;
+    std::cout.rdbuf(&discard);
+
+    runCodec(out);
+
+    // Per-message logging would cost both encodings the same and hide the difference
+    auto serverLogger = std::make_shared<Logger>();
+    serverLogger->setLevel(Logger::Level::WARNING);
+    out << std::endl << "Server: " << kBursts << " bursts of " << kBurst << " new orders, and "
+        << kClientOrders << " through NetworkClient with a window of " << kClientWindow << ", "
+        << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    out << std::left << std::setw(10) << "Encoding" << std::right << std::setw(18) << "bursts orders/s"
+        << std::setw(18) << "client orders/s" << std::setw(10) << "ACKed" << std::endl;
+    for (network::Encoding encoding : {network::Encoding::TEXT, network::Encoding::BINARY}) {
+        network::ServerConfig config;
+        config.port = 0;
+        config.thread_pool_size = 2;
+        config.bounded_ingress_queue = true;
+        config.expected_orders = kBursts * kBurst + kClientOrders;
+        NetworkServer server(config,
+                             std::make_shared<OrderManager>(config.expected_orders, config.order_manager_shards),
+                             serverLogger);
+        std::thread serverThread([&] { server.start(); });
+
+        double burstRate = runBursts(server.port(), encoding);
+        std::size_t acked = 0;
+        double clientRate = runClient(server.port(), encoding, acked);
+
+        server.stop();
+        serverThread.join();
+        out << std::left << std::setw(10) << name(encoding) << std::right << std::setw(18) << std::fixed
+            << std::setprecision(0) << burstRate << std::setw(18) << clientRate << std::setw(10) << acked
+            << std::endl;
+    }
+
+    std::cout.rdbuf(out.rdbuf());
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <sstream>
 #include "NetworkClient.hpp"
+#include "FixedPoint.hpp"
 #include "NetworkTypes.hpp"
 #include "Logger.hpp"
 
@@ -12,6 +13,9 @@ void printUsage() {
               << "  1. Single order:    fix_client -o \"35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|\"\n"
               << "  2. File input:      fix_client -f orders.txt\n"
               << "  3. Interactive:     fix_client -i\n"
+              << "\nOptions (before the mode):\n"
+              << "  -w <window>  : Pipeline up to <window> orders ahead of their responses\n"
+              << "  -b           : Log on for the binary encoding; orders are still typed as FIX\n"
               << "\nFIX Message Format:\n"
               << "  35=D         : New Order Single\n"
               << "  49=SENDER    : SenderCompID\n"
@@ -66,7 +70,7 @@ std::string generateOrderId() {
 }
 
 std::string buildFixMessage(const std::string& symbol, const std::string& side, 
-                          double price, int quantity) {
+                          const Price& price, Qty quantity) {
     std::stringstream ss;
     ss << "35=D|"
        << "49=SENDER|"
@@ -74,8 +78,8 @@ std::string buildFixMessage(const std::string& symbol, const std::string& side,
        << "11=" << generateOrderId() << "|"
        << "55=" << symbol << "|"
        << "54=" << side << "|"
-       << "44=" << std::fixed << std::setprecision(2) << price << "|"
-       << "38=" << quantity << "|"
+       << "44=" << price.toString() << "|"
+       << "38=" << quantity.toString() << "|"
        << "40=2|";
     return ss.str();
 }
@@ -104,11 +108,13 @@ void interactiveMode(NetworkClient& client) {
         if (input.find('|') == std::string::npos) {
             // Parse simplified format
             std::istringstream iss(input);
-            std::string symbol, side;
-            double price;
-            int quantity;
+            std::string symbol, side, priceText, quantityText;
+            Price price;
+            Qty quantity;
 
-            if (iss >> symbol >> side >> price >> quantity) {
+            // Prices are sent with two decimals, as before
+            if (iss >> symbol >> side >> priceText >> quantityText &&
+                Price::tryParse(priceText, price, 2) && Qty::tryParse(quantityText, quantity)) {
                 // Convert side to FIX format (BUY=1, SELL=2)
                 std::string fixSide = (side == "BUY" || side == "buy") ? "1" : "2";
                 messageToSend = buildFixMessage(symbol, fixSide, price, quantity);
@@ -140,6 +146,20 @@ int main(int argc, char* argv[]) {
         config.timeout = std::chrono::milliseconds(5000);
         config.retry_attempts = 3;
 
+        int arg = 1;
+        while (argc > arg + 1) {
+            std::string option = argv[arg];
+            if (option == "-w") {
+                config.pipeline_window = std::stoul(argv[arg + 1]);
+                arg += 2;
+            } else if (option == "-b") {
+                config.encoding = network::Encoding::BINARY;
+                ++arg;
+            } else {
+                break;
+            }
+        }
+
         NetworkClient client(config, logger);
 
         if (!client.connect()) {
@@ -147,26 +167,26 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        if (argc < 2) {
+        if (argc < arg + 1) {
             printUsage();
             return 1;
         }
 
-        std::string option = argv[1];
+        std::string option = argv[arg];
         
         if (option == "-i") {
             interactiveMode(client);
         }
-        else if (option == "-f" && argc > 2) {
-            if (client.sendFile(argv[2], network::Message::Type::FIX)) {
+        else if (option == "-f" && argc > arg + 1) {
+            if (client.sendFile(argv[arg + 1], network::Message::Type::FIX)) {
                 std::cout << "File processed successfully\n";
             } else {
                 std::cout << "Failed to process file: " << client.getLastError() << "\n";
                 return 1;
             }
         }
-        else if (option == "-o" && argc > 2) {
-            network::Message msg(network::Message::Type::FIX, argv[2]);
+        else if (option == "-o" && argc > arg + 1) {
+            network::Message msg(network::Message::Type::FIX, argv[arg + 1]);
             if (client.send(msg)) {
                 std::cout << "Order sent successfully\n";
             } else {
@@ -0,0 +1,374 @@
+// include/BinaryProtocol.hpp
+#ifndef BINARY_PROTOCOL_HPP
+#define BINARY_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "FixSchema.hpp"
+
+// Fixed-layout binary encoding of the order messages, in the style of SBE:
+// every message is a struct of little-endian fields behind a header that
+// starts with the message's length, so a receiver frames messages by that
+// length and reads fields in place by overlaying the struct on its buffer.
+// Text fields are fixed-size and padded with NULs. A connection switches to
+// it from text FIX with a Logon carrying WireEncoding (5000) BINARY.
+//
+// The structs are packed, so one may be overlaid wherever a message starts;
+// every field still sits at its natural alignment within the message.
+namespace binary {
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Messages are read in place, so the host must be little-endian");
+
+    constexpr uint16_t kSchemaId = 1;
+    constexpr uint16_t kVersion = 1;
+
+    constexpr std::size_t kIdSize = 20;         // ClOrdID, OrigClOrdID
+    constexpr std::size_t kAccountSize = 12;
+    constexpr std::size_t kSymbolSize = 8;
+    constexpr std::size_t kTextSize = 64;
+
+#pragma pack(push, 1)
+    struct MessageHeader {
+        uint16_t length;        // Whole message, header included
+        uint16_t templateId;
+        uint16_t schemaId;
+        uint16_t version;
+    };
+
+    struct NewOrder {
+        static constexpr uint16_t kTemplateId = 1;
+
+        MessageHeader header;
+        char clOrdId[kIdSize];
+        char account[kAccountSize];
+        char symbol[kSymbolSize];
+        int64_t price;          // Mantissa at priceScale
+        int64_t orderQty;
+        uint8_t priceScale;
+        char side;
+        char ordType;
+        uint8_t padding[5];
+    };
+
+    struct Cancel {
+        static constexpr uint16_t kTemplateId = 2;
+
+        MessageHeader header;
+        char clOrdId[kIdSize];
+        char origClOrdId[kIdSize];
+        char account[kAccountSize];
+        char symbol[kSymbolSize];
+        char side;
+        uint8_t padding[3];
+        int64_t orderQty;
+    };
+
+    struct Replace {
+        static constexpr uint16_t kTemplateId = 3;
+
+        MessageHeader header;
+        char clOrdId[kIdSize];
+        char origClOrdId[kIdSize];
+        char account[kAccountSize];
+        char symbol[kSymbolSize];
+        char side;
+        char ordType;
+        uint8_t priceScale;
+        uint8_t padding;
+        int64_t price;
+        int64_t orderQty;
+    };
+
+    // The answer to any request. A rejection has ExecType and OrdStatus
+    // Rejected and the reason in text; the request's fields are echoed as far
+    // as they could be read.
+    struct ExecutionReport {
+        static constexpr uint16_t kTemplateId = 8;
+
+        MessageHeader header;
+        char clOrdId[kIdSize];
+        char origClOrdId[kIdSize];
+        char symbol[kSymbolSize];
+        int64_t price;
+        int64_t orderQty;
+        int64_t cumQty;
+        char execType;
+        char ordStatus;
+        char side;
+        uint8_t priceScale;
+        uint8_t padding[4];
+        char text[kTextSize];
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(MessageHeader) == 8, "Unexpected header layout");
+    static_assert(sizeof(NewOrder) == 72 && offsetof(NewOrder, price) % 8 == 0, "Unexpected NewOrder layout");
+    static_assert(sizeof(Cancel) == 80 && offsetof(Cancel, orderQty) % 8 == 0, "Unexpected Cancel layout");
+    static_assert(sizeof(Replace) == 88 && offsetof(Replace, price) % 8 == 0, "Unexpected Replace layout");
+    static_assert(sizeof(ExecutionReport) == 152 && offsetof(ExecutionReport, price) % 8 == 0,
+                  "Unexpected ExecutionReport layout");
+
+    // Text in a NUL-padded field, as a view into the message
+    template<std::size_t N>
+    std::string_view text(const char (&field)[N]) {
+        const void* nul = std::memchr(field, '\0', N);
+        return std::string_view(field, nul ? static_cast<const char*>(nul) - field : N);
+    }
+
+    // Writes value into a NUL-padded field; throws if it does not fit
+    template<std::size_t N>
+    void setText(char (&field)[N], std::string_view value, const char* name) {
+        if (value.size() > N) {
+            throw std::invalid_argument(std::string(name) + " longer than " + std::to_string(N) + " bytes");
+        }
+        std::memcpy(field, value.data(), value.size());
+        std::memset(field + value.size(), 0, N - value.size());
+    }
+
+    // As setText(), cutting value short instead of throwing
+    template<std::size_t N>
+    void setTruncatedText(char (&field)[N], std::string_view value) {
+        setText(field, value.substr(0, N), "");
+    }
+
+    template<typename Msg>
+    void initHeader(Msg& msg) {
+        msg.header.length = sizeof(Msg);
+        msg.header.templateId = Msg::kTemplateId;
+        msg.header.schemaId = kSchemaId;
+        msg.header.version = kVersion;
+    }
+
+    // Template of a framed message; throws if it is not one of this schema
+    inline uint16_t templateId(std::string_view message) {
+        if (message.size() < sizeof(MessageHeader)) {
+            throw std::invalid_argument("Binary message shorter than its header");
+        }
+        const auto& header = *reinterpret_cast<const MessageHeader*>(message.data());
+        if (header.schemaId != kSchemaId || header.version != kVersion) {
+            throw std::invalid_argument("Unsupported binary schema " + std::to_string(header.schemaId) +
+                                        " version " + std::to_string(header.version));
+        }
+        return header.templateId;
+    }
+
+    // The message itself, read in place; throws if it is too short for Msg
+    template<typename Msg>
+    const Msg& overlay(std::string_view message) {
+        if (message.size() < sizeof(Msg)) {
+            throw std::invalid_argument("Binary message of " + std::to_string(message.size()) +
+                                        " bytes is too short for template " + std::to_string(Msg::kTemplateId));
+        }
+        return *reinterpret_cast<const Msg*>(message.data());
+    }
+
+    // Price from the wire; a scale Price cannot represent would index past
+    // its powers of ten wherever the price is compared or rescaled
+    inline Price price(int64_t mantissa, uint8_t scale) {
+        if (scale > Price::kMaxScale) {
+            throw std::invalid_argument("Price scale " + std::to_string(scale) + " exceeds " +
+                                        std::to_string(Price::kMaxScale));
+        }
+        return Price(mantissa, scale);
+    }
+
+    // Typed messages viewing the binary one, so the rest of the order path
+    // handles both encodings alike; required fields are checked as in fix::decode()
+    inline fix::NewOrderSingle decode(const NewOrder& in, InstrumentRegistry& instruments) {
+        fix::NewOrderSingle order;
+        order.account = text(in.account);
+        order.clOrdId = text(in.clOrdId);
+        order.symbol = text(in.symbol);
+        order.side = in.side;
+        order.ordType = in.ordType;
+        order.orderQty = Qty(in.orderQty);
+        order.price = price(in.price, in.priceScale);
+        if (order.clOrdId.empty() || order.symbol.empty() || order.side == 0) {
+            throw std::invalid_argument("NewOrder is missing ClOrdID, Symbol or Side");
+        }
+        order.instrument = instruments.resolve(order.symbol);
+        return order;
+    }
+
+    inline fix::OrderCancelRequest decode(const Cancel& in, InstrumentRegistry& instruments) {
+        fix::OrderCancelRequest cancel;
+        cancel.account = text(in.account);
+        cancel.clOrdId = text(in.clOrdId);
+        cancel.origClOrdId = text(in.origClOrdId);
+        cancel.symbol = text(in.symbol);
+        cancel.side = in.side;
+        cancel.orderQty = Qty(in.orderQty);
+        if (cancel.clOrdId.empty() || cancel.origClOrdId.empty()) {
+            throw std::invalid_argument("Cancel is missing ClOrdID or OrigClOrdID");
+        }
+        if (!cancel.symbol.empty()) {
+            cancel.instrument = instruments.resolve(cancel.symbol);
+        }
+        return cancel;
+    }
+
+    inline fix::OrderCancelReplaceRequest decode(const Replace& in, InstrumentRegistry& instruments) {
+        fix::OrderCancelReplaceRequest replace;
+        replace.account = text(in.account);
+        replace.clOrdId = text(in.clOrdId);
+        replace.origClOrdId = text(in.origClOrdId);
+        replace.symbol = text(in.symbol);
+        replace.side = in.side;
+        replace.ordType = in.ordType;
+        replace.orderQty = Qty(in.orderQty);
+        replace.price = price(in.price, in.priceScale);
+        if (replace.clOrdId.empty() || replace.origClOrdId.empty() || replace.symbol.empty() || replace.side == 0) {
+            throw std::invalid_argument("Replace is missing ClOrdID, OrigClOrdID, Symbol or Side");
+        }
+        replace.instrument = instruments.resolve(replace.symbol);
+        return replace;
+    }
+
+    inline void encode(const fix::NewOrderSingle& order, NewOrder& out) {
+        out = NewOrder{};
+        initHeader(out);
+        setText(out.clOrdId, order.clOrdId, "ClOrdID");
+        setText(out.account, order.account, "Account");
+        setText(out.symbol, order.symbol, "Symbol");
+        out.price = order.price.mantissa;
+        out.priceScale = order.price.scale;
+        out.orderQty = order.orderQty.value;
+        out.side = order.side;
+        out.ordType = order.ordType;
+    }
+
+    inline void encode(const fix::OrderCancelRequest& cancel, Cancel& out) {
+        out = Cancel{};
+        initHeader(out);
+        setText(out.clOrdId, cancel.clOrdId, "ClOrdID");
+        setText(out.origClOrdId, cancel.origClOrdId, "OrigClOrdID");
+        setText(out.account, cancel.account, "Account");
+        setText(out.symbol, cancel.symbol, "Symbol");
+        out.side = cancel.side;
+        out.orderQty = cancel.orderQty.value;
+    }
+
+    inline void encode(const fix::OrderCancelReplaceRequest& replace, Replace& out) {
+        out = Replace{};
+        initHeader(out);
+        setText(out.clOrdId, replace.clOrdId, "ClOrdID");
+        setText(out.origClOrdId, replace.origClOrdId, "OrigClOrdID");
+        setText(out.account, replace.account, "Account");
+        setText(out.symbol, replace.symbol, "Symbol");
+        out.price = replace.price.mantissa;
+        out.priceScale = replace.price.scale;
+        out.orderQty = replace.orderQty.value;
+        out.side = replace.side;
+        out.ordType = replace.ordType;
+    }
+
+    template<typename Msg>
+    void append(std::string& out, const Msg& msg) {
+        out.append(reinterpret_cast<const char*>(&msg), sizeof(Msg));
+    }
+
+    // Appends the binary form of a text NewOrderSingle, OrderCancelRequest or
+    // OrderCancelReplaceRequest; throws for anything else
+    inline void appendFromFix(std::string_view fixMessage, std::string& out) {
+        std::string_view msgType = fix::messageType(fixMessage);
+        if (msgType == fix::NewOrderSingle::kMsgType) {
+            NewOrder order;
+            encode(fix::decode<fix::NewOrderSingle>(fixMessage), order);
+            append(out, order);
+        } else if (msgType == fix::OrderCancelRequest::kMsgType) {
+            Cancel cancel;
+            encode(fix::decode<fix::OrderCancelRequest>(fixMessage), cancel);
+            append(out, cancel);
+        } else if (msgType == fix::OrderCancelReplaceRequest::kMsgType) {
+            Replace replace;
+            encode(fix::decode<fix::OrderCancelReplaceRequest>(fixMessage), replace);
+            append(out, replace);
+        } else {
+            throw std::invalid_argument("No binary encoding for MsgType: " + std::string(msgType));
+        }
+    }
+
+    // Copies a request's fields into the report that answers it, so a
+    // rejection names the order too, and returns the request's template;
+    // throws as templateId() and overlay() do
+    inline uint16_t echoRequest(std::string_view message, ExecutionReport& report) {
+        uint16_t id = templateId(message);
+        switch (id) {
+            case NewOrder::kTemplateId: {
+                const auto& in = overlay<NewOrder>(message);
+                std::memcpy(report.clOrdId, in.clOrdId, sizeof report.clOrdId);
+                std::memcpy(report.symbol, in.symbol, sizeof report.symbol);
+                report.side = in.side;
+                report.price = in.price;
+                report.priceScale = in.priceScale;
+                report.orderQty = in.orderQty;
+                break;
+            }
+            case Cancel::kTemplateId: {
+                const auto& in = overlay<Cancel>(message);
+                std::memcpy(report.clOrdId, in.clOrdId, sizeof report.clOrdId);
+                std::memcpy(report.origClOrdId, in.origClOrdId, sizeof report.origClOrdId);
+                std::memcpy(report.symbol, in.symbol, sizeof report.symbol);
+                report.side = in.side;
+                report.orderQty = in.orderQty;
+                break;
+            }
+            case Replace::kTemplateId: {
+                const auto& in = overlay<Replace>(message);
+                std::memcpy(report.clOrdId, in.clOrdId, sizeof report.clOrdId);
+                std::memcpy(report.origClOrdId, in.origClOrdId, sizeof report.origClOrdId);
+                std::memcpy(report.symbol, in.symbol, sizeof report.symbol);
+                report.side = in.side;
+                report.price = in.price;
+                report.priceScale = in.priceScale;
+                report.orderQty = in.orderQty;
+                break;
+            }
+            default:
+                throw std::invalid_argument("Unsupported binary template: " + std::to_string(id));
+        }
+        return id;
+    }
+
+    // Status a text ACK reports for an OrdStatus
+    inline std::string_view ackStatus(char ordStatus) {
+        switch (ordStatus) {
+            case fix::status::PartiallyFilled: return "PARTIALLY_FILLED";
+            case fix::status::Filled: return "FILLED";
+            case fix::status::Canceled: return "CANCELLED";
+            case fix::status::Replaced: return "REPLACE_ACCEPTED";
+            case fix::status::Rejected: return "REJECTED";
+            default: return "ACCEPTED";
+        }
+    }
+
+    // The report as a text ACK or NAK, naming the order, for callers that
+    // handle responses of both encodings alike
+    inline std::string describe(const ExecutionReport& report) {
+        std::string out = report.ordStatus == fix::status::Rejected ? "NAK|" : "ACK|";
+        std::string_view clOrdId = text(report.clOrdId);
+        if (!clOrdId.empty()) {
+            out.append("OrderID=").append(clOrdId).append("|");
+        }
+        if (report.ordStatus == fix::status::Rejected) {
+            out.append("Error=").append(text(report.text));
+            return out;
+        }
+        std::string_view origClOrdId = text(report.origClOrdId);
+        if (!origClOrdId.empty()) {
+            out.append("OrigOrderID=").append(origClOrdId).append("|");
+        }
+        out.append("Symbol=").append(text(report.symbol))
+           .append("|Side=").append(report.side == fix::side::Buy ? "BUY" : "SELL")
+           .append("|Quantity=").append(Qty(report.orderQty).toString())
+           .append("|Price=").append(Price(report.price, report.priceScale).toString())
+           .append("|Status=").append(ackStatus(report.ordStatus))
+           .append("|FilledQty=").append(Qty(report.cumQty).toString()).append("|");
+        return out;
+    }
+}
+
+#endif // BINARY_PROTOCOL_HPP
@@ -0,0 +1,63 @@
+// include/DelimiterScanner.hpp
+#ifndef DELIMITER_SCANNER_HPP
+#define DELIMITER_SCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace simd {
+    enum class Isa {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    // Best instruction set supported by the running CPU (resolved once)
+    Isa activeIsa();
+    bool isaSupported(Isa isa);
+    const char* isaName(Isa isa);
+
+    // Bit i is set when block[i] == a or block[i] == b, for the 64 bytes at block
+    using DelimiterMaskFn = uint64_t (*)(const char* block, char a, char b);
+    DelimiterMaskFn delimiterMaskFn(Isa isa);
+}
+
+// Walks the offsets of up to two delimiter characters in a buffer, 64 bytes at a
+// time, using a bitmask of delimiter positions per block.
+class DelimiterScanner {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t kBlockSize = 64;
+
+    DelimiterScanner(std::string_view data, char a, char b, simd::Isa isa = simd::activeIsa());
+    DelimiterScanner(std::string_view data, char delimiter, simd::Isa isa = simd::activeIsa())
+        : DelimiterScanner(data, delimiter, delimiter, isa) {}
+
+    // Offset of the next delimiter, or npos once the buffer is exhausted
+    std::size_t next() {
+        while (mask_ == 0) {
+            blockBase_ += kBlockSize;
+            if (blockBase_ >= size_) {
+                return npos;
+            }
+            loadBlock();
+        }
+        std::size_t offset = blockBase_ + static_cast<std::size_t>(__builtin_ctzll(mask_));
+        mask_ &= mask_ - 1;
+        return offset;
+    }
+
+private:
+    void loadBlock();
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t blockBase_{0};
+    uint64_t mask_{0};
+    char a_;
+    char b_;
+    simd::DelimiterMaskFn maskFn_;
+};
+
+#endif // DELIMITER_SCANNER_HPP
@@ -0,0 +1,68 @@
+// include/FixEncoder.hpp
+#ifndef FIX_ENCODER_HPP
+#define FIX_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Writes a FIX message into a caller-supplied buffer without allocating.
+// Space for "8=...|9=...|" is reserved up front; finish() back-patches the
+// BodyLength once the body is known and appends CheckSum (10), which is summed
+// as bytes are written. NetworkServer encodes the ExecutionReports it sends
+// unprompted (fills of resting orders) with it; replies to requests stay in
+// the gateway's ACK/NAK line format.
+//
+//   char buffer[512];
+//   FixEncoder encoder(buffer, sizeof(buffer));
+//   encoder.begin("8");
+//   encoder.field(fix::tag::ClOrdID, "ORDER123").field(fix::tag::CumQty, int64_t{100});
+//   std::string_view message = encoder.finish();
+class FixEncoder {
+public:
+    static constexpr std::string_view kBeginString = "FIX.4.2";
+    static constexpr char kDelimiter = '|';
+    // "8=FIX.4.2|9=" + up to 7 BodyLength digits + "|"
+    static constexpr std::size_t kHeaderReserve = 2 + kBeginString.size() + 1 + 2 + 7 + 1;
+    // "10=" + 3 digits + "|"
+    static constexpr std::size_t kTrailerSize = 7;
+    static constexpr std::size_t kMaxBodyLength = 9'999'999;
+
+    FixEncoder(char* buffer, std::size_t capacity);
+
+    // Starts a new message with the given MsgType (35), discarding any previous one
+    FixEncoder& begin(std::string_view msgType);
+
+    FixEncoder& field(int tag, std::string_view value);
+    FixEncoder& field(int tag, char value);
+    FixEncoder& field(int tag, int64_t value);
+    FixEncoder& field(int tag, int value) { return field(tag, static_cast<int64_t>(value)); }
+    // Writes mantissa / 10^scale with exactly `scale` fractional digits
+    FixEncoder& decimalField(int tag, int64_t mantissa, unsigned scale);
+
+    // Back-patches 8 and 9, appends 10 and returns the complete message
+    std::string_view finish();
+
+    std::size_t bodyLength() const { return static_cast<std::size_t>(cursor_ - body_); }
+
+    // Hand-rolled formatting helpers; return the number of characters written.
+    // `out` must have room for 20 characters (plus scale + 1 for decimals).
+    static std::size_t formatInteger(char* out, int64_t value);
+    static std::size_t formatDecimal(char* out, int64_t mantissa, unsigned scale);
+
+private:
+    void ensure(std::size_t bytes) const;
+    void appendTag(int tag);
+    void appendRaw(const char* data, std::size_t length);
+    void appendChar(char c) {
+        *cursor_++ = c;
+        checksum_ += static_cast<unsigned char>(c);
+    }
+
+    char* body_;
+    char* cursor_;
+    char* limit_;
+    uint32_t checksum_{0};
+};
+
+#endif // FIX_ENCODER_HPP
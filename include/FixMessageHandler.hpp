@@ -2,13 +2,18 @@
 #define FIX_MESSAGE_HANDLER_HPP
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include "FixMessageView.hpp"
 
 class FixMessageHandler {
 public:
+    // Zero-copy parse: field values point into fixMessage, nothing is allocated
+    FixMessageView parseFixMessageView(std::string_view fixMessage) const;
+
+    // Compatibility wrapper over parseFixMessageView that copies into a map
     std::unordered_map<std::string, std::string> parseFixMessage(const std::string& fixMessage);
     std::string buildFixMessage(const std::unordered_map<std::string, std::string>& fields);
 };
 
 #endif // FIX_MESSAGE_HANDLER_HPP
-
@@ -0,0 +1,77 @@
+// include/FixMessageView.hpp
+#ifndef FIX_MESSAGE_VIEW_HPP
+#define FIX_MESSAGE_VIEW_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+
+// A single tag=value pair. The value points into the caller's buffer.
+struct FixField {
+    int tag{0};
+    std::string_view value;
+};
+
+// Flat, fixed-capacity set of fields parsed from one FIX message.
+// Lives entirely on the stack; the viewed buffer must outlive it.
+class FixMessageView {
+public:
+    static constexpr std::size_t kMaxFields = 64;
+    // Tags below this bound (8, 11, 35, 38, 44, 54, 55, ...) are looked up in O(1)
+    static constexpr int kDirectTagLimit = 64;
+
+    void add(int tag, std::string_view value) {
+        if (count_ == kMaxFields) {
+            throw std::invalid_argument("Too many FIX fields");
+        }
+        new (&storage_[count_ * sizeof(FixField)]) FixField{tag, value};
+        ++count_;
+        if (tag >= 0 && tag < kDirectTagLimit) {
+            // Last occurrence wins, matching the map-based parser
+            direct_[tag] = static_cast<uint8_t>(count_);
+        }
+    }
+
+    const FixField* find(int tag) const {
+        if (tag >= 0 && tag < kDirectTagLimit) {
+            uint8_t slot = direct_[tag];
+            return slot ? &fields()[slot - 1] : nullptr;
+        }
+        for (std::size_t i = count_; i > 0; --i) {
+            if (fields()[i - 1].tag == tag) {
+                return &fields()[i - 1];
+            }
+        }
+        return nullptr;
+    }
+
+    // Returns an empty view when the tag is absent
+    std::string_view get(int tag) const {
+        const FixField* field = find(tag);
+        return field ? field->value : std::string_view{};
+    }
+
+    bool has(int tag) const { return find(tag) != nullptr; }
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    const FixField* begin() const { return fields(); }
+    const FixField* end() const { return fields() + count_; }
+    const FixField& operator[](std::size_t i) const { return fields()[i]; }
+
+private:
+    const FixField* fields() const {
+        return std::launder(reinterpret_cast<const FixField*>(storage_));
+    }
+
+    // Left uninitialised so a parse does not pay for zeroing unused slots
+    alignas(FixField) unsigned char storage_[kMaxFields * sizeof(FixField)];
+    std::array<uint8_t, kDirectTagLimit> direct_{};
+    std::size_t count_{0};
+};
+
+#endif // FIX_MESSAGE_VIEW_HPP
@@ -0,0 +1,426 @@
+// include/FixSchema.hpp
+#ifndef FIX_SCHEMA_HPP
+#define FIX_SCHEMA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include "FixEncoder.hpp"
+#include "FixedPoint.hpp"
+#include "FixTokenizer.hpp"
+#include "InstrumentRegistry.hpp"
+
+namespace fix {
+    namespace tag {
+        constexpr int Account = 1;
+        constexpr int ClOrdID = 11;
+        constexpr int CumQty = 14;
+        constexpr int ExecID = 17;
+        constexpr int LastPx = 31;
+        constexpr int LastQty = 32;
+        constexpr int MsgType = 35;
+        constexpr int OrderID = 37;
+        constexpr int OrderQty = 38;
+        constexpr int OrdStatus = 39;
+        constexpr int OrdType = 40;
+        constexpr int OrigClOrdID = 41;
+        constexpr int Price = 44;
+        constexpr int SenderCompID = 49;
+        constexpr int Side = 54;
+        constexpr int Symbol = 55;
+        constexpr int TargetCompID = 56;
+        constexpr int Text = 58;
+        constexpr int ExecType = 150;
+        constexpr int LeavesQty = 151;
+        // Gateway-specific, from the user-defined range 5000-9999: the encoding a
+        // connection uses after its Logon, TEXT (the default) or BINARY
+        constexpr int WireEncoding = 5000;
+    }
+
+    namespace side {
+        constexpr char Buy = '1';
+        constexpr char Sell = '2';
+    }
+
+    namespace ord_type {
+        constexpr char Market = '1';
+        constexpr char Limit = '2';
+    }
+
+    // ExecType (150) and OrdStatus (39) values; FIX 4.2 shares the codes
+    namespace status {
+        constexpr char New = '0';
+        constexpr char PartiallyFilled = '1';
+        constexpr char Filled = '2';
+        constexpr char Canceled = '4';
+        constexpr char Replaced = '5';
+        constexpr char Rejected = '8';
+    }
+
+    // Typed messages. String fields are views into the decoded buffer.
+    struct NewOrderSingle {
+        static constexpr std::string_view kMsgType = "D";
+
+        std::string_view senderCompId;
+        std::string_view targetCompId;
+        std::string_view account;
+        std::string_view clOrdId;
+        std::string_view symbol;
+        InstrumentId instrument{kUnknownInstrument};  // Set when decoded with a registry
+        char side{0};
+        char ordType{0};
+        Qty orderQty;
+        Price price;
+    };
+
+    struct OrderCancelRequest {
+        static constexpr std::string_view kMsgType = "F";
+
+        std::string_view senderCompId;
+        std::string_view targetCompId;
+        std::string_view account;
+        std::string_view clOrdId;
+        std::string_view origClOrdId;
+        std::string_view symbol;
+        InstrumentId instrument{kUnknownInstrument};
+        char side{0};
+        Qty orderQty;
+    };
+
+    struct OrderCancelReplaceRequest {
+        static constexpr std::string_view kMsgType = "G";
+
+        std::string_view senderCompId;
+        std::string_view targetCompId;
+        std::string_view account;
+        std::string_view clOrdId;
+        std::string_view origClOrdId;
+        std::string_view symbol;
+        InstrumentId instrument{kUnknownInstrument};
+        char side{0};
+        char ordType{0};
+        Qty orderQty;
+        Price price;
+    };
+
+    struct ExecutionReport {
+        static constexpr std::string_view kMsgType = "8";
+
+        std::string_view senderCompId;
+        std::string_view targetCompId;
+        std::string_view orderId;
+        std::string_view clOrdId;
+        std::string_view origClOrdId;
+        std::string_view execId;
+        char execType{0};
+        char ordStatus{0};
+        std::string_view symbol;
+        InstrumentId instrument{kUnknownInstrument};
+        char side{0};
+        Qty orderQty;
+        Price price;
+        Qty lastQty;
+        Price lastPx;
+        Qty leavesQty;
+        Qty cumQty;
+        std::string_view text;
+    };
+
+    struct Logon {
+        static constexpr std::string_view kMsgType = "A";
+
+        std::string_view senderCompId;
+        std::string_view targetCompId;
+        std::string_view wireEncoding;
+    };
+
+    namespace detail {
+        inline void decodeValue(int, std::string_view value, std::string_view& out) {
+            out = value;
+        }
+
+        inline void decodeValue(int tag, std::string_view value, char& out) {
+            if (value.size() != 1) {
+                throw std::invalid_argument("Invalid char value for FIX tag " + std::to_string(tag));
+            }
+            out = value[0];
+        }
+
+        inline void decodeValue(int tag, std::string_view value, Qty& out) {
+            if (!Qty::tryParse(value, out)) {
+                throw std::invalid_argument("Invalid quantity value for FIX tag " + std::to_string(tag));
+            }
+        }
+
+        // Prices keep the precision they were sent with; callers rescale to the
+        // instrument's scale once the instrument is known
+        inline void decodeValue(int tag, std::string_view value, Price& out) {
+            if (!Price::tryParse(value, out)) {
+                throw std::invalid_argument("Invalid price value for FIX tag " + std::to_string(tag));
+            }
+        }
+
+        // Optional fields are only written when set
+        inline void encodeValue(FixEncoder& encoder, int tag, bool required, std::string_view value) {
+            if (required || !value.empty()) {
+                encoder.field(tag, value);
+            }
+        }
+
+        inline void encodeValue(FixEncoder& encoder, int tag, bool required, char value) {
+            if (required || value != 0) {
+                encoder.field(tag, value);
+            }
+        }
+
+        inline void encodeValue(FixEncoder& encoder, int tag, bool required, Qty value) {
+            if (required || !value.isZero()) {
+                encoder.field(tag, value.value);
+            }
+        }
+
+        inline void encodeValue(FixEncoder& encoder, int tag, bool required, const Price& value) {
+            if (required || !value.isZero()) {
+                encoder.decimalField(tag, value.mantissa, value.scale);
+            }
+        }
+
+        template<int MaxTag, int... Tags>
+        constexpr std::array<uint8_t, MaxTag + 1> makeSlotTable() {
+            std::array<uint8_t, MaxTag + 1> table{};
+            uint8_t slot = 1;
+            ((table[Tags] = slot++), ...);
+            return table;
+        }
+
+        template<bool... Required>
+        constexpr uint64_t makeRequiredMask() {
+            uint64_t mask = 0;
+            std::size_t slot = 0;
+            ((mask |= (Required ? (uint64_t{1} << slot) : 0), ++slot), ...);
+            return mask;
+        }
+    }
+
+    // Binds a tag to a member of the message struct
+    template<int Tag, auto Member, bool Required = false>
+    struct Field {
+        static constexpr int tag = Tag;
+        static constexpr bool required = Required;
+
+        template<typename Msg>
+        static void decode(Msg& msg, std::string_view value) {
+            detail::decodeValue(Tag, value, msg.*Member);
+        }
+
+        template<typename Msg>
+        static void encode(const Msg& msg, FixEncoder& encoder) {
+            detail::encodeValue(encoder, Tag, Required, msg.*Member);
+        }
+    };
+
+    // Compile-time description of a message layout. The tag -> field slot table
+    // and the slot -> decoder table are built at compile time, so decoding a
+    // field is two array indexes and one indirect call.
+    template<typename Msg, typename... Fields>
+    struct MessageSchema {
+        static_assert(sizeof...(Fields) > 0 && sizeof...(Fields) < 64, "Unsupported schema size");
+
+        using FieldList = std::tuple<Fields...>;
+        static constexpr std::size_t kFieldCount = sizeof...(Fields);
+        static constexpr int kMaxTag = std::max({Fields::tag...});
+
+        static constexpr std::array<uint8_t, kMaxTag + 1> kSlotByTag =
+            detail::makeSlotTable<kMaxTag, Fields::tag...>();
+        static constexpr uint64_t kRequiredMask = detail::makeRequiredMask<Fields::required...>();
+
+        using Decoder = void (*)(Msg&, std::string_view);
+        static constexpr Decoder kDecoderBySlot[] = {&Fields::template decode<Msg>...};
+
+        // Decodes one field into msg and records it in seen; unknown tags are skipped
+        static void decodeField(Msg& msg, int tag, std::string_view value, uint64_t& seen) {
+            if (tag < 0 || tag > kMaxTag) {
+                return;
+            }
+            std::size_t slot = kSlotByTag[tag];
+            if (slot == 0) {
+                return;
+            }
+            kDecoderBySlot[slot - 1](msg, value);
+            seen |= uint64_t{1} << (slot - 1);
+        }
+
+        // Writes every field in schema order
+        static void encodeFields(const Msg& msg, FixEncoder& encoder) {
+            (Fields::encode(msg, encoder), ...);
+        }
+
+        static void validate(uint64_t seen) {
+            uint64_t missing = kRequiredMask & ~seen;
+            if (missing != 0) {
+                throw std::invalid_argument("Missing required FIX tag " +
+                    std::to_string(tagAt(static_cast<std::size_t>(__builtin_ctzll(missing)))));
+            }
+        }
+
+    private:
+        static int tagAt(std::size_t slot) {
+            constexpr int tags[] = {Fields::tag...};
+            return tags[slot];
+        }
+    };
+
+    template<typename Msg>
+    struct Schema;
+
+    template<>
+    struct Schema<NewOrderSingle> {
+        using M = NewOrderSingle;
+        using type = MessageSchema<M,
+            Field<tag::SenderCompID, &M::senderCompId>,
+            Field<tag::TargetCompID, &M::targetCompId>,
+            Field<tag::Account, &M::account>,
+            Field<tag::ClOrdID, &M::clOrdId, true>,
+            Field<tag::Symbol, &M::symbol, true>,
+            Field<tag::Side, &M::side, true>,
+            Field<tag::OrdType, &M::ordType>,
+            Field<tag::OrderQty, &M::orderQty, true>,
+            Field<tag::Price, &M::price>>;
+    };
+
+    template<>
+    struct Schema<OrderCancelRequest> {
+        using M = OrderCancelRequest;
+        using type = MessageSchema<M,
+            Field<tag::SenderCompID, &M::senderCompId>,
+            Field<tag::TargetCompID, &M::targetCompId>,
+            Field<tag::Account, &M::account>,
+            Field<tag::ClOrdID, &M::clOrdId, true>,
+            Field<tag::OrigClOrdID, &M::origClOrdId, true>,
+            Field<tag::Symbol, &M::symbol>,
+            Field<tag::Side, &M::side>,
+            Field<tag::OrderQty, &M::orderQty>>;
+    };
+
+    template<>
+    struct Schema<OrderCancelReplaceRequest> {
+        using M = OrderCancelReplaceRequest;
+        using type = MessageSchema<M,
+            Field<tag::SenderCompID, &M::senderCompId>,
+            Field<tag::TargetCompID, &M::targetCompId>,
+            Field<tag::Account, &M::account>,
+            Field<tag::ClOrdID, &M::clOrdId, true>,
+            Field<tag::OrigClOrdID, &M::origClOrdId, true>,
+            Field<tag::Symbol, &M::symbol, true>,
+            Field<tag::Side, &M::side, true>,
+            Field<tag::OrdType, &M::ordType>,
+            Field<tag::OrderQty, &M::orderQty, true>,
+            Field<tag::Price, &M::price>>;
+    };
+
+    template<>
+    struct Schema<ExecutionReport> {
+        using M = ExecutionReport;
+        using type = MessageSchema<M,
+            Field<tag::SenderCompID, &M::senderCompId>,
+            Field<tag::TargetCompID, &M::targetCompId>,
+            Field<tag::OrderID, &M::orderId, true>,
+            Field<tag::ClOrdID, &M::clOrdId>,
+            Field<tag::OrigClOrdID, &M::origClOrdId>,
+            Field<tag::ExecID, &M::execId, true>,
+            Field<tag::ExecType, &M::execType, true>,
+            Field<tag::OrdStatus, &M::ordStatus, true>,
+            Field<tag::Symbol, &M::symbol, true>,
+            Field<tag::Side, &M::side, true>,
+            Field<tag::OrderQty, &M::orderQty>,
+            Field<tag::Price, &M::price>,
+            Field<tag::LastQty, &M::lastQty>,
+            Field<tag::LastPx, &M::lastPx>,
+            Field<tag::LeavesQty, &M::leavesQty, true>,
+            Field<tag::CumQty, &M::cumQty, true>,
+            Field<tag::Text, &M::text>>;
+    };
+
+    template<>
+    struct Schema<Logon> {
+        using M = Logon;
+        using type = MessageSchema<M,
+            Field<tag::SenderCompID, &M::senderCompId>,
+            Field<tag::TargetCompID, &M::targetCompId>,
+            Field<tag::WireEncoding, &M::wireEncoding>>;
+    };
+
+    // Value of MsgType (35), found without decoding the rest of the message
+    inline std::string_view messageType(std::string_view fixMessage) {
+        std::size_t start;
+        if (fixMessage.substr(0, 3) == "35=") {
+            start = 3;
+        } else {
+            std::size_t pos = fixMessage.find("|35=");
+            if (pos == std::string_view::npos) {
+                return {};
+            }
+            start = pos + 4;
+        }
+        std::size_t end = fixMessage.find('|', start);
+        return fixMessage.substr(start, end == std::string_view::npos ? end : end - start);
+    }
+
+    // One linear pass over the message straight into the typed struct.
+    // Throws std::invalid_argument on malformed input, a MsgType mismatch or a
+    // missing required tag.
+    template<typename Msg>
+    Msg decode(std::string_view fixMessage) {
+        using S = typename Schema<Msg>::type;
+
+        Msg msg{};
+        uint64_t seen = 0;
+        bool sawMsgType = false;
+
+        forEachField(fixMessage, [&](int tag, std::string_view value) {
+            if (tag == tag::MsgType) {
+                if (value != Msg::kMsgType) {
+                    throw std::invalid_argument("Unexpected MsgType: " + std::string(value));
+                }
+                sawMsgType = true;
+                return;
+            }
+            S::decodeField(msg, tag, value, seen);
+        });
+
+        if (!sawMsgType) {
+            throw std::invalid_argument("Missing required FIX tag 35");
+        }
+        S::validate(seen);
+        return msg;
+    }
+
+    // As decode(), also resolving Symbol (55) into msg.instrument so later
+    // stages index per-instrument state by id rather than hashing the text;
+    // see InstrumentRegistry::resolve for symbols it does not know
+    template<typename Msg>
+    Msg decode(std::string_view fixMessage, InstrumentRegistry& instruments) {
+        Msg msg = decode<Msg>(fixMessage);
+        if (!msg.symbol.empty()) {
+            msg.instrument = instruments.resolve(msg.symbol);
+        }
+        return msg;
+    }
+
+    // Encodes msg with header, fields in schema order, BodyLength and CheckSum.
+    // The returned view points into the encoder's buffer.
+    template<typename Msg>
+    std::string_view encode(const Msg& msg, FixEncoder& encoder) {
+        encoder.begin(Msg::kMsgType);
+        Schema<Msg>::type::encodeFields(msg, encoder);
+        return encoder.finish();
+    }
+}
+
+#endif // FIX_SCHEMA_HPP
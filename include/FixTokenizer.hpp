@@ -0,0 +1,60 @@
+// include/FixTokenizer.hpp
+#ifndef FIX_TOKENIZER_HPP
+#define FIX_TOKENIZER_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "DelimiterScanner.hpp"
+
+namespace fix {
+    // Tags are at most 9 digits so the result always fits in an int
+    constexpr std::size_t kMaxTagDigits = 9;
+
+    inline int parseTag(std::string_view tagText) {
+        if (tagText.empty() || tagText.size() > kMaxTagDigits) {
+            throw std::invalid_argument("Invalid FIX tag: " + std::string(tagText));
+        }
+        int tag = 0;
+        for (char c : tagText) {
+            unsigned digit = static_cast<unsigned char>(c) - '0';
+            if (digit > 9) {
+                throw std::invalid_argument("Invalid FIX tag: " + std::string(tagText));
+            }
+            tag = tag * 10 + static_cast<int>(digit);
+        }
+        return tag;
+    }
+
+    // Single pass over "tag=value|tag=value|...", calling fn(int tag, std::string_view value)
+    // for every field. Values point into fixMessage.
+    template<typename Fn>
+    void forEachField(std::string_view fixMessage, Fn&& fn) {
+        DelimiterScanner scanner(fixMessage, '=', '|');
+        std::size_t fieldStart = 0;
+
+        while (fieldStart < fixMessage.size()) {
+            // The first delimiter of a field must be its '='
+            std::size_t delimiterPos = scanner.next();
+            if (delimiterPos == DelimiterScanner::npos || fixMessage[delimiterPos] == '|') {
+                std::size_t fieldEnd = std::min(delimiterPos, fixMessage.size());
+                throw std::invalid_argument("Invalid FIX field: " +
+                    std::string(fixMessage.substr(fieldStart, fieldEnd - fieldStart)));
+            }
+
+            // Values may themselves contain '=', so skip ahead to the next '|'
+            std::size_t fieldEnd = scanner.next();
+            while (fieldEnd != DelimiterScanner::npos && fixMessage[fieldEnd] == '=') {
+                fieldEnd = scanner.next();
+            }
+            fieldEnd = std::min(fieldEnd, fixMessage.size());
+
+            fn(parseTag(fixMessage.substr(fieldStart, delimiterPos - fieldStart)),
+               fixMessage.substr(delimiterPos + 1, fieldEnd - delimiterPos - 1));
+            fieldStart = fieldEnd + 1;
+        }
+    }
+}
+
+#endif // FIX_TOKENIZER_HPP
@@ -0,0 +1,203 @@
+// include/FixedPoint.hpp
+#ifndef FIXED_POINT_HPP
+#define FIXED_POINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace fixed {
+    constexpr int64_t kPow10[19] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+        100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+        10000000000000LL, 100000000000000LL, 1000000000000000LL,
+        10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+    };
+
+    // Wider than any mantissa product, for comparing prices of different scales
+    __extension__ typedef __int128 Wide;
+
+    constexpr int kNoStop = 256;
+
+    // Accumulates decimal digits up to `stop` without branching on each
+    // character; any non-digit sets `bad` instead of returning early.
+    inline const char* accumulateDigits(const char* p, const char* end, int stop,
+                                        uint64_t& value, std::size_t& digits, unsigned& bad) {
+        for (; p != end && *p != stop; ++p) {
+            unsigned digit = static_cast<unsigned char>(*p) - '0';
+            bad |= static_cast<unsigned>(digit > 9);
+            value = value * 10 + digit;
+            ++digits;
+        }
+        return p;
+    }
+}
+
+// Decimal price held as mantissa * 10^-scale. The scale is per instrument
+// (or, when parsed without one, the number of fractional digits in the text),
+// so prices move through the gateway without floating point.
+struct Price {
+    static constexpr uint8_t kMaxScale = 9;
+
+    int64_t mantissa{0};
+    uint8_t scale{0};
+
+    constexpr Price() = default;
+    constexpr Price(int64_t m, uint8_t s) : mantissa(m), scale(s) {}
+
+    // Parses "[-]digits[.digits]". With scale < 0 the text's own number of
+    // fractional digits is used; otherwise the value is converted to `scale`
+    // and rejected if that would drop non-zero digits.
+    static bool tryParse(std::string_view text, Price& out, int scale = -1) noexcept {
+        const char* p = text.data();
+        const char* end = p + text.size();
+        bool negative = p != end && *p == '-';
+        p += negative;
+
+        uint64_t integerPart = 0;
+        uint64_t fraction = 0;
+        std::size_t integerDigits = 0;
+        std::size_t fractionDigits = 0;
+        unsigned bad = 0;
+
+        p = fixed::accumulateDigits(p, end, '.', integerPart, integerDigits, bad);
+        if (p != end) {
+            p = fixed::accumulateDigits(p + 1, end, fixed::kNoStop, fraction, fractionDigits, bad);
+        }
+
+        if (bad || integerDigits + fractionDigits == 0 || fractionDigits > 18) {
+            return false;
+        }
+
+        std::size_t targetScale = scale < 0 ? fractionDigits : static_cast<std::size_t>(scale);
+        if (targetScale > kMaxScale || integerDigits + targetScale > 18) {
+            return false;
+        }
+        if (fractionDigits > targetScale) {
+            int64_t divisor = fixed::kPow10[fractionDigits - targetScale];
+            if (fraction % static_cast<uint64_t>(divisor) != 0) {
+                return false;
+            }
+            fraction /= static_cast<uint64_t>(divisor);
+        } else {
+            fraction *= static_cast<uint64_t>(fixed::kPow10[targetScale - fractionDigits]);
+        }
+
+        int64_t magnitude = static_cast<int64_t>(integerPart) * fixed::kPow10[targetScale] +
+                            static_cast<int64_t>(fraction);
+        out = Price(negative ? -magnitude : magnitude, static_cast<uint8_t>(targetScale));
+        return true;
+    }
+
+    static Price parse(std::string_view text, int scale = -1) {
+        Price price;
+        if (!tryParse(text, price, scale)) {
+            throw std::invalid_argument("Invalid price: " + std::string(text));
+        }
+        return price;
+    }
+
+    // Lossless change of scale; fails if digits would be dropped or overflow
+    bool tryRescale(uint8_t newScale, Price& out) const noexcept {
+        if (newScale > kMaxScale) {
+            return false;
+        }
+        if (newScale >= scale) {
+            int64_t factor = fixed::kPow10[newScale - scale];
+            int64_t limit = INT64_MAX / factor;
+            if (mantissa > limit || mantissa < -limit) {
+                return false;
+            }
+            out = Price(mantissa * factor, newScale);
+            return true;
+        }
+        int64_t divisor = fixed::kPow10[scale - newScale];
+        if (mantissa % divisor != 0) {
+            return false;
+        }
+        out = Price(mantissa / divisor, newScale);
+        return true;
+    }
+
+    Price rescale(uint8_t newScale) const {
+        Price price;
+        if (!tryRescale(newScale, price)) {
+            throw std::invalid_argument("Price cannot be represented at scale " + std::to_string(newScale));
+        }
+        return price;
+    }
+
+    // Writes the price with exactly `scale` fractional digits; `out` needs 32 bytes
+    std::size_t format(char* out) const;
+    std::string toString() const;
+
+    bool isZero() const { return mantissa == 0; }
+
+    friend int compare(const Price& lhs, const Price& rhs) {
+        if (lhs.scale == rhs.scale) {
+            return (lhs.mantissa > rhs.mantissa) - (lhs.mantissa < rhs.mantissa);
+        }
+        uint8_t common = lhs.scale > rhs.scale ? lhs.scale : rhs.scale;
+        // Widen so mixed scales never overflow
+        fixed::Wide l = static_cast<fixed::Wide>(lhs.mantissa) * fixed::kPow10[common - lhs.scale];
+        fixed::Wide r = static_cast<fixed::Wide>(rhs.mantissa) * fixed::kPow10[common - rhs.scale];
+        return (l > r) - (l < r);
+    }
+
+    friend bool operator==(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) == 0; }
+    friend bool operator!=(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) != 0; }
+    friend bool operator<(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator<=(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) <= 0; }
+    friend bool operator>(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator>=(const Price& lhs, const Price& rhs) { return compare(lhs, rhs) >= 0; }
+};
+
+// Whole-unit order quantity
+struct Qty {
+    int64_t value{0};
+
+    constexpr Qty() = default;
+    constexpr explicit Qty(int64_t v) : value(v) {}
+
+    static bool tryParse(std::string_view text, Qty& out) noexcept {
+        uint64_t value = 0;
+        std::size_t digits = 0;
+        unsigned bad = 0;
+        fixed::accumulateDigits(text.data(), text.data() + text.size(), fixed::kNoStop, value, digits, bad);
+        if (bad || digits == 0 || digits > 18) {
+            return false;
+        }
+        out = Qty(static_cast<int64_t>(value));
+        return true;
+    }
+
+    static Qty parse(std::string_view text) {
+        Qty qty;
+        if (!tryParse(text, qty)) {
+            throw std::invalid_argument("Invalid quantity: " + std::string(text));
+        }
+        return qty;
+    }
+
+    // `out` needs 20 bytes
+    std::size_t format(char* out) const;
+    std::string toString() const;
+
+    bool isZero() const { return value == 0; }
+
+    Qty& operator+=(Qty other) { value += other.value; return *this; }
+    Qty& operator-=(Qty other) { value -= other.value; return *this; }
+    friend Qty operator+(Qty lhs, Qty rhs) { return Qty(lhs.value + rhs.value); }
+    friend Qty operator-(Qty lhs, Qty rhs) { return Qty(lhs.value - rhs.value); }
+
+    friend bool operator==(Qty lhs, Qty rhs) { return lhs.value == rhs.value; }
+    friend bool operator!=(Qty lhs, Qty rhs) { return lhs.value != rhs.value; }
+    friend bool operator<(Qty lhs, Qty rhs) { return lhs.value < rhs.value; }
+    friend bool operator<=(Qty lhs, Qty rhs) { return lhs.value <= rhs.value; }
+    friend bool operator>(Qty lhs, Qty rhs) { return lhs.value > rhs.value; }
+    friend bool operator>=(Qty lhs, Qty rhs) { return lhs.value >= rhs.value; }
+};
+
+#endif // FIXED_POINT_HPP
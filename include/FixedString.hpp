@@ -0,0 +1,77 @@
+// include/FixedString.hpp
+#ifndef FIXED_STRING_HPP
+#define FIXED_STRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Inline, fixed-capacity string for identifiers such as ClOrdID and Symbol.
+// Unused bytes are zero (NUL-padded, no separate length), so whole-buffer
+// compares and hashes are valid and sizeof equals the capacity.
+template<std::size_t Capacity>
+class FixedString {
+    static_assert(Capacity > 0, "FixedString capacity must be positive");
+
+public:
+    static constexpr std::size_t kCapacity = Capacity;
+
+    constexpr FixedString() = default;
+
+    explicit FixedString(std::string_view text) {
+        if (!fits(text)) {
+            throw std::length_error("Identifier longer than " + std::to_string(Capacity) +
+                                    " characters: " + std::string(text));
+        }
+        std::memcpy(data_, text.data(), text.size());
+    }
+
+    static bool fits(std::string_view text) { return text.size() <= Capacity; }
+
+    std::string_view view() const { return std::string_view(data_, size()); }
+    std::string str() const { return std::string(view()); }
+    const char* data() const { return data_; }
+    std::size_t size() const { return strnlen(data_, Capacity); }
+    bool empty() const { return data_[0] == '\0'; }
+
+    // 64-bit hash over the whole padded buffer, a word at a time
+    uint64_t hash() const {
+        uint64_t h = 0x9E3779B97F4A7C15ULL ^ Capacity;
+        std::size_t i = 0;
+        for (; i + 8 <= Capacity; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data_ + i, 8);
+            h = (h ^ word) * 0xC2B2AE3D27D4EB4FULL;
+            h ^= h >> 29;
+        }
+        if (i < Capacity) {
+            uint64_t word = 0;
+            std::memcpy(&word, data_ + i, Capacity - i);
+            h = (h ^ word) * 0xC2B2AE3D27D4EB4FULL;
+        }
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ULL;
+        h ^= h >> 32;
+        return h;
+    }
+
+    friend bool operator==(const FixedString& lhs, const FixedString& rhs) {
+        return std::memcmp(lhs.data_, rhs.data_, Capacity) == 0;
+    }
+    friend bool operator!=(const FixedString& lhs, const FixedString& rhs) { return !(lhs == rhs); }
+
+private:
+    char data_[Capacity]{};
+};
+
+struct FixedStringHash {
+    template<std::size_t Capacity>
+    std::size_t operator()(const FixedString<Capacity>& text) const {
+        return static_cast<std::size_t>(text.hash());
+    }
+};
+
+#endif // FIXED_STRING_HPP
@@ -0,0 +1,106 @@
+// include/HandlerAllocator.hpp
+#ifndef HANDLER_ALLOCATOR_HPP
+#define HANDLER_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Memory for the state of one asio operation at a time. asio frees an
+// operation's state before calling its completion handler, so a chain of
+// operations where each handler starts the next (a connection's reads, its
+// writes) keeps reusing the same block and never reaches the heap. A
+// request that does not fit, or arrives while the block is taken, falls
+// back to operator new.
+class HandlerMemory {
+public:
+    static constexpr std::size_t kSize = 1024;
+
+    HandlerMemory() = default;
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    void* allocate(std::size_t size) {
+        if (!inUse_ && size <= kSize) {
+            inUse_ = true;
+            return &storage_;
+        }
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer) {
+        if (pointer == &storage_) {
+            inUse_ = false;
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[kSize];
+    bool inUse_{false};
+};
+
+// Standard allocator over a HandlerMemory, for asio to find as a handler's
+// associated allocator
+template<typename T>
+class HandlerAllocator {
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory) : memory_(&memory) {}
+
+    template<typename U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept : memory_(other.memory_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+    }
+
+    void deallocate(T* pointer, std::size_t /*n*/) {
+        memory_->deallocate(pointer);
+    }
+
+    friend bool operator==(const HandlerAllocator& lhs, const HandlerAllocator& rhs) noexcept {
+        return lhs.memory_ == rhs.memory_;
+    }
+    friend bool operator!=(const HandlerAllocator& lhs, const HandlerAllocator& rhs) noexcept {
+        return lhs.memory_ != rhs.memory_;
+    }
+
+private:
+    template<typename> friend class HandlerAllocator;
+
+    HandlerMemory* memory_;
+};
+
+// Completion handler that tells asio to allocate its operation from a
+// HandlerMemory
+template<typename Handler>
+class AllocatingHandler {
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+
+    AllocatingHandler(HandlerMemory& memory, Handler handler)
+        : memory_(memory)
+        , handler_(std::move(handler)) {}
+
+    allocator_type get_allocator() const noexcept { return allocator_type(memory_); }
+
+    template<typename... Args>
+    void operator()(Args&&... args) {
+        handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory& memory_;
+    Handler handler_;
+};
+
+template<typename Handler>
+AllocatingHandler<std::decay_t<Handler>> allocatingHandler(HandlerMemory& memory, Handler&& handler) {
+    return AllocatingHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
+
+#endif // HANDLER_ALLOCATOR_HPP
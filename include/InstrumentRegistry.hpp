@@ -0,0 +1,96 @@
+// include/InstrumentRegistry.hpp
+#ifndef INSTRUMENT_REGISTRY_HPP
+#define INSTRUMENT_REGISTRY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "FixedPoint.hpp"
+#include "FixedString.hpp"
+
+using SymbolCode = FixedString<16>;
+
+// Dense instrument id: 0, 1, 2, ... in order of first sight, so per-symbol
+// state can live in plain arrays indexed by id
+using InstrumentId = uint32_t;
+constexpr InstrumentId kUnknownInstrument = UINT32_MAX;
+
+// Dense id of a trading account (FIX tag 1), interned by RiskChecker
+using AccountId = uint32_t;
+// The account as text, for records that must outlive the process's ids
+using AccountCode = FixedString<16>;
+
+// Reference data for one instrument. Price fields are zero when unknown
+// (for symbols interned on first sight rather than preloaded).
+struct Instrument {
+    SymbolCode symbol;
+    Price tickSize;
+    Price minPrice;
+    Price maxPrice;
+
+    bool hasPriceBand() const { return !tickSize.isZero() && maxPrice > minPrice; }
+};
+
+// Interns symbols (FIX tag 55) into dense InstrumentIds.
+//
+// Capacity is fixed at construction, so records never move: find(), symbol()
+// and instrument() are lock-free and safe to call concurrently with intern(),
+// which serialises writers on a mutex. A record is fully written before its
+// id is published to the hash slots with release ordering.
+class InstrumentRegistry {
+public:
+    static constexpr std::size_t kDefaultCapacity = 4096;
+
+    explicit InstrumentRegistry(std::size_t capacity = kDefaultCapacity);
+
+    // kUnknownInstrument if the symbol has never been interned
+    InstrumentId find(std::string_view symbol) const;
+
+    // Existing id for the symbol, or the next free one. Throws
+    // std::length_error if the symbol is too long or the registry is full.
+    InstrumentId intern(std::string_view symbol);
+
+    // Instrument of a symbol a client sent. Once reference data is loaded,
+    // only its instruments trade and anything else throws
+    // std::invalid_argument rather than taking a slot for good; until then,
+    // symbols are interned on first sight.
+    InstrumentId resolve(std::string_view symbol);
+
+    // Registers an instrument with reference data; throws
+    // std::invalid_argument if the symbol is already known
+    InstrumentId add(const Instrument& instrument);
+
+    // Preloads reference data, one "symbol[,tickSize,minPrice,maxPrice]" per
+    // line; blank lines and lines starting with '#' are skipped. Returns the
+    // number of instruments added.
+    std::size_t loadReferenceData(std::istream& input);
+    std::size_t loadReferenceData(const std::string& path);
+    bool hasReferenceData() const { return referenceData_.load(std::memory_order_acquire); }
+
+    // `id` must have been returned by this registry
+    const Instrument& instrument(InstrumentId id) const { return instruments_[id]; }
+    std::string_view symbol(InstrumentId id) const { return instruments_[id].symbol.view(); }
+
+    std::size_t size() const { return count_.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    InstrumentId insertLocked(const Instrument& instrument, uint64_t hash);
+    std::size_t probe(const SymbolCode& symbol, uint64_t hash, InstrumentId& id) const;
+
+    std::size_t capacity_;
+    std::unique_ptr<Instrument[]> instruments_;
+    // Open-addressing table of id + 1 (0 = empty), at most half full
+    std::unique_ptr<std::atomic<uint32_t>[]> slots_;
+    std::size_t slotMask_;
+    std::atomic<uint32_t> count_{0};
+    std::atomic<bool> referenceData_{false};
+    std::mutex writeMutex_;
+};
+
+#endif // INSTRUMENT_REGISTRY_HPP
@@ -2,6 +2,7 @@
 #ifndef HIGH_PERFORMANCE_TRADING_GATEWAY_LOGGER_HPP
 #define HIGH_PERFORMANCE_TRADING_GATEWAY_LOGGER_HPP
 
+#include <atomic>
 #include <string>
 #include <mutex>
 
@@ -17,8 +18,14 @@ public:
 
     void log(Level level, const std::string& message);
 
+    // Messages below the level are dropped; everything is logged by default
+    void setLevel(Level level) { level_.store(level, std::memory_order_relaxed); }
+    // Lets hot paths skip building a message that would be dropped
+    bool enabled(Level level) const { return level >= level_.load(std::memory_order_relaxed); }
+
 private:
     std::mutex mutex_;
+    std::atomic<Level> level_{Level::DEBUG};
     static std::string levelToString(Level level);
 };
 
@@ -1,14 +1,43 @@
 #ifndef MARKET_DATA_PROCESSOR_HPP
 #define MARKET_DATA_PROCESSOR_HPP
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "FixedPoint.hpp"
+#include "InstrumentRegistry.hpp"
+
+// One price update for an interned instrument
+struct MarketDataUpdate {
+    InstrumentId instrument{kUnknownInstrument};
+    Price price;
+};
 
 class MarketDataProcessor {
 public:
+    // Symbols are interned in `instruments`, or in a registry of its own if none is shared
+    explicit MarketDataProcessor(std::shared_ptr<InstrumentRegistry> instruments = nullptr);
+
     // Method to process raw market data
     std::vector<std::string> process(const std::string& rawMarketData);
+
+    // Parses "SYMBOL,price,SYMBOL,price,..." into updates keyed by instrument
+    // id and records each instrument's last price. Once reference data is
+    // loaded, updates for other symbols are skipped. Returns the number of
+    // updates appended; throws std::invalid_argument on a malformed feed.
+    std::size_t processUpdates(std::string_view rawMarketData, std::vector<MarketDataUpdate>& updates);
+
+    // Last price seen for the instrument; zero if none
+    Price lastPrice(InstrumentId instrument) const {
+        return instrument < lastPrices_.size() ? lastPrices_[instrument] : Price();
+    }
+
+    InstrumentRegistry& instruments() const { return *instruments_; }
+
+private:
+    std::shared_ptr<InstrumentRegistry> instruments_;
+    std::vector<Price> lastPrices_;  // Indexed by InstrumentId
 };
 
 #endif // MARKET_DATA_PROCESSOR_HPP
-
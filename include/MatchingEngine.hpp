@@ -0,0 +1,108 @@
+// include/MatchingEngine.hpp
+#ifndef MATCHING_ENGINE_HPP
+#define MATCHING_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "FixEncoder.hpp"
+#include "FixSchema.hpp"
+#include "InstrumentRegistry.hpp"
+#include "ObjectPool.hpp"
+#include "Order.hpp"
+#include "OrderBook.hpp"
+#include "OrderIndex.hpp"
+
+// Data for one execution report. Identifiers are held inline so a report
+// stays valid after the order it describes has left the book.
+struct Execution {
+    ClOrdId clOrdId;
+    ClOrdId origClOrdId;  // Set on cancel and replace reports
+    InstrumentId instrument{kUnknownInstrument};
+    AccountId account{0};
+    uint32_t session{0};  // Of the order, so the report can go to whoever sent it
+    uint64_t orderId{0};
+    uint64_t execId{0};
+    char execType{0};   // fix::status
+    char ordStatus{0};  // fix::status
+    char side{0};
+    Price price;
+    Qty orderQty;
+    Qty lastQty;
+    Price lastPx;
+    Qty leavesQty;
+    Qty cumQty;
+};
+
+// Encodes an ExecutionReport (35=8) for the execution into the encoder's buffer
+std::string_view encodeExecutionReport(const Execution& execution, const InstrumentRegistry& instruments,
+                                       FixEncoder& encoder);
+
+// Internal crossing engine: one price-time priority OrderBook per symbol over
+// a shared pool of Order records, indexed by ClOrdID.
+//
+// Each call appends the execution reports it produces to `reports`: a New (or
+// Replaced/Canceled) report for the incoming request, then a report for each
+// side of every fill in the order the fills happened. Limit orders rest any
+// unfilled quantity; market orders cancel it.
+//
+// Not thread-safe: calls must be serialised by the caller. Malformed requests
+// (unknown symbol, off-tick price, zero quantity) throw std::invalid_argument;
+// unknown or duplicate ClOrdIDs throw std::runtime_error, as in OrderManager.
+class MatchingEngine {
+public:
+    // Books are indexed by the InstrumentIds of `instruments`, or of a
+    // registry of its own if none is shared
+    explicit MatchingEngine(std::size_t expectedOrders = 65536,
+                            std::shared_ptr<InstrumentRegistry> instruments = nullptr);
+
+    // Opens a book for the symbol; throws if one already exists
+    void addSymbol(std::string_view symbol, const BookConfig& config);
+    // Opens a book for every registered instrument whose reference data has a
+    // price band and tick size; returns the number opened
+    std::size_t addBooksFromReferenceData();
+    bool hasSymbol(std::string_view symbol) const;
+
+    // `account` is carried on the order and its reports for risk accounting,
+    // and `session` so the reports can be routed back to the sender
+    void submit(const fix::NewOrderSingle& order, std::vector<Execution>& reports, AccountId account = 0,
+                uint32_t session = 0);
+    void cancel(const fix::OrderCancelRequest& cancel, std::vector<Execution>& reports);
+    // Keeps time priority when only the quantity is reduced; any other change
+    // requeues the order, and a new price may cross the book
+    void replace(const fix::OrderCancelReplaceRequest& replace, std::vector<Execution>& reports);
+
+    // Resting order, or nullptr; valid until the order fills or is cancelled
+    const Order* findOrder(std::string_view clOrdId) const;
+    const OrderBook* book(std::string_view symbol) const;
+    const OrderBook* book(InstrumentId instrument) const {
+        return instrument < books_.size() ? books_[instrument].get() : nullptr;
+    }
+    std::size_t restingOrders() const { return index_.size(); }
+
+    const InstrumentRegistry& instruments() const { return *instruments_; }
+
+private:
+    void openBook(InstrumentId instrument, const BookConfig& config);
+    // `symbol` is only used in the error for an instrument without a book
+    OrderBook& bookFor(InstrumentId instrument, std::string_view symbol);
+    uint32_t slotFor(std::string_view clOrdId) const;
+    // Crosses the order in `slot` against the opposite side of the book
+    void match(OrderBook& book, uint32_t slot, std::vector<Execution>& reports);
+    // Rests what is left of a limit order, or cancels a market order's remainder
+    void restOrCancel(OrderBook& book, uint32_t slot, std::vector<Execution>& reports);
+    void releaseOrder(uint32_t slot);
+    void report(const Order& order, char execType, std::vector<Execution>& reports,
+                Qty lastQty = Qty(), Price lastPx = Price());
+
+    ObjectPool<Order> orders_;
+    OrderIndex index_;
+    std::shared_ptr<InstrumentRegistry> instruments_;
+    std::vector<std::unique_ptr<OrderBook>> books_;  // Indexed by InstrumentId
+    uint64_t nextOrderId_{1};
+    uint64_t nextExecId_{1};
+};
+
+#endif // MATCHING_ENGINE_HPP
@@ -0,0 +1,70 @@
+// include/MessagePool.hpp
+#ifndef MESSAGE_POOL_HPP
+#define MESSAGE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include "MpmcQueue.hpp"
+
+// Fixed set of preallocated messages lent out by 32-bit handle, so a decoded
+// message can be queued as a handle and read in place by whichever thread
+// takes it. Any thread may acquire or release; the free handles live in an
+// MpmcQueue, so neither side takes a lock. acquire() waits while every
+// message is out, which bounds how far producers can run ahead of consumers.
+template<typename T>
+class MessagePool {
+public:
+    using Handle = uint32_t;
+
+    explicit MessagePool(std::size_t capacity)
+        : capacity_(capacity)
+        , messages_(std::make_unique<T[]>(capacity))
+        , free_(capacity) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            free_.try_push(static_cast<Handle>(i));
+        }
+    }
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+
+    std::optional<Handle> tryAcquire() {
+        return free_.try_pop();
+    }
+
+    Handle acquire() {
+        for (int spins = 0;; ++spins) {
+            if (auto handle = free_.try_pop()) {
+                return *handle;
+            }
+            if (spins < kSpinLimit) {
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // The message keeps its contents until it is next acquired
+    void release(Handle handle) {
+        free_.try_push(handle);
+    }
+
+    T& operator[](Handle handle) { return messages_[handle]; }
+    const T& operator[](Handle handle) const { return messages_[handle]; }
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t available() const { return free_.size(); }
+
+private:
+    static constexpr int kSpinLimit = 256;
+
+    const std::size_t capacity_;
+    std::unique_ptr<T[]> messages_;
+    MpmcQueue<Handle> free_;
+};
+
+#endif // MESSAGE_POOL_HPP
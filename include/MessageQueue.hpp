@@ -4,56 +4,71 @@
 
 #include <queue>
 #include <mutex>
-#include <condition_variable>
+#include <atomic>
 #include <optional>
 #include <memory>
 #include <chrono>
+#include "WaitStrategy.hpp"
 
+// Unbounded locked queue. Idle consumers wait with the given strategy and
+// only look at an atomic count while they spin, so the lock is taken once
+// there is something to take.
 template<typename T>
 class MessageQueue {
 public:
+    explicit MessageQueue(WaitStrategy wait = WaitStrategy::BLOCKING) : waiter_(wait) {}
+
     void push(T value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(std::move(value));
-        cv_.notify_one();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push(std::move(value));
+            size_.store(queue_.size(), std::memory_order_release);
+        }
+        waiter_.notify();
     }
 
+    // Returns nothing on timeout or once stopped
     std::optional<T> pop(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(100)) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        if (!cv_.wait_for(lock, timeout, [this] { return !queue_.empty() || stopped_; })) {
-            return std::nullopt;  // Timeout occurred
-        }
-        
-        if (queue_.empty() || stopped_) {
-            return std::nullopt;
-        }
-        
-        T value = std::move(queue_.front());
-        queue_.pop();
+        std::optional<T> value;
+        waiter_.waitUntil([&] { return stopped_.load(std::memory_order_acquire) || tryPop(value); },
+                          Waiter::Clock::now() + timeout);
         return value;
     }
 
     void stop() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        stopped_ = true;
-        cv_.notify_all();
+        stopped_.store(true, std::memory_order_release);
+        waiter_.notifyAll();
     }
 
     bool empty() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.empty();
+        return size() == 0;
     }
 
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return queue_.size();
+        return size_.load(std::memory_order_acquire);
     }
 
 private:
-    mutable std::mutex mutex_;
-    std::condition_variable cv_;
+    bool tryPop(std::optional<T>& value) {
+        if (size_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Another consumer may have taken it meanwhile
+        if (queue_.empty()) {
+            return false;
+        }
+        value.emplace(std::move(queue_.front()));
+        queue_.pop();
+        size_.store(queue_.size(), std::memory_order_release);
+        return true;
+    }
+
+    std::mutex mutex_;
     std::queue<T> queue_;
-    bool stopped_ = false;
+    std::atomic<size_t> size_{0};
+    std::atomic<bool> stopped_{false};
+    Waiter waiter_;
 };
 
 #endif
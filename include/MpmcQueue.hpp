@@ -0,0 +1,223 @@
+// include/MpmcQueue.hpp
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "WaitStrategy.hpp"
+
+// Bounded lock-free multi-producer/multi-consumer queue with MessageQueue's
+// push/pop/stop surface. Every slot carries a sequence number saying whose
+// turn it is: a producer may fill slot p when its sequence is p, a consumer
+// may empty it when it is p + 1, and emptying hands it to the producer one
+// lap later (p + capacity). Producers and consumers each claim positions with
+// a CAS on their own index, so neither side ever takes a lock, and the slots
+// are allocated once up front instead of one heap node per message.
+//
+// Capacity is rounded up to a power of two. push() waits while the queue is
+// full, which pushes back on producers instead of growing without bound;
+// consumers wait for items with the queue's WaitStrategy.
+template<typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(std::size_t capacity = 65536, WaitStrategy wait = WaitStrategy::SPIN_YIELD)
+        : capacity_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<Slot[]>(capacity_))
+        , waiter_(wait) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue() {
+        while (try_pop()) {
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // The value is moved from only when it is pushed, so a failed attempt
+    // leaves it for the next one
+    bool try_push(T&& value) {
+        return tryEmplace(std::move(value));
+    }
+
+    bool try_push(const T& value) {
+        return tryEmplace(value);
+    }
+
+    // Waits while the queue is full. Dropped if stopped.
+    void push(T value) {
+        for (int spins = 0; !try_push(std::move(value)); ++spins) {
+            if (stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            backoff(spins);
+        }
+    }
+
+    std::optional<T> try_pop() {
+        std::size_t position = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+            if (lag == 0) {
+                if (dequeuePos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    std::optional<T> value(std::move(*slot.get()));
+                    release(slot, position);
+                    return value;
+                }
+            } else if (lag < 0) {
+                return std::nullopt;  // Not yet filled: empty
+            } else {
+                position = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Like MessageQueue::pop, returns nothing on timeout or once stopped
+    std::optional<T> pop(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(100)) {
+        std::optional<T> value;
+        waiter_.waitUntil([&] {
+            if (stopped_.load(std::memory_order_acquire)) {
+                return true;
+            }
+            value = try_pop();
+            return value.has_value();
+        }, std::chrono::steady_clock::now() + timeout);
+        return value;
+    }
+
+    // Claims up to maxItems consecutive filled slots with one CAS, moves
+    // them into `out` and returns how many it took
+    template<typename OutputIt>
+    std::size_t pop_n(OutputIt out, std::size_t maxItems) {
+        std::size_t position = dequeuePos_.load(std::memory_order_relaxed);
+        std::size_t count = 0;
+        for (;;) {
+            count = 0;
+            while (count < maxItems &&
+                   slots_[(position + count) & mask_].sequence.load(std::memory_order_acquire) ==
+                       position + count + 1) {
+                ++count;
+            }
+            if (count == 0) {
+                return 0;
+            }
+            // Slots past the old position are only ever emptied by whoever
+            // moves dequeuePos_ over them, so a successful CAS owns all of them
+            if (dequeuePos_.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            Slot& slot = slots_[(position + i) & mask_];
+            *out++ = std::move(*slot.get());
+            release(slot, position + i);
+        }
+        return count;
+    }
+
+    // Like pop, but drains up to maxItems once anything is available
+    template<typename OutputIt>
+    std::size_t pop_n(OutputIt out, std::size_t maxItems, const std::chrono::milliseconds& timeout) {
+        std::size_t count = 0;
+        waiter_.waitUntil([&] {
+            if (stopped_.load(std::memory_order_acquire)) {
+                return true;
+            }
+            count = pop_n(out, maxItems);
+            return count > 0;
+        }, std::chrono::steady_clock::now() + timeout);
+        return count;
+    }
+
+    void stop() {
+        stopped_.store(true, std::memory_order_release);
+        waiter_.notifyAll();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Approximate while producers or consumers are active
+    std::size_t size() const {
+        std::size_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+        std::size_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    template<typename U>
+    bool tryEmplace(U&& value) {
+        std::size_t position = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0) {
+                if (enqueuePos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    new (slot.storage) T(std::forward<U>(value));
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    waiter_.notify();
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;  // Slot still holds last lap's item: full
+            } else {
+                position = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static constexpr int kSpinLimit = 256;
+
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    void release(Slot& slot, std::size_t position) {
+        slot.get()->~T();
+        slot.sequence.store(position + capacity_, std::memory_order_release);
+    }
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Producers waiting for space spin, then yield
+    static void backoff(int spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePos_{0};
+    alignas(64) std::atomic<bool> stopped_{false};
+    Waiter waiter_;
+};
+
+#endif // MPMC_QUEUE_HPP
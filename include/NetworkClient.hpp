@@ -3,14 +3,39 @@
 #define NETWORK_CLIENT_HPP
 
 #include <boost/asio.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <future>
 #include <memory>
+#include <thread>
 #include "NetworkTypes.hpp"
 #include "Logger.hpp"
 
+// With config.pipeline_window set, the client pipelines: requests go out
+// without waiting for earlier responses, up to the window, and one I/O
+// thread owns the socket, coalescing queued requests into each write and
+// completing them as responses arrive. A response is matched to its request
+// by ClOrdID (echoed as OrderID in ACKs and NAKs, tag 11 in FIX execution
+// reports); a NAK without it answers the oldest request in flight, since the
+// server answers each connection in order. Reports naming no request in
+// flight, such as fills of resting orders when the server matches
+// internally, go to the unsolicited report handler.
+//
+// With config.encoding BINARY, connect() logs on for binary messages and
+// every request is sent in the fixed layout of BinaryProtocol.hpp. Callers
+// still give requests as FIX text and get responses as text ACKs and NAKs,
+// so the two encodings are interchangeable above the socket.
 class NetworkClient {
 public:
+    // Called on the I/O thread with whether the server ACKed the request and
+    // its response, or the error that lost the connection
+    using ResponseHandler = std::function<void(bool accepted, const std::string& response)>;
+    // Called with a report the server sent unprompted, rendered as text
+    using ReportHandler = std::function<void(const std::string& report)>;
+
     explicit NetworkClient(const network::ClientConfig& config,
                          std::shared_ptr<Logger> logger);
     ~NetworkClient();
@@ -19,11 +44,28 @@ public:
     NetworkClient(const NetworkClient&) = delete;
     NetworkClient& operator=(const NetworkClient&) = delete;
 
-    // Asynchronously send a message
+    // Asynchronously send a message; pipelined if configured, otherwise on a
+    // thread of its own
     std::future<bool> sendAsync(const network::Message& message);
     
     // Synchronously send a message
     bool send(const network::Message& message);
+
+    // Pipelined send: queues the request, waiting only while the window is
+    // full, and calls onResponse once it is answered. Returns false, without
+    // calling it, if the request could not be queued.
+    bool sendPipelined(const network::Message& message, ResponseHandler onResponse);
+
+    // Waits until every pipelined request has been answered or failed
+    void flush();
+
+    // Receives reports for orders with no request in flight, on the thread
+    // that read them; without one they are logged and dropped. Set it before
+    // connect().
+    void setUnsolicitedReportHandler(ReportHandler onReport);
+
+    // Pipelined requests not answered yet
+    size_t inFlight() const;
     
     // Send a file containing messages
     bool sendFile(const std::string& filepath, network::Message::Type type);
@@ -41,17 +83,52 @@ public:
     std::string getLastError() const;
 
 private:
+    struct PendingRequest {
+        std::string clOrdId;
+        ResponseHandler onResponse;
+    };
+
     bool sendInternal(const network::Message& message);
+    // Sends the Logon asking for binary messages and waits for its ACK
+    bool logOnBinary();
+    // Appends the request in the connection's encoding
+    void encodeRequest(const network::Message& message, std::string& out) const;
+    // Reads one response, rendered as text
+    bool readResponse(std::string& response, boost::system::error_code& error);
     void handleError(const std::string& error_msg);
     bool reconnect();
 
+    // I/O thread side of the pipelined mode
+    void startReading();
+    void startWriting();
+    void completeRequest(std::string_view response);
+    void unsolicitedReport(const std::string& report);
+    // Answers every complete binary report in read_buffer_
+    void completeBinaryRequests();
+    // Fails every request in flight, e.g. once the connection is lost;
+    // `unexpected` is false when disconnect() closed it
+    void failInFlight(const std::string& error, bool unexpected);
+
     boost::asio::io_context io_context_;
     std::unique_ptr<boost::asio::ip::tcp::socket> socket_;
     std::shared_ptr<Logger> logger_;
     network::ClientConfig config_;
     std::string last_error_;
+    ReportHandler on_unsolicited_report_;
     std::atomic<bool> connected_{false};
     mutable std::mutex error_mutex_;
+
+    // Pipelined mode
+    std::thread io_thread_;
+    std::unique_ptr<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> io_work_;
+    boost::asio::streambuf read_buffer_;       // I/O thread only
+    std::string writing_;                      // I/O thread only: the write in progress
+    mutable std::mutex pipeline_mutex_;        // Guards the members below
+    std::condition_variable window_open_;
+    std::deque<PendingRequest> in_flight_;     // In send order
+    std::string outbound_;                     // Requests queued behind the write in progress
+    bool write_scheduled_{false};
+    size_t answering_{0};                      // Completions taken off in_flight_ still running
 };
 
 #endif
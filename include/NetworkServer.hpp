@@ -3,21 +3,58 @@
 #define NETWORK_SERVER_HPP
 
 #include <boost/asio.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
 #include <memory>
 #include <atomic>
+#include <unordered_map>
 #include <vector>
 #include <thread>
+#include "HandlerAllocator.hpp"
+#include "MessagePool.hpp"
 #include "MessageQueue.hpp"
+#include "MpmcQueue.hpp"
 #include "NetworkTypes.hpp"
 #include "OrderManager.hpp"
+#include "MatchingEngine.hpp"
+#include "MarketDataProcessor.hpp"
+#include "RiskChecker.hpp"
+#include "OrderJournal.hpp"
+#include "OrderSequencer.hpp"
+#include "OrderPipeline.hpp"
+#include "OutboundQueue.hpp"
+#include "ReceiveBuffer.hpp"
 #include "FixMessageHandler.hpp"
 #include "Logger.hpp"
 
 class NetworkServer {
 public:
+    // With a matching engine, orders are crossed internally and the response
+    // reports the order's status after matching instead of ACCEPTED. The
+    // engine's books are then the order state: requests are not applied to
+    // the OrderManager, and reports for resting orders (fills by a later
+    // order) are sent to the connection the resting order came in on. With a
+    // risk checker, orders failing pre-trade checks are NAKed before they
+    // reach the engine or the order queue. With a journal, every accepted
+    // request is journaled before it is applied (with the engine, once the
+    // book has accepted it, so rejected requests never reach the journal),
+    // and if config.ack_after_durable is set its ACK waits for the group
+    // commit. The journal needs a single order of application to record, so
+    // the worker pool only takes one alongside the engine.
+    // With config.single_writer_sequencer, decoded requests go to an
+    // OrderSequencer, which journals and applies them in arrival order,
+    // instead of being re-parsed by the worker pool. With
+    // config.bounded_ingress_queue, the worker pool is fed through a bounded
+    // lock-free MpmcQueue in batches. With config.order_pipeline, requests
+    // go through an OrderPipeline and are answered from its encode stage.
+    // With config.io_threads above one, connections are spread over that
+    // many io threads; everything they share below the socket is thread-safe.
     explicit NetworkServer(const network::ServerConfig& config, 
                          std::shared_ptr<OrderManager> orderManager,
-                         std::shared_ptr<Logger> logger);
+                         std::shared_ptr<Logger> logger,
+                         std::shared_ptr<MatchingEngine> matchingEngine = nullptr,
+                         std::shared_ptr<RiskChecker> riskChecker = nullptr,
+                         std::shared_ptr<OrderJournal> journal = nullptr);
     ~NetworkServer();
 
     // Prevent copying and assignment
@@ -29,36 +66,169 @@ public:
     
     // Stop the server gracefully
     void stop();
+
+    // Port the server listens on, e.g. when config.port is 0
+    uint16_t port() const;
+
+    // Applies a market data message of "SYMBOL,price,..." pairs, as MARKET_DATA
+    // messages on the worker queue are: records each last price and hands it
+    // to the risk checker as the last trade. Thread-safe.
+    void processMarketData(std::string_view rawMarketData);
+    // Last price the market data gave for the instrument; zero if none
+    Price lastPrice(InstrumentId instrument) const;
     
     // Get current statistics
     struct Statistics {
         size_t active_connections{0};
         size_t messages_processed{0};
+        size_t socket_reads{0};             // Completed reads across all connections
+        size_t socket_writes{0};            // Completed writes, each of every response queued before it
         size_t errors_encountered{0};
         std::chrono::milliseconds average_processing_time{0};
     };
     Statistics getStatistics() const;
 
 private:
-    void startAccept();
-    void handleClient(std::shared_ptr<boost::asio::ip::tcp::socket> socket);
+    // An io thread beyond the first: its io_context, the thread running it
+    // and, with SO_REUSEPORT, a listener of its own
+    struct IoThread {
+        boost::asio::io_context context{1};
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{context.get_executor()};
+        std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+        HandlerMemory acceptMemory;
+        std::thread thread;
+    };
+
+    void listen(boost::asio::ip::tcp::acceptor& acceptor, uint16_t port, bool reusePort);
+    // Accepts onto `home`, or onto every io thread in turn if this is the
+    // only listener among several io threads
+    void startAccept(boost::asio::ip::tcp::acceptor& acceptor, boost::asio::io_context& home,
+                     HandlerMemory& memory);
+    void runIoContext(boost::asio::io_context& context);
+    // One client connection, used only on the io thread that accepted it.
+    // Its pending read and write each keep it alive through an intrusive
+    // reference and allocate their asio operation from its handler memory,
+    // so a connection costs nothing on the heap once it is established.
+    // Also the pipeline's context for its requests, so publishing one takes
+    // a reference on the connection without allocating
+    struct Connection : PipelineContext {
+        Connection(boost::asio::ip::tcp::socket peer, size_t receiveBufferSize)
+            : socket(std::move(peer))
+            , received(receiveBufferSize) {
+            response.reserve(256);
+        }
+
+        boost::asio::ip::tcp::socket socket;
+        ReceiveBuffer received;
+        OutboundQueue outbound;
+        std::string response;            // Reused to build each text response
+        network::Encoding encoding{network::Encoding::TEXT};
+        uint32_t session{0};             // With the engine, routes reports of its resting orders
+        HandlerMemory readMemory;
+        HandlerMemory writeMemory;
+        // Pipeline responses, appended on the encode thread until the io
+        // thread swaps them out; one hand-off to the io thread is pending
+        // while `answered` is not empty
+        std::mutex answeredMutex;
+        std::string answered;
+        std::string answeredTaken;       // The io thread's side of the swap
+        HandlerMemory answeredMemory;
+    };
+    using ConnectionPtr = boost::intrusive_ptr<Connection>;
+
+    // Reads what the client has sent and handles every complete message in it
+    void handleClient(ConnectionPtr connection);
     void processMessages();
+    void processMessage(const network::Message& message);
     void handleError(const std::string& error_msg);
     
-    // New methods for handling responses
-    void sendResponse(std::shared_ptr<boost::asio::ip::tcp::socket> socket, 
-                     const std::string& response);
-    std::string processMessageAndGetResponse(const std::string& data);
+    // Queues a response and starts a write unless one is in progress
+    void sendResponse(const ConnectionPtr& connection, std::string_view response);
+    // Writes everything queued for the connection, if no write is in progress
+    void startWrite(const ConnectionPtr& connection);
+    // Pipeline mode: a Logon is handled on the io thread, since it decides
+    // how the rest of the read is framed, and its answer is passed through
+    // the pipeline to go out behind the responses owed before it
+    void logonThroughPipeline(std::string_view data, const ConnectionPtr& connection);
+    // On the encode thread: queues the pipeline's response for the
+    // connection's io thread
+    void answerFromPipeline(const PipelineEvent& event);
+    // On the io thread: queues the pipeline responses handed over since the
+    // last call and writes them
+    void takePipelineResponses(const ConnectionPtr& connection);
+    // Queues the ACK or NAK for a text request; a Logon may switch the
+    // connection to binary
+    void processMessageAndGetResponse(std::string_view data, Connection& connection);
+    // Queues the ExecutionReport for a binary request, read in place
+    void processBinaryMessage(std::string_view data, Connection& connection);
+    void logon(const fix::Logon& logon, Connection& connection);
+    // Check a decoded request, journal it and run it through the engine, if
+    // any, then hand it on to be applied. They return the OrdStatus to report
+    // and throw if the request is rejected.
+    char handleNewOrder(const fix::NewOrderSingle& order, Qty& filledQty, uint32_t session);
+    void handleCancel(const fix::OrderCancelRequest& cancel);
+    char handleReplace(const fix::OrderCancelReplaceRequest& replace, Qty& filledQty);
+    // A request decoded on the io thread, as a worker applies it
+    struct DecodedRequest {
+        JournalRecord record;
+        AccountId account{0};
+        int64_t exposureDelta{0};  // Reserved by a MODIFY's risk check
+    };
+    // Hands a record to the sequencer or the worker pool
+    void submit(const JournalRecord& record, AccountId account, uint64_t journalSequence,
+                int64_t exposureDelta = 0);
+    // Applies a request on a worker and, without the engine, settles the
+    // exposure its risk check reserved against what the apply changed
+    bool applyDecoded(const DecodedRequest& request);
+    // Feeds the engine's reports in executions_ to the risk checker
+    void recordExecutions();
+    // Posts the engine's reports in executions_ for orders other than the
+    // request's own (answered by its ACK) to the sessions that own them
+    void routeExecutions(std::string_view clOrdId);
+    // Writes an engine report to its owner, on the connection's io thread
+    void sendExecution(const ConnectionPtr& connection, const Execution& execution);
+    // Stamps the event for the worker pool and appends it to the journal, if
+    // any; returns its journal sequence or 0
+    uint64_t journalEvent(JournalRecord& record);
+    // Throws if the journal cannot take another event. Engine requests are
+    // journaled only once the book accepts them, so this runs first: the
+    // engine must not take a request that then cannot be journaled.
+    void checkJournalRoom() const;
 
     boost::asio::io_context io_context_;
     boost::asio::ip::tcp::acceptor acceptor_;
+    HandlerMemory accept_memory_;
+    std::vector<std::unique_ptr<IoThread>> io_threads_;
+    bool deal_connections_{false};           // acceptor_ hands connections to every io thread
+    std::atomic<size_t> next_io_thread_{0};
     std::shared_ptr<OrderManager> order_manager_;
     std::shared_ptr<Logger> logger_;
+    std::shared_ptr<MatchingEngine> matching_engine_;
+    std::mutex matching_mutex_;                  // Serialises the engine; guards executions_
+    std::vector<Execution> executions_;          // Reused report buffer
+    std::mutex sessions_mutex_;                  // Guards sessions_ and next_session_
+    std::unordered_map<uint32_t, ConnectionPtr> sessions_;  // Open connections, with the engine
+    uint32_t next_session_{1};
+    std::shared_ptr<RiskChecker> risk_checker_;
+    std::shared_ptr<OrderJournal> journal_;
+    std::mutex journal_mutex_;                   // The journal has a single writer
+    mutable std::mutex market_data_mutex_;       // Guards market_data_ and market_updates_
+    MarketDataProcessor market_data_;
+    std::vector<MarketDataUpdate> market_updates_;  // Reused update buffer
+    std::unique_ptr<OrderSequencer> sequencer_;  // Set while running in sequencer mode
+    std::unique_ptr<OrderPipeline> pipeline_;    // Set while running in pipeline mode
     std::shared_ptr<MessageQueue<network::Message>> message_queue_;
+    std::unique_ptr<MpmcQueue<network::Message>> bounded_queue_;  // Replaces message_queue_ if configured
+    // Requests decoded on the io thread, queued to the workers by handle
+    std::unique_ptr<MessagePool<DecodedRequest>> decoded_messages_;
     std::vector<std::thread> worker_threads_;
     std::atomic<bool> running_{false};
-    mutable std::mutex stats_mutex_;
+    mutable std::mutex stats_mutex_;             // Guards stats_
     Statistics stats_;
+    // Counted on every read, write and message, so kept out of stats_ and its lock
+    std::atomic<size_t> messages_processed_{0};
+    std::atomic<size_t> socket_reads_{0};
+    std::atomic<size_t> socket_writes_{0};
     network::ServerConfig config_;
 };
 
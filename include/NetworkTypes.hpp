@@ -4,8 +4,18 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
+#include "WaitStrategy.hpp"
 
 namespace network {
+    // Wire encoding of a connection's orders and responses: '|'-delimited
+    // FIX text, one message per line, or the fixed-layout binary messages of
+    // BinaryProtocol.hpp, chosen by the client's Logon
+    enum class Encoding {
+        TEXT,
+        BINARY
+    };
+
     struct Message {
         enum class Type {
             FIX,
@@ -13,8 +23,13 @@ namespace network {
             CONTROL
         };
 
+        static constexpr uint32_t kNotDecoded = UINT32_MAX;
+
         Type type;
         std::string payload;
+        // Handle of the already decoded message in the server's pool; the
+        // payload is left empty then
+        uint32_t decoded{kNotDecoded};
         std::chrono::system_clock::time_point timestamp;
         
         Message(Type t, std::string p)
@@ -22,6 +37,12 @@ namespace network {
             , payload(std::move(p))
             , timestamp(std::chrono::system_clock::now())
         {}
+
+        Message(Type t, uint32_t decodedHandle)
+            : type(t)
+            , decoded(decodedHandle)
+            , timestamp(std::chrono::system_clock::now())
+        {}
     };
 
     struct ClientConfig {
@@ -29,13 +50,67 @@ namespace network {
         uint16_t port;
         std::chrono::milliseconds timeout{1000};
         size_t retry_attempts{3};
+        // Requests sent ahead of their responses; 0 sends one at a time and
+        // waits for each response before the next
+        size_t pipeline_window{0};
+        // BINARY logs on for binary messages; requests are still given as
+        // FIX text and responses still come back as text ACKs and NAKs
+        Encoding encoding{Encoding::TEXT};
     };
 
     struct ServerConfig {
         uint16_t port;
         size_t max_connections{1000};
         size_t thread_pool_size{4};
+        // Threads doing network I/O, each running its own io_context; the
+        // thread calling start() is the first. A connection stays on the one
+        // that accepted it, so its reads, ACKs and writes never change thread.
+        size_t io_threads{1};
+        // With several io threads, give each a SO_REUSEPORT listener and let
+        // the kernel spread connections; otherwise one listener deals them out
+        // round-robin
+        bool reuse_port_listeners{true};
+        // Per-connection receive buffer, reused for every read; also the
+        // longest message a client may send
+        size_t receive_buffer_size{64 * 1024};
         std::chrono::milliseconds client_timeout{5000};
+        size_t order_manager_shards{16};    // Independently locked OrderManager shards
+        size_t expected_orders{65536};      // Order records preallocated across the shards
+        bool enable_matching{false};        // Cross orders in the internal MatchingEngine
+        bool enable_risk_checks{true};      // Pre-trade RiskChecker with default limits
+        std::string reference_data_file;    // Instruments to preload, and then the only ones traded; none if empty
+        std::string journal_file;           // Write-ahead order journal; none if empty
+        size_t journal_capacity{1 << 20};   // Events preallocated in each new journal segment
+        size_t journal_group_commit_events{64};
+        std::chrono::microseconds journal_group_commit_interval{200};
+        bool ack_after_durable{false};      // Hold each ACK until its journal event is on disk
+        std::string snapshot_directory;     // Periodic order snapshots for fast restart; none if empty
+        std::chrono::seconds snapshot_interval{60};
+        // Apply orders on one sequencer thread that owns all order state,
+        // instead of the worker pool; needs a single-writer OrderManager
+        bool single_writer_sequencer{false};
+        int sequencer_cpu{-1};              // Core to pin the sequencer to; unpinned if negative
+        size_t sequencer_capacity{65536};   // Ring slots between network threads and the sequencer
+        WaitStrategy sequencer_wait{WaitStrategy::SPIN_YIELD};
+        // Run requests through the staged OrderPipeline (decode, risk, order
+        // state, journal, encode) instead of answering on the io thread; needs
+        // a single-writer OrderManager and no matching engine
+        bool order_pipeline{false};
+        size_t pipeline_capacity{65536};    // Event slots in the pipeline ring
+        // How each of the five stage threads waits; see PipelineConfig
+        WaitStrategy pipeline_decode_wait{WaitStrategy::SPIN_PARK};
+        WaitStrategy pipeline_risk_wait{WaitStrategy::SPIN_PARK};
+        WaitStrategy pipeline_order_state_wait{WaitStrategy::SPIN_PARK};
+        WaitStrategy pipeline_journal_wait{WaitStrategy::SPIN_PARK};
+        WaitStrategy pipeline_encode_wait{WaitStrategy::SPIN_PARK};
+        // Hand messages to the worker pool through a bounded lock-free queue
+        // instead of the unbounded locked one; a full queue blocks the reader
+        bool bounded_ingress_queue{false};
+        size_t ingress_queue_capacity{65536};
+        // How idle workers wait on the ingress queue, bounded or not
+        WaitStrategy ingress_wait{WaitStrategy::BLOCKING};
+        // Decoded requests in flight to the worker pool; the reader waits when all are in use
+        size_t decoded_message_pool{65536};
     };
 }
 
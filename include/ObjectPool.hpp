@@ -0,0 +1,73 @@
+// include/ObjectPool.hpp
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// Slab allocator handing out stable uint32_t slot indices. Slabs are
+// preallocated for the expected capacity and only added (never freed) if that
+// is exceeded, so memory use is predictable and addresses never move.
+template<typename T, std::size_t SlabSize = 4096>
+class ObjectPool {
+    static_assert((SlabSize & (SlabSize - 1)) == 0, "SlabSize must be a power of two");
+
+public:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    explicit ObjectPool(std::size_t initialCapacity = SlabSize) {
+        std::size_t slabs = (initialCapacity + SlabSize - 1) / SlabSize;
+        slabs_.reserve(slabs);
+        freeList_.reserve(slabs * SlabSize);
+        for (std::size_t i = 0; i < slabs; ++i) {
+            addSlab();
+        }
+    }
+
+    // Returns the index of a value-initialised slot
+    uint32_t allocate() {
+        if (freeList_.empty()) {
+            addSlab();
+        }
+        uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        (*this)[index] = T{};
+        return index;
+    }
+
+    void release(uint32_t index) {
+        freeList_.push_back(index);
+    }
+
+    T& operator[](uint32_t index) {
+        return slabs_[index / SlabSize][index & (SlabSize - 1)];
+    }
+
+    const T& operator[](uint32_t index) const {
+        return slabs_[index / SlabSize][index & (SlabSize - 1)];
+    }
+
+    std::size_t capacity() const { return slabs_.size() * SlabSize; }
+    std::size_t size() const { return capacity() - freeList_.size(); }
+
+private:
+    void addSlab() {
+        std::size_t base = capacity();
+        if (base + SlabSize > kInvalidIndex) {
+            throw std::length_error("ObjectPool exhausted");
+        }
+        slabs_.push_back(std::make_unique<T[]>(SlabSize));
+        // Push in reverse so low indices are handed out first
+        for (std::size_t i = SlabSize; i > 0; --i) {
+            freeList_.push_back(static_cast<uint32_t>(base + i - 1));
+        }
+    }
+
+    std::vector<std::unique_ptr<T[]>> slabs_;
+    std::vector<uint32_t> freeList_;
+};
+
+#endif // OBJECT_POOL_HPP
@@ -0,0 +1,47 @@
+// include/Order.hpp
+#ifndef ORDER_HPP
+#define ORDER_HPP
+
+#include <cstdint>
+#include "FixedPoint.hpp"
+#include "FixedString.hpp"
+#include "InstrumentRegistry.hpp"
+
+using ClOrdId = FixedString<24>;
+
+enum class OrderState : uint8_t {
+    NEW,
+    PARTIALLY_FILLED,
+    FILLED,
+    REPLACED,
+    CANCELLED
+};
+
+// Compact order record, two cache lines, stored in OrderManager's slab pool
+struct alignas(64) Order {
+    ClOrdId clOrdId;
+    char side{0};       // FIX 54: '1' = Buy, '2' = Sell
+    char ordType{0};    // FIX 40
+    OrderState state{OrderState::NEW};
+    InstrumentId instrument{kUnknownInstrument};
+    uint64_t orderId{0};  // Gateway-assigned
+    Price price;
+    Qty orderQty;
+    Qty cumQty;
+    int64_t createdNs{0};
+    int64_t updatedNs{0};
+    // Intrusive FIFO links between orders resting at one OrderBook price
+    // level, as pool slot indices
+    uint32_t prevInLevel{UINT32_MAX};
+    uint32_t nextInLevel{UINT32_MAX};
+    uint32_t account{0};  // RiskChecker AccountId, set by MatchingEngine
+    AccountCode accountCode;  // FIX 1 as sent, so a recovered order keeps its account
+    uint32_t session{0};  // Connection the order came in on, set by MatchingEngine
+
+    Qty leavesQty() const { return orderQty - cumQty; }
+    bool isBuy() const { return side == '1'; }
+};
+
+static_assert(sizeof(Order) == 128, "Order should stay two cache lines");
+
+#endif // ORDER_HPP
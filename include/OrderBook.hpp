@@ -0,0 +1,74 @@
+// include/OrderBook.hpp
+#ifndef ORDER_BOOK_HPP
+#define ORDER_BOOK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FixedPoint.hpp"
+#include "ObjectPool.hpp"
+#include "Order.hpp"
+
+// Price band and tick size of one instrument's book. Every level between
+// minPrice and maxPrice is preallocated, so the band should be set to the
+// instrument's realistic trading range.
+struct BookConfig {
+    Price minPrice;
+    Price maxPrice;
+    Price tickSize;
+};
+
+// Price levels of one symbol, held in a contiguous array indexed by tick
+// offset from minPrice. Each level is an intrusive FIFO of Order records that
+// live in the caller's pool, linked by slot index, so time priority is the
+// list order. Matching itself is done by MatchingEngine; the book keeps the
+// levels, their aggregate quantity and the best bid and ask.
+class OrderBook {
+public:
+    static constexpr uint32_t kNoOrder = ObjectPool<Order>::kInvalidIndex;
+    static constexpr std::size_t kNoLevel = SIZE_MAX;
+
+    struct Level {
+        uint32_t head{kNoOrder};
+        uint32_t tail{kNoOrder};
+        uint32_t orders{0};
+        Qty quantity;  // Sum of leaves quantity resting at this price
+
+        bool empty() const { return head == kNoOrder; }
+    };
+
+    OrderBook(const BookConfig& config, ObjectPool<Order>& pool);
+
+    // Level index for price. Throws std::invalid_argument if the price is not
+    // on a tick or falls outside the book's band.
+    std::size_t levelFor(const Price& price) const;
+    Price priceAt(std::size_t level) const {
+        return Price(minMantissa_ + static_cast<int64_t>(level) * tickMantissa_, scale_);
+    }
+
+    // Adds the order in `slot` to the back of its level's queue
+    void append(uint32_t slot, std::size_t level);
+    // Removes the order from its level, wherever it is in the queue
+    void unlink(uint32_t slot, std::size_t level);
+    // Takes a partial fill or quantity reduction off the level's total
+    void reduce(std::size_t level, Qty quantity) { levels_[level].quantity -= quantity; }
+
+    // kNoLevel when that side of the book is empty
+    std::size_t bestBid() const { return bestBid_; }
+    std::size_t bestAsk() const { return bestAsk_; }
+
+    const Level& level(std::size_t index) const { return levels_[index]; }
+    std::size_t levelCount() const { return levels_.size(); }
+    uint8_t scale() const { return scale_; }
+
+private:
+    ObjectPool<Order>& pool_;
+    std::vector<Level> levels_;
+    int64_t minMantissa_;
+    int64_t tickMantissa_;
+    uint8_t scale_;
+    std::size_t bestBid_{kNoLevel};
+    std::size_t bestAsk_{kNoLevel};
+};
+
+#endif // ORDER_BOOK_HPP
@@ -0,0 +1,93 @@
+// include/OrderIndex.hpp
+#ifndef ORDER_INDEX_HPP
+#define ORDER_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include "Order.hpp"
+
+// Flat open-addressing (Robin Hood) map from ClOrdID to pool slot.
+//
+// Entries hold the key inline together with its precomputed hash, so a probe
+// touches one 32-byte entry and compares the hash before the key. Deletion
+// uses backward shifting, so there are no tombstones. Growth is incremental:
+// a larger table is allocated (lazily zeroed by the OS) and old entries are
+// migrated a few clusters at a time on subsequent operations, so no single
+// insert pays for a full rehash.
+class OrderIndex {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+
+    explicit OrderIndex(std::size_t expectedEntries = 16);
+
+    static uint64_t hash(const ClOrdId& key) { return key.hash(); }
+
+    uint32_t find(const ClOrdId& key, uint64_t hash) const;
+    uint32_t find(const ClOrdId& key) const { return find(key, hash(key)); }
+
+    // Returns false (and leaves the map unchanged) if the key is present
+    bool insert(const ClOrdId& key, uint64_t hash, uint32_t value);
+    bool insert(const ClOrdId& key, uint32_t value) { return insert(key, hash(key), value); }
+
+    bool erase(const ClOrdId& key, uint64_t hash);
+    bool erase(const ClOrdId& key) { return erase(key, hash(key)); }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return current_.capacity; }
+    bool migrating() const { return old_.entries != nullptr; }
+
+    // Calls fn(key, value) for every entry, in table order. Entries already
+    // migrated have been cleared from the old table, so none is seen twice.
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Table* table : {&current_, &old_}) {
+            for (std::size_t i = 0; i < table->capacity; ++i) {
+                const Entry& entry = table->entries[i];
+                if (entry.valuePlusOne != 0) {
+                    fn(entry.key, entry.valuePlusOne - 1);
+                }
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        ClOrdId key;
+        uint32_t hash;
+        uint32_t valuePlusOne;  // 0 marks an empty entry, so calloc'd tables start empty
+    };
+    static_assert(sizeof(Entry) == 32, "Index entries should pack two per cache line");
+
+    struct FreeDeleter {
+        void operator()(Entry* entries) const { std::free(entries); }
+    };
+
+    struct Table {
+        std::unique_ptr<Entry[], FreeDeleter> entries;
+        std::size_t capacity{0};
+        std::size_t mask{0};
+        std::size_t size{0};
+
+        void allocate(std::size_t newCapacity);
+        void release();
+        std::size_t distance(std::size_t pos) const {
+            return (pos - (entries[pos].hash & mask)) & mask;
+        }
+        uint32_t find(const ClOrdId& key, uint32_t hash) const;
+        void insert(Entry entry);
+        bool erase(const ClOrdId& key, uint32_t hash);
+    };
+
+    void grow();
+    void migrateStep();
+
+    Table current_;
+    Table old_;
+    std::size_t migrateCursor_{0};
+    std::size_t migrateRemaining_{0};
+    std::size_t size_{0};
+};
+
+#endif // ORDER_INDEX_HPP
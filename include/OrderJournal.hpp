@@ -0,0 +1,184 @@
+// include/OrderJournal.hpp
+#ifndef ORDER_JOURNAL_HPP
+#define ORDER_JOURNAL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FixSchema.hpp"
+#include "Order.hpp"
+
+enum class JournalEventType : uint8_t {
+    NEW_ORDER = 1,
+    MODIFY = 2,
+    CANCEL = 3
+};
+
+// One order event as written to the journal. Fixed size and a divisor of
+// the page size, so a record never straddles pages and a torn write shows
+// up as a checksum mismatch on that record alone.
+struct alignas(64) JournalRecord {
+    uint64_t sequence{0};     // 1-based; 0 marks unused space
+    int64_t timestampNs{0};
+    ClOrdId clOrdId;
+    ClOrdId origClOrdId;      // MODIFY and CANCEL
+    SymbolCode symbol;        // Text rather than InstrumentId, so it survives a restart
+    AccountCode account;      // NEW_ORDER; text for the same reason
+    int64_t priceMantissa{0};
+    int64_t orderQty{0};
+    uint8_t priceScale{0};
+    JournalEventType type{JournalEventType::NEW_ORDER};
+    char side{0};
+    char ordType{0};
+    uint32_t checksum{0};
+
+    static JournalRecord newOrder(const fix::NewOrderSingle& order);
+    static JournalRecord modify(const fix::OrderCancelReplaceRequest& replace);
+    static JournalRecord cancel(const fix::OrderCancelRequest& cancel);
+
+    Price price() const { return Price(priceMantissa, priceScale); }
+    // Checksum of every field except `checksum` itself
+    uint32_t computeChecksum() const;
+};
+
+static_assert(sizeof(JournalRecord) == 128, "Journal records should stay two cache lines");
+
+struct JournalConfig {
+    std::string path;
+    std::size_t capacity{1 << 20};  // Records preallocated in each segment file
+    // Group commit: flush once this many events are pending, or this long
+    // after the first event of a group was appended, whichever comes first
+    std::size_t groupCommitEvents{64};
+    std::chrono::microseconds groupCommitInterval{200};
+    // Without fsync, events reach the page cache only and survive a process
+    // crash but not a machine crash
+    bool fsync{true};
+};
+
+// Write-ahead journal of order events in a preallocated, memory-mapped file.
+//
+// append() is single-writer: it copies the record into the mapping and
+// publishes its sequence number, with no system call. A background thread
+// flushes appended records to disk in groups and advances
+// durableSequence(), so callers that must not ACK before an event is
+// durable wait on waitDurable() without slowing the writer down.
+//
+// The journal is a chain of segment files: `path` and then `path.1`,
+// `path.2`, ... in order. startSegment() prepares the next one off the hot
+// path and the writer moves to it at its next append, so the snapshotter
+// starts one at each snapshot and discardBefore() deletes the segments that
+// every retained snapshot has moved past.
+//
+// Opening an existing journal resumes after its last valid record; replay()
+// reads the records back in order.
+class OrderJournal {
+public:
+    explicit OrderJournal(const JournalConfig& config);
+    ~OrderJournal();
+
+    OrderJournal(const OrderJournal&) = delete;
+    OrderJournal& operator=(const OrderJournal&) = delete;
+
+    // Assigns the next sequence number and returns it. Throws
+    // std::length_error when the current segment is full and no new one has
+    // been started. Single writer only.
+    uint64_t append(JournalRecord record);
+
+    // Creates the next segment file; events appended from now on go to it.
+    // Does nothing if a new segment is already waiting. Any thread.
+    void startSegment();
+    // Deletes the segment files whose events all come before `sequence`,
+    // never the current one; returns how many went
+    std::size_t discardBefore(uint64_t sequence);
+
+    // Blocks until every event up to `sequence` is durable
+    void waitDurable(uint64_t sequence);
+    // Flushes everything appended so far before returning
+    void flush();
+
+    uint64_t lastSequence() const { return written_.load(std::memory_order_acquire); }
+    uint64_t durableSequence() const { return durable_.load(std::memory_order_acquire); }
+    // Oldest event still held; 1 until segments are discarded
+    uint64_t firstSequence() const { return first_.load(std::memory_order_acquire); }
+    // Appends succeed at least up to this sequence
+    uint64_t endSequence() const;
+    std::size_t capacity() const { return config_.capacity; }  // Per new segment
+    const JournalConfig& config() const { return config_; }
+
+    // Record `sequence`, which must be between firstSequence() and
+    // lastSequence(). Stays valid until its segment is discarded.
+    const JournalRecord& record(uint64_t sequence) const;
+
+    // Calls fn(const JournalRecord&) for each record from firstSequence
+    // through lastSequence, oldest first, skipping discarded ones
+    template<typename Fn>
+    void replay(Fn&& fn, uint64_t firstSequence = 1, uint64_t lastSequence = UINT64_MAX) const {
+        uint64_t last = std::min(lastSequence, this->lastSequence());
+        uint64_t sequence = std::max(firstSequence, this->firstSequence());
+        while (sequence <= last) {
+            uint64_t segmentLast;
+            std::shared_ptr<const Segment> segment = segmentFor(sequence, segmentLast);
+            for (uint64_t end = std::min(last, segmentLast); sequence <= end; ++sequence) {
+                fn(segment->records[sequence - segment->first]);
+            }
+        }
+    }
+
+private:
+    struct Segment {
+        std::string path;
+        int fd{-1};
+        std::size_t capacity{0};
+        std::size_t mappedBytes{0};
+        char* mapping{nullptr};
+        JournalRecord* records{nullptr};
+        uint64_t first{1};  // Sequence of records[0]
+
+        Segment(std::string path, std::size_t capacity);
+        ~Segment();
+        Segment(const Segment&) = delete;
+        Segment& operator=(const Segment&) = delete;
+    };
+
+    // The segment holding `sequence`, and its last sequence (UINT64_MAX for
+    // the current one)
+    std::shared_ptr<const Segment> segmentFor(uint64_t sequence, uint64_t& last) const;
+    void switchSegment(uint64_t sequence);
+    void recover();
+    void flusherLoop();
+    // Makes everything up to `sequence` durable; false if the sync failed
+    bool syncThrough(uint64_t sequence);
+    void wakeFlusher();
+
+    JournalConfig config_;
+
+    mutable std::mutex segmentsMutex_;
+    std::vector<std::shared_ptr<Segment>> segments_;  // Oldest first; the last is current
+    std::shared_ptr<Segment> next_;                   // Started, not yet written to
+    bool startingSegment_{false};
+    std::size_t nextIndex_{1};
+    Segment* current_{nullptr};                       // Writer's view of segments_.back()
+    std::atomic<bool> nextReady_{false};
+    std::atomic<uint64_t> currentEnd_{0};             // Last sequence the current segment holds
+    std::atomic<uint64_t> first_{1};
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> durable_{0};
+
+    std::mutex mutex_;
+    std::condition_variable flushRequested_;
+    std::condition_variable durableAdvanced_;
+    std::mutex flushMutex_;  // Serialises syncThrough between the flusher and flush()
+    bool running_{true};
+    std::thread flusher_;
+};
+
+#endif // ORDER_JOURNAL_HPP
@@ -3,34 +3,127 @@
 #define HIGH_PERFORMANCE_TRADING_GATEWAY_ORDER_MANAGER_HPP
 
 #include <string>
-#include <mutex>
-#include <unordered_map>
+#include <string_view>
+#include <memory>
 #include <optional>
+#include <mutex>
+#include <vector>
 #include <stdexcept>
+#include "FixSchema.hpp"
+#include "InstrumentRegistry.hpp"
+#include "ObjectPool.hpp"
+#include "Order.hpp"
+#include "OrderIndex.hpp"
+#include "OrderJournal.hpp"
 
+// Order store partitioned by ClOrdID hash into independently locked shards,
+// so workers touching different orders do not serialise on one mutex.
 class OrderManager {
 public:
-    // Create a new order
+    static constexpr std::size_t kDefaultCapacity = 65536;
+    static constexpr std::size_t kDefaultShards = 16;
+
+    enum class Concurrency {
+        LOCKED,         // Any thread may call in; each shard has its own lock
+        SINGLE_WRITER   // Owned by one thread (see OrderSequencer); no locks taken
+    };
+
+    // Preallocates records for expectedOrders live orders, spread over
+    // shardCount shards (rounded up to a power of two). Symbols are interned
+    // in `instruments`, or in a registry of its own if none is shared.
+    explicit OrderManager(std::size_t expectedOrders = kDefaultCapacity,
+                          std::size_t shardCount = kDefaultShards,
+                          std::shared_ptr<InstrumentRegistry> instruments = nullptr,
+                          Concurrency concurrency = Concurrency::LOCKED);
+
+    // Create a new order from a NewOrderSingle FIX message
     void createOrder(const std::string& orderId, const std::string& orderDetails);
     
-    // Get an existing order
-    std::optional<std::string> getOrder(const std::string& orderId) const;
+    // Copy of an existing order, taken under its shard lock: the slot behind
+    // it is reused once the order is cancelled
+    std::optional<Order> getOrder(std::string_view orderId) const;
     
-    // Process a FIX message containing order information
+    // Process a FIX message: NewOrderSingle (D), cancel (F) or cancel/replace (G)
     void processOrder(const std::string& fixMessage);
     
     // Cancel an existing order
     void cancelOrder(const std::string& orderId);
     
-    // Modify an existing order
+    // Modify an existing order's side, price, quantity or type from FIX fields
     void modifyOrder(const std::string& orderId, const std::string& newDetails);
     
     // Check if an order exists
     bool orderExists(const std::string& orderId) const;
 
+    // Number of live orders
+    std::size_t size() const;
+
+    std::size_t shardCount() const { return shards_.size(); }
+
+    // Applies a journaled event the way processOrder() applied the request it
+    // was recorded from, stamped with the event's time rather than the clock.
+    // Returns false if the event was rejected (unknown or duplicate ClOrdID).
+    // For a MODIFY or CANCEL, `previous` (if given) receives the order as it
+    // was just before the event, read under the same lock that changed it.
+    bool apply(const JournalRecord& record, Order* previous = nullptr);
+
+    // Reinserts orders read back from a snapshot with their gateway order
+    // ids; ids assigned afterwards continue past the highest one restored
+    void restoreOrders(const Order* orders, std::size_t count);
+
+    // Calls fn(const Order&) for every live order, holding one shard lock at
+    // a time: each shard is seen at a single point, but not all shards at once
+    template<typename Fn>
+    void forEachOrder(Fn&& fn) const {
+        for (const auto& shard : shards_) {
+            auto lock = lockShard(*shard);
+            shard->index.forEach([&](const ClOrdId&, uint32_t slot) { fn(shard->orders[slot]); });
+        }
+    }
+
+    InstrumentRegistry& instruments() const { return *instruments_; }
+    bool singleWriter() const { return singleWriter_; }
+
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::string> activeOrders_;
+    // ClOrdID with its hash, computed once per request: the high bits pick the
+    // shard and the low bits the index bucket
+    struct Key {
+        ClOrdId id;
+        uint64_t hash;
+
+        explicit Key(std::string_view orderId) : id(orderId), hash(id.hash()) {}
+    };
+
+    // Each shard sits on its own cache lines so shard locks do not false-share
+    struct alignas(64) Shard {
+        explicit Shard(std::size_t capacity, uint64_t shardIndex);
+
+        uint32_t findSlot(const Key& key) const { return index.find(key.id, key.hash); }
+        uint32_t insert(const Key& key, const Order& order);
+        uint32_t insertNew(const Key& key, const fix::NewOrderSingle& decoded, uint64_t stride,
+                           int64_t nowNs);
+        void remove(const Key& key, uint32_t slot);
+
+        mutable std::mutex mutex;
+        ObjectPool<Order> orders;
+        OrderIndex index;
+        uint64_t nextOrderId;
+    };
+
+    Shard& shardFor(const Key& key) const;
+    std::unique_lock<std::mutex> lockShard(const Shard& shard) const {
+        return singleWriter_ ? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(shard.mutex);
+    }
+    // Looks up an order id that may be too long to ever have been stored
+    bool tryMakeKey(std::string_view orderId, std::optional<Key>& key) const;
+    void insertOrder(std::string_view orderId, const fix::NewOrderSingle& decoded, int64_t nowNs);
+    void removeOrder(std::string_view orderId, Order* previous = nullptr);
+    void replaceOrder(const fix::OrderCancelReplaceRequest& replace, int64_t nowNs, Order* previous = nullptr);
+
+    std::shared_ptr<InstrumentRegistry> instruments_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t shardMask_;
+    bool singleWriter_;
 };
 
 #endif
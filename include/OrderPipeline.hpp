@@ -0,0 +1,213 @@
+// include/OrderPipeline.hpp
+#ifndef ORDER_PIPELINE_HPP
+#define ORDER_PIPELINE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include "BinaryProtocol.hpp"
+#include "FixSchema.hpp"
+#include "OrderJournal.hpp"
+#include "OrderManager.hpp"
+#include "RiskChecker.hpp"
+#include "WaitStrategy.hpp"
+
+enum class PipelineStage {
+    DECODE,
+    RISK,
+    ORDER_STATE,
+    JOURNAL,
+    ENCODE
+};
+
+constexpr std::size_t kPipelineStages = 5;
+
+const char* pipelineStageName(PipelineStage stage);
+
+// What a published request holds
+enum class PipelineRequest {
+    TEXT,      // '|'-delimited FIX order message, answered with a text ACK or NAK
+    BINARY,    // BinaryProtocol order message, answered with a binary::ExecutionReport
+    // A response the publisher made itself, e.g. to a Logon it handled; it
+    // is passed through untouched and goes out behind the responses to the
+    // requests published before it
+    RESPONSE
+};
+
+// Base for what a publisher hands in with a request to get back with its
+// response, e.g. the connection to answer. The count lives in the object,
+// so publishing with a context allocates nothing.
+struct PipelineContext : boost::intrusive_ref_counter<PipelineContext, boost::thread_safe_counter> {
+    virtual ~PipelineContext() = default;
+};
+using PipelineContextPtr = boost::intrusive_ptr<PipelineContext>;
+
+// One request as it moves through the pipeline. It lives in a preallocated
+// ring slot and every stage works on it in place: the decoded message views
+// the slot's own copy of the request text, and the strings keep their
+// capacity from one lap of the ring to the next.
+struct PipelineEvent {
+    // Set by publish()
+    std::string request;
+    PipelineRequest kind{PipelineRequest::TEXT};
+    PipelineContextPtr context;  // Released once the response is emitted
+    int64_t publishedNs{0};
+
+    // DECODE
+    JournalRecord record;
+    fix::NewOrderSingle newOrder;  // Views into `request`; NEW_ORDER only
+    AccountId account{0};
+
+    // Set by whichever stage turns the request down; later stages pass it on
+    bool rejected{false};
+    std::string error;
+
+    // RISK and ORDER_STATE
+    bool exposureReserved{false};  // NEW_ORDER exposure taken by the risk stage
+    bool journaled{false};         // Reached the order state, so it goes in the journal
+    uint64_t journalSequence{0};
+
+    // ENCODE
+    std::string response;
+};
+
+struct PipelineConfig {
+    std::size_t capacity{65536};  // Ring slots, rounded up to a power of two
+    // How each idle stage thread waits, indexed by PipelineStage. Five of
+    // them would keep five cores busy while spinning or yielding, so by
+    // default they all park once a short spin finds nothing.
+    std::array<WaitStrategy, kPipelineStages> wait{WaitStrategy::SPIN_PARK, WaitStrategy::SPIN_PARK,
+                                                   WaitStrategy::SPIN_PARK, WaitStrategy::SPIN_PARK,
+                                                   WaitStrategy::SPIN_PARK};
+    bool ackAfterDurable{false};  // Hold each response until its journal event is on disk
+    // Called on the encode thread for each event, in publish order, once
+    // its response is ready. The event is still in its slot: copy out what
+    // is needed before returning.
+    std::function<void(const PipelineEvent& event)> onResponse;
+};
+
+struct PipelineStageStats {
+    PipelineStage stage;
+    uint64_t processed{0};
+    uint64_t backlog{0};      // Events its upstream has finished that it has not
+    double averageNs{0};      // Time spent working, per event
+};
+
+struct PipelineStats {
+    std::array<PipelineStageStats, kPipelineStages> stages;
+    uint64_t completed{0};
+    uint64_t rejected{0};
+    double averageLatencyNs{0};  // Publish to response
+    uint64_t maxLatencyNs{0};
+};
+
+// Disruptor-style order path. Requests are published into a ring of event
+// slots and handed from stage to stage by sequence cursors alone:
+//
+//   publish -> DECODE -> RISK -> ORDER_STATE -+-> JOURNAL --+-> ENCODE
+//                                             +-------------+
+//
+// Each stage is one thread that owns its cursor and processes every event
+// its upstream cursor has passed, in a batch; no event is copied between
+// stages. ENCODE formats responses as soon as ORDER_STATE has settled them,
+// in parallel with JOURNAL, and emits each one only after JOURNAL has passed
+// it. A slot goes back to publishers once ENCODE has emitted it.
+//
+// ORDER_STATE owns the OrderManager (built with Concurrency::SINGLE_WRITER)
+// the way OrderSequencer does and runs the risk checks that need an existing
+// order. It journals only events it attempted to apply, after applying them:
+// a request it turned down never reaches the journal, and nothing is
+// answered before its event is journaled.
+class OrderPipeline {
+public:
+    OrderPipeline(const PipelineConfig& config, std::shared_ptr<OrderManager> orders,
+                  std::shared_ptr<OrderJournal> journal = nullptr,
+                  std::shared_ptr<RiskChecker> riskChecker = nullptr);
+    // Drains events already published, then stops
+    ~OrderPipeline();
+
+    OrderPipeline(const OrderPipeline&) = delete;
+    OrderPipeline& operator=(const OrderPipeline&) = delete;
+
+    // Copies the request into the next slot, waiting while the ring is full,
+    // and returns its ticket (1 for the first event, then consecutive). Safe
+    // to call from any number of threads.
+    uint64_t publish(std::string_view request, PipelineContextPtr context = nullptr,
+                     PipelineRequest kind = PipelineRequest::TEXT);
+
+    // Waits until the event with this ticket has been emitted
+    void waitCompleted(uint64_t ticket) const;
+
+    uint64_t completed() const;
+    const OrderManager& orders() const { return *orders_; }
+    PipelineStats stats() const;
+
+    // Stops once every published event has been emitted; publishing
+    // afterwards is not allowed
+    void stop();
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> published{0};  // Ticket of the event in it, once written
+        PipelineEvent event;
+    };
+
+    struct alignas(64) Stage {
+        std::atomic<uint64_t> cursor{0};  // Events finished
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<bool> finished{false};
+        std::unique_ptr<Waiter> waiter;
+        std::thread thread;
+    };
+
+    Stage& stage(PipelineStage stage) { return stages_[static_cast<std::size_t>(stage)]; }
+    const Stage& stage(PipelineStage stage) const { return stages_[static_cast<std::size_t>(stage)]; }
+    PipelineEvent& event(uint64_t index) { return slots_[index & mask_].event; }
+
+    // Stage loop for every stage but ENCODE: handles events up to whatever
+    // available() returns, and exits once upstreamDone() and caught up
+    template<typename Available, typename UpstreamDone, typename Handle>
+    void runStage(PipelineStage self, std::initializer_list<PipelineStage> downstream,
+                  Available&& available, UpstreamDone&& upstreamDone, Handle&& handle);
+    void runEncode();
+
+    void decode(PipelineEvent& event);
+    // Both fill in the event's record and return the account it names
+    std::string_view decodeText(PipelineEvent& event);
+    std::string_view decodeBinary(PipelineEvent& event);
+    void checkRisk(PipelineEvent& event);
+    void applyToOrders(PipelineEvent& event);
+    void appendToJournal(PipelineEvent& event);
+    void encode(PipelineEvent& event);
+    void encodeBinary(PipelineEvent& event);
+    void reject(PipelineEvent& event, std::string_view error);
+
+    PipelineConfig config_;
+    std::shared_ptr<OrderManager> orders_;
+    std::shared_ptr<OrderJournal> journal_;
+    std::shared_ptr<RiskChecker> riskChecker_;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<uint64_t> claimed_{0};
+    std::array<Stage, kPipelineStages> stages_;
+    // ORDER_STATE only: the sequence the next journaled event will get, and
+    // how far the journal is known to have room
+    uint64_t journalNext_{1};
+    uint64_t journalEnd_{0};
+    alignas(64) std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> latencyNs_{0};
+    std::atomic<uint64_t> maxLatencyNs_{0};
+    std::atomic<bool> running_{true};
+};
+
+#endif // ORDER_PIPELINE_HPP
@@ -0,0 +1,111 @@
+// include/OrderSequencer.hpp
+#ifndef ORDER_SEQUENCER_HPP
+#define ORDER_SEQUENCER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "OrderJournal.hpp"
+#include "OrderManager.hpp"
+#include "RiskChecker.hpp"
+#include "WaitStrategy.hpp"
+
+struct SequencerConfig {
+    std::size_t capacity{65536};  // Ring slots, rounded up to a power of two
+    int cpu{-1};                  // Core to pin the sequencer thread to; unpinned if negative
+    // How the sequencer thread waits for events; BUSY_SPIN wants a pinned,
+    // isolated core
+    WaitStrategy wait{WaitStrategy::SPIN_YIELD};
+    // Called on the sequencer thread after each event, with its ticket and
+    // whether the order state accepted it
+    std::function<void(uint64_t ticket, bool applied)> onProcessed;
+};
+
+// What became of one published event, for a publisher that has to answer
+// with it. Written by the sequencer thread; `done` is set last.
+struct SequencerOutcome {
+    std::atomic<bool> done{false};
+    bool applied{false};
+    RiskCheck risk{RiskCheck::PASSED};  // The failed check, if that was why it was dropped
+};
+
+// Single-writer order path. One thread owns the OrderManager (which must be
+// built with Concurrency::SINGLE_WRITER) and applies events one at a time in
+// the order they were published, so there are no locks on order state and
+// no two requests for the same order are ever reordered.
+//
+// Network threads publish requests already decoded into JournalRecords
+// through a bounded multi-producer ring; a publish is a claim on a ring
+// position and a copy, and returns the event's ticket (1 for the first
+// event, then consecutive). With a journal, the sequencer journals each
+// event just before applying it, so the journal order is exactly the order
+// of application and replaying the journal reproduces the same state,
+// gateway order ids included.
+//
+// Risk checks that depend on an existing order (cancel releases, replace
+// exposure) need order state, so with a RiskChecker they run here too: a
+// replace that fails is dropped and counted as rejected, and a publisher that
+// passed a SequencerOutcome can wait for that to NAK it. A new order that
+// cannot be applied gives back the exposure its check reserved.
+class OrderSequencer {
+public:
+    OrderSequencer(const SequencerConfig& config, std::shared_ptr<OrderManager> orders,
+                   std::shared_ptr<OrderJournal> journal = nullptr,
+                   std::shared_ptr<RiskChecker> riskChecker = nullptr);
+    // Drains events already published, then stops
+    ~OrderSequencer();
+
+    OrderSequencer(const OrderSequencer&) = delete;
+    OrderSequencer& operator=(const OrderSequencer&) = delete;
+
+    // Copies the event into the ring, waiting while the ring is full, and
+    // returns its ticket. Safe to call from any number of threads. If given,
+    // `outcome` is filled in once the event is processed and must outlive that.
+    uint64_t publish(const JournalRecord& record, AccountId account = 0, SequencerOutcome* outcome = nullptr);
+
+    // Waits until the event with this ticket has been applied
+    void waitProcessed(uint64_t ticket) const;
+    // Waits until the event with this ticket has been applied and journaled durably
+    void waitDurable(uint64_t ticket) const;
+    // Waits until the event published with `outcome` has been processed
+    static void wait(const SequencerOutcome& outcome);
+
+    uint64_t processed() const { return processed_.load(std::memory_order_acquire); }
+    uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+    const OrderManager& orders() const { return *orders_; }
+
+    // Stops once the ring is drained; publishing afterwards is not allowed
+    void stop();
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        JournalRecord record;
+        AccountId account{0};
+        SequencerOutcome* outcome{nullptr};
+    };
+
+    void run();
+    bool process(JournalRecord& record, AccountId account, RiskCheck& risk);
+
+    SequencerConfig config_;
+    std::shared_ptr<OrderManager> orders_;
+    std::shared_ptr<OrderJournal> journal_;
+    std::shared_ptr<RiskChecker> riskChecker_;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    // Producers and the consumer advance separate cache lines
+    alignas(64) std::atomic<uint64_t> claimed_{0};
+    alignas(64) uint64_t next_{0};  // Sequencer thread only
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<bool> running_{true};
+    Waiter waiter_;
+    std::thread thread_;
+};
+
+#endif // ORDER_SEQUENCER_HPP
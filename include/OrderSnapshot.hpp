@@ -0,0 +1,115 @@
+// include/OrderSnapshot.hpp
+#ifndef ORDER_SNAPSHOT_HPP
+#define ORDER_SNAPSHOT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OrderJournal.hpp"
+#include "OrderManager.hpp"
+
+// Order snapshots are point-in-time images of OrderManager state, each tied
+// to the journal sequence it reflects. A file holds a 64-byte header, the
+// Order records exactly as they sit in memory, and the symbol table
+// (SymbolCode per InstrumentId) they refer to. Loading maps the file and
+// copies the records back, remapping InstrumentIds through the symbol table
+// since symbols may be interned in a different order by the next run.
+//
+// Files are named orders-<sequence>.snap so the newest sorts last, and are
+// written to a temporary name, synced and renamed, so a crash mid-write
+// never leaves a partial snapshot under a valid name.
+
+struct SnapshotInfo {
+    std::string path;
+    uint64_t journalSequence{0};  // Last journal event reflected
+    std::size_t orders{0};
+};
+
+// Writes every live order in `orders` as of journal event `journalSequence`.
+// With a journal, the snapshot also records a fingerprint of that event so
+// it is only ever replayed onto the journal it was taken from.
+SnapshotInfo writeOrderSnapshot(const std::string& directory, const OrderManager& orders,
+                                uint64_t journalSequence, const OrderJournal* journal = nullptr);
+
+// Loads a snapshot into `orders`, which should be empty. Throws
+// std::runtime_error, before touching `orders`, if the file is damaged or
+// (given a journal) was not taken from it or is ahead of it.
+SnapshotInfo loadOrderSnapshot(const std::string& path, OrderManager& orders,
+                               const OrderJournal* journal = nullptr);
+
+// Snapshot files in `directory`, newest first
+std::vector<std::string> listOrderSnapshots(const std::string& directory);
+
+struct RecoveryResult {
+    SnapshotInfo snapshot;          // Empty path if recovery started from the journal alone
+    std::size_t skippedSnapshots{0};  // Newer snapshots that failed to load
+    uint64_t replayedEvents{0};
+    uint64_t journalSequence{0};    // Last event applied
+    std::chrono::nanoseconds elapsed{0};
+};
+
+// Restores `orders` from the newest usable snapshot in `snapshotDirectory`
+// (if any) and then replays only the journal events after it, up to
+// `throughSequence`. Throws std::runtime_error if the journal no longer holds
+// the events after that snapshot.
+RecoveryResult recoverOrders(const std::string& snapshotDirectory, const OrderJournal& journal,
+                             OrderManager& orders, uint64_t throughSequence = UINT64_MAX);
+
+struct SnapshotConfig {
+    std::string directory;
+    std::chrono::seconds interval{60};   // Between background snapshots
+    std::size_t retain{2};               // Newest files kept; older ones are deleted
+    std::size_t expectedOrders{65536};   // Sizes the replica
+};
+
+// Takes snapshots in the background without touching the live OrderManager.
+//
+// The snapshotter keeps a replica of order state that it rolls forward by
+// applying journal events, only ever up to the journal's durable sequence,
+// so a snapshot never reflects an event a crash could still lose. Every
+// interval it catches the replica up and writes a snapshot if anything has
+// changed, then starts a new journal segment and discards the segments
+// that every retained snapshot is past. The gateway's own threads never wait
+// on it; the cost is the memory of a second copy of the orders.
+class OrderSnapshotter {
+public:
+    OrderSnapshotter(const SnapshotConfig& config, std::shared_ptr<OrderJournal> journal);
+    ~OrderSnapshotter();
+
+    OrderSnapshotter(const OrderSnapshotter&) = delete;
+    OrderSnapshotter& operator=(const OrderSnapshotter&) = delete;
+
+    // Catches up and writes a snapshot now, unless nothing has changed since
+    // the last one; returns the journal sequence of the latest snapshot
+    uint64_t snapshotNow();
+
+    uint64_t lastSnapshotSequence() const { return lastSnapshot_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+    // Both require workMutex_
+    void catchUp();
+    uint64_t writeIfChanged();
+
+    SnapshotConfig config_;
+    std::shared_ptr<OrderJournal> journal_;
+    OrderManager replica_;
+    uint64_t appliedSequence_{0};
+    bool recovered_{false};
+    std::atomic<uint64_t> lastSnapshot_{0};
+
+    std::mutex workMutex_;  // Serialises use of the replica
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool running_{true};
+    std::thread thread_;
+};
+
+#endif // ORDER_SNAPSHOT_HPP
@@ -0,0 +1,136 @@
+// include/OutboundQueue.hpp
+#ifndef OUTBOUND_QUEUE_HPP
+#define OUTBOUND_QUEUE_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Per-connection queue of encoded responses waiting for the socket. Messages
+// are copied into fixed-size chunks, so any number of them go out in one
+// gather write of the chunks queued when it starts; whatever is appended
+// while it is in progress waits for the next one. Written chunks are kept
+// for reuse, up to a few, so a connection that keeps up allocates nothing.
+//
+// Not thread-safe: a connection's io thread is its only user.
+class OutboundQueue {
+public:
+    static constexpr std::size_t kDefaultChunkSize = 16 * 1024;
+    static constexpr std::size_t kSpareChunks = 4;
+
+    // A write's gather list as a buffer sequence. asio's composed write keeps
+    // a copy of its buffer sequence, and copying this one allocates nothing.
+    class Gather {
+    public:
+        using value_type = boost::asio::const_buffer;
+        using const_iterator = const boost::asio::const_buffer*;
+
+        Gather(const_iterator first, const_iterator last) : first_(first), last_(last) {}
+
+        const_iterator begin() const { return first_; }
+        const_iterator end() const { return last_; }
+        std::size_t size() const { return static_cast<std::size_t>(last_ - first_); }
+        const boost::asio::const_buffer& front() const { return *first_; }
+
+    private:
+        const_iterator first_;
+        const_iterator last_;
+    };
+
+    explicit OutboundQueue(std::size_t chunkSize = kDefaultChunkSize) : chunkSize_(chunkSize) {}
+
+    OutboundQueue(const OutboundQueue&) = delete;
+    OutboundQueue& operator=(const OutboundQueue&) = delete;
+
+    // Copies the message and its delimiter in after everything queued
+    void append(std::string_view message, char delimiter) {
+        copyIn(message.data(), message.size());
+        copyIn(&delimiter, 1);
+    }
+
+    // Copies in a message that carries its own length
+    void append(std::string_view message) {
+        copyIn(message.data(), message.size());
+    }
+
+    // Nothing waiting for a write
+    bool empty() const { return queued_.size() == writing_; }
+    // A write from beginWrite() has not ended yet
+    bool writing() const { return writing_ > 0; }
+
+    // Bytes appended and not yet part of a write
+    std::size_t pendingBytes() const {
+        std::size_t bytes = 0;
+        for (std::size_t i = writing_; i < queued_.size(); ++i) {
+            bytes += queued_[i].size;
+        }
+        return bytes;
+    }
+
+    // Everything appended so far as one gather list, which stays valid until
+    // endWrite(). Only while nothing is being written and something is queued.
+    Gather beginWrite() {
+        gather_.clear();
+        for (const Chunk& chunk : queued_) {
+            gather_.emplace_back(chunk.data.get(), chunk.size);
+        }
+        writing_ = queued_.size();
+        return Gather(gather_.data(), gather_.data() + gather_.size());
+    }
+
+    // The write from beginWrite() is over, whether or not it succeeded
+    void endWrite() {
+        for (std::size_t i = 0; i < writing_; ++i) {
+            if (spare_.size() < kSpareChunks) {
+                queued_[i].size = 0;
+                spare_.push_back(std::move(queued_[i]));
+            }
+        }
+        queued_.erase(queued_.begin(), queued_.begin() + static_cast<std::ptrdiff_t>(writing_));
+        writing_ = 0;
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t size{0};
+    };
+
+    void copyIn(const char* bytes, std::size_t length) {
+        while (length > 0) {
+            // Chunks being written are never added to
+            if (queued_.size() == writing_ || queued_.back().size == chunkSize_) {
+                queued_.push_back(takeChunk());
+            }
+            Chunk& tail = queued_.back();
+            std::size_t copied = std::min(length, chunkSize_ - tail.size);
+            std::memcpy(tail.data.get() + tail.size, bytes, copied);
+            tail.size += copied;
+            bytes += copied;
+            length -= copied;
+        }
+    }
+
+    Chunk takeChunk() {
+        if (spare_.empty()) {
+            return Chunk{std::make_unique<char[]>(chunkSize_), 0};
+        }
+        Chunk chunk = std::move(spare_.back());
+        spare_.pop_back();
+        return chunk;
+    }
+
+    const std::size_t chunkSize_;
+    // The first writing_ of them are being written. A vector, not a deque,
+    // whose blocks would be freed and reallocated as chunks come and go.
+    std::vector<Chunk> queued_;
+    std::size_t writing_{0};
+    std::vector<Chunk> spare_;
+    std::vector<boost::asio::const_buffer> gather_;
+};
+
+#endif // OUTBOUND_QUEUE_HPP
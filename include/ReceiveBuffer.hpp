@@ -0,0 +1,114 @@
+// include/ReceiveBuffer.hpp
+#ifndef RECEIVE_BUFFER_HPP
+#define RECEIVE_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include "DelimiterScanner.hpp"
+
+// Per-connection receive buffer, allocated once and reused for every read.
+// A read appends to the free space after the unread bytes; consumeFrames()
+// then hands out every complete frame as a view into the buffer and moves
+// the partial frame left over, if any, to the front. The views are only
+// valid until the next read. Frames end in a delimiter (text) or carry their
+// own length (binary); a callback returning false stops at its frame and
+// leaves the rest, e.g. for a connection switching from one to the other.
+class ReceiveBuffer {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64 * 1024;
+
+    explicit ReceiveBuffer(std::size_t capacity = kDefaultCapacity)
+        : data_(std::make_unique<char[]>(capacity))
+        , capacity_(capacity) {}
+
+    ReceiveBuffer(const ReceiveBuffer&) = delete;
+    ReceiveBuffer& operator=(const ReceiveBuffer&) = delete;
+
+    // Free space for the next read
+    char* writeData() { return data_.get() + end_; }
+    std::size_t writeSize() const { return capacity_ - end_; }
+
+    // Marks `bytes` written at writeData() as received
+    void commit(std::size_t bytes) { end_ += bytes; }
+
+    // Calls onFrame(std::string_view) for each complete frame, without its
+    // delimiter, in order; returns how many there were
+    template<typename OnFrame>
+    std::size_t consumeFrames(char delimiter, OnFrame&& onFrame) {
+        std::string_view unread(data_.get(), end_);
+        DelimiterScanner scanner(unread, delimiter);
+        std::size_t frames = 0;
+        std::size_t start = 0;
+        for (std::size_t end = scanner.next(); end != DelimiterScanner::npos; end = scanner.next()) {
+            bool more = deliver(onFrame, unread.substr(start, end - start));
+            start = end + 1;
+            ++frames;
+            if (!more) {
+                break;
+            }
+        }
+        discard(start);
+        return frames;
+    }
+
+    // As consumeFrames(), for messages that start with their own length as a
+    // little-endian uint16, the two length bytes included, and are handed out
+    // whole. A length below two counts as two, so the stream still advances.
+    template<typename OnMessage>
+    std::size_t consumeMessages(OnMessage&& onMessage) {
+        std::size_t messages = 0;
+        std::size_t start = 0;
+        while (end_ - start >= 2) {
+            const auto* prefix = reinterpret_cast<const unsigned char*>(data_.get() + start);
+            std::size_t length = std::max<std::size_t>(prefix[0] | (prefix[1] << 8), 2);
+            if (end_ - start < length) {
+                break;
+            }
+            bool more = deliver(onMessage, std::string_view(data_.get() + start, length));
+            start += length;
+            ++messages;
+            if (!more) {
+                break;
+            }
+        }
+        discard(start);
+        return messages;
+    }
+
+    // Bytes of an incomplete frame waiting for the rest
+    std::size_t size() const { return end_; }
+    std::size_t capacity() const { return capacity_; }
+    // A frame longer than the buffer can never complete
+    bool full() const { return end_ == capacity_; }
+
+private:
+    template<typename OnFrame>
+    static bool deliver(OnFrame& onFrame, std::string_view frame) {
+        if constexpr (std::is_same_v<std::invoke_result_t<OnFrame&, std::string_view>, bool>) {
+            return onFrame(frame);
+        } else {
+            onFrame(frame);
+            return true;
+        }
+    }
+
+    // Drops the first `consumed` bytes, keeping what follows them
+    void discard(std::size_t consumed) {
+        // Usually nothing is left over and there is nothing to copy
+        std::size_t partial = end_ - consumed;
+        if (partial > 0 && consumed > 0) {
+            std::memmove(data_.get(), data_.get() + consumed, partial);
+        }
+        end_ = partial;
+    }
+
+    std::unique_ptr<char[]> data_;
+    std::size_t capacity_;
+    std::size_t end_{0};
+};
+
+#endif // RECEIVE_BUFFER_HPP
@@ -0,0 +1,146 @@
+// include/RiskChecker.hpp
+#ifndef RISK_CHECKER_HPP
+#define RISK_CHECKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include "FixSchema.hpp"
+#include "FixedPoint.hpp"
+#include "InstrumentRegistry.hpp"
+#include "Order.hpp"
+
+struct Execution;
+
+struct RiskLimits {
+    Qty maxOrderQty{1'000'000};
+    Price maxOrderNotional{Price(1'000'000'000, 2)};  // 10,000,000.00
+    // Fat-finger band around the instrument's last trade, in basis points;
+    // 0 disables the check. Orders are not banded until a trade is seen.
+    uint32_t priceBandBps{500};
+    // Per account: open notional of resting limit orders
+    Price maxOpenNotional{Price(5'000'000'000, 2)};  // 50,000,000.00
+    uint32_t maxOrdersPerSecond{10'000};
+};
+
+enum class RiskCheck : uint8_t {
+    PASSED,
+    ORDER_QTY,
+    ORDER_NOTIONAL,
+    PRICE_BAND,
+    OPEN_EXPOSURE,
+    ORDER_RATE
+};
+
+const char* riskCheckName(RiskCheck check);
+
+// Latency budget per check in nanoseconds, single thread, warm cache. These
+// are published limits for the inline path: risk_check_bench measures each
+// check against them and the whole of checkNewOrder must stay under 1us.
+namespace risk_budget {
+    constexpr double kOrderLimitsNs = 25;
+    constexpr double kPriceBandNs = 25;
+    constexpr double kOpenExposureNs = 50;
+    constexpr double kOrderRateNs = 50;
+    constexpr double kAccountLookupNs = 100;
+    constexpr double kTotalNs = 1000;
+}
+
+// Inline pre-trade risk checks, run on the request path before an order
+// reaches the book. There is no lock: per-account counters and last-trade
+// prices are atomics in preallocated arrays indexed by AccountId and
+// InstrumentId, so concurrent callers only contend on the same account's
+// cache line.
+//
+// Open exposure is reserved by checkNewOrder and must be given back with
+// release() (or onExecution()) when quantity fills or is cancelled. Market
+// orders are checked against the last trade but do not reserve exposure,
+// since they never rest.
+class RiskChecker {
+public:
+    static constexpr std::size_t kDefaultMaxAccounts = 1024;
+    // Notional and exposure are tracked in hundredths, rounded up
+    static constexpr uint8_t kNotionalScale = 2;
+
+    explicit RiskChecker(std::shared_ptr<InstrumentRegistry> instruments,
+                         const RiskLimits& limits = RiskLimits(),
+                         std::size_t maxAccounts = kDefaultMaxAccounts);
+
+    // Interns the account (FIX tag 1; empty for none). Throws
+    // std::length_error once maxAccounts distinct accounts have been seen.
+    AccountId account(std::string_view account);
+    // Overrides the exposure and rate limits for one account
+    void setAccountLimits(AccountId account, Price maxOpenNotional, uint32_t maxOrdersPerSecond);
+
+    // Runs every check in order and reserves open exposure if all pass.
+    // `order.instrument` must have been resolved against the registry.
+    RiskCheck checkNewOrder(const fix::NewOrderSingle& order, AccountId account, int64_t nowNs);
+
+    // Checks a replacement's new price and quantity and moves the account's
+    // reserved exposure from the existing order's remaining notional to the
+    // new one. The change is returned in exposureDelta so the caller can undo
+    // it with adjustExposure() if the replace is then rejected downstream.
+    RiskCheck checkReplace(const fix::OrderCancelReplaceRequest& replace, AccountId account,
+                           const Order& existing, int64_t nowNs, int64_t& exposureDelta);
+
+    // Gives back exposure reserved for quantity that filled or was cancelled
+    void release(AccountId account, const Price& price, Qty quantity) {
+        adjustExposure(account, -notional(price, quantity));
+    }
+    void adjustExposure(AccountId account, int64_t delta) {
+        accounts_[account].openNotional.fetch_add(delta, std::memory_order_relaxed);
+    }
+    // Records a trade price for the price band check, from the market data
+    // feed or the engine's fills
+    void onTrade(InstrumentId instrument, const Price& price);
+    // Applies a matching engine report: fills update the last trade, and
+    // filled or cancelled quantity of resting orders releases exposure
+    void onExecution(const Execution& execution);
+    // Reserves the open exposure of an order recovered at startup, under the
+    // account it was placed with, as if it had just passed checkNewOrder
+    void restoreOrder(const Order& order);
+
+    // Individual checks, public so their cost can be measured on their own
+    RiskCheck checkOrderLimits(const Price& price, Qty quantity) const;
+    RiskCheck checkPriceBand(InstrumentId instrument, const Price& price) const;
+    RiskCheck checkOrderRate(AccountId account, int64_t nowNs);
+    RiskCheck reserveExposure(AccountId account, int64_t notional);
+
+    // Notional of quantity at price, in units of 10^-kNotionalScale
+    static int64_t notional(const Price& price, Qty quantity);
+    // Change in open notional from replacing `existing` with a new price (zero
+    // to keep the order's) and quantity
+    static int64_t replaceDelta(const Order& existing, const Price& newPrice, Qty newQty);
+    int64_t openNotional(AccountId account) const {
+        return accounts_[account].openNotional.load(std::memory_order_relaxed);
+    }
+    // Last trade price, or a zero price if none has been seen
+    Price lastTrade(InstrumentId instrument) const;
+
+    const InstrumentRegistry& instruments() const { return *instruments_; }
+
+private:
+    // Each account on its own cache line so accounts do not false-share
+    struct alignas(64) AccountState {
+        std::atomic<int64_t> openNotional{0};
+        std::atomic<int64_t> maxOpenNotional{0};
+        std::atomic<int64_t> windowStartNs{0};
+        std::atomic<uint32_t> ordersInWindow{0};
+        std::atomic<uint32_t> maxOrdersPerSecond{0};
+    };
+
+    // Scale at which last trades are stored
+    static constexpr uint8_t kTradeScale = Price::kMaxScale;
+
+    std::shared_ptr<InstrumentRegistry> instruments_;
+    RiskLimits limits_;
+    int64_t maxOrderNotional_;
+    // Accounts are interned the same way as symbols
+    InstrumentRegistry accountIds_;
+    std::unique_ptr<AccountState[]> accounts_;
+    std::unique_ptr<std::atomic<int64_t>[]> lastTrades_;  // Indexed by InstrumentId
+};
+
+#endif // RISK_CHECKER_HPP
@@ -0,0 +1,179 @@
+// include/SpscQueue.hpp
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "WaitStrategy.hpp"
+
+// Bounded single-producer/single-consumer ring with MessageQueue's
+// push/pop/stop surface, for pipeline stages with exactly one thread on each
+// side. A hand-off is a copy into a slot and one release store: no lock, no
+// system call, and each side re-reads the other's index only when its cached
+// copy says the ring looks full (or empty).
+//
+// Capacity is rounded up to a power of two. push() waits while the ring is
+// full; try_push() and try_pop() never wait. pop() waits for an item with
+// the queue's WaitStrategy.
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity = 1024, WaitStrategy wait = WaitStrategy::SPIN_YIELD)
+        : capacity_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+        , mask_(capacity_ - 1)
+        , slots_(std::make_unique<Slot[]>(capacity_))
+        , waiter_(wait) {
+    }
+
+    ~SpscQueue() {
+        while (try_pop()) {
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. The value is moved from only when it is pushed, so a
+    // failed attempt leaves it for the next one.
+    bool try_push(T&& value) {
+        return tryEmplace(std::move(value));
+    }
+
+    bool try_push(const T& value) {
+        return tryEmplace(value);
+    }
+
+    // Producer only; waits while the ring is full. Dropped if stopped.
+    void push(T value) {
+        for (int spins = 0; !try_push(std::move(value)); ++spins) {
+            if (stopped_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            backoff(spins);
+        }
+    }
+
+    // Consumer only
+    std::optional<T> try_pop() {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return std::nullopt;
+            }
+        }
+        T* slot = slots_[head & mask_].get();
+        std::optional<T> value(std::move(*slot));
+        slot->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Consumer only; like MessageQueue::pop, returns nothing on timeout or
+    // once stopped
+    std::optional<T> pop(const std::chrono::milliseconds& timeout = std::chrono::milliseconds(100)) {
+        std::optional<T> value;
+        waiter_.waitUntil([&] {
+            if (stopped_.load(std::memory_order_acquire)) {
+                return true;
+            }
+            value = try_pop();
+            return value.has_value();
+        }, std::chrono::steady_clock::now() + timeout);
+        return value;
+    }
+
+    // Consumer only: moves up to maxItems into `out` with a single release
+    // of the slots, and returns how many it moved
+    template<typename OutputIt>
+    std::size_t pop_n(OutputIt out, std::size_t maxItems) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t available = cachedTail_ - head;
+        if (available < maxItems) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            available = cachedTail_ - head;
+        }
+        std::size_t count = available < maxItems ? available : maxItems;
+        for (std::size_t i = 0; i < count; ++i) {
+            T* slot = slots_[(head + i) & mask_].get();
+            *out++ = std::move(*slot);
+            slot->~T();
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    void stop() {
+        stopped_.store(true, std::memory_order_release);
+        waiter_.notifyAll();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    template<typename U>
+    bool tryEmplace(U&& value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == capacity_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == capacity_) {
+                return false;
+            }
+        }
+        new (slots_[tail & mask_].storage) T(std::forward<U>(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        waiter_.notify();
+        return true;
+    }
+
+    static constexpr int kSpinLimit = 256;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Producers waiting for space spin, then yield
+    static void backoff(int spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Each index lives on its own cache line next to the side that writes it,
+    // together with that side's cached copy of the other index
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t cachedHead_{0};
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t cachedTail_{0};
+    alignas(64) std::atomic<bool> stopped_{false};
+    Waiter waiter_;
+};
+
+#endif // SPSC_QUEUE_HPP
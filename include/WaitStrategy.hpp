@@ -0,0 +1,160 @@
+// include/WaitStrategy.hpp
+#ifndef WAIT_STRATEGY_HPP
+#define WAIT_STRATEGY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// How a consumer waits for work. The spinning strategies trade a core for
+// wake-up latency: BUSY_SPIN never gives the core up and suits a stage pinned
+// to an isolated core; SPIN_YIELD spins briefly and then yields, staying
+// runnable; SPIN_PARK spins briefly and then sleeps on a futex until a
+// producer wakes it; BLOCKING goes straight to a condition variable.
+enum class WaitStrategy {
+    BUSY_SPIN,
+    SPIN_YIELD,
+    SPIN_PARK,
+    BLOCKING
+};
+
+const char* waitStrategyName(WaitStrategy strategy);
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Consumer-side wait with the producer-side wake-up it needs. Producers call
+// notify() after publishing; for the spinning strategies that is free, for
+// the sleeping ones it costs a fence and a load unless somebody is asleep.
+class Waiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit Waiter(WaitStrategy strategy = WaitStrategy::SPIN_YIELD) : strategy_(strategy) {}
+
+    Waiter(const Waiter&) = delete;
+    Waiter& operator=(const Waiter&) = delete;
+
+    WaitStrategy strategy() const { return strategy_; }
+
+    // Waits until ready() holds or the deadline passes; returns ready()
+    template<typename Ready>
+    bool waitUntil(Ready&& ready, Clock::time_point deadline) {
+        int spinLimit = strategy_ == WaitStrategy::BLOCKING ? 0 : kSpinLimit;
+        for (int spins = 0;; ++spins) {
+            if (ready()) {
+                return true;
+            }
+            if (spins < spinLimit) {
+                cpuRelax();
+                continue;
+            }
+            if (strategy_ == WaitStrategy::BUSY_SPIN) {
+                // Only look at the clock every so often
+                if ((spins & 1023) == 0 && Clock::now() >= deadline) {
+                    return ready();
+                }
+                cpuRelax();
+                continue;
+            }
+            if (Clock::now() >= deadline) {
+                return ready();
+            }
+            // ready() may consume what it finds, so a true result is final
+            if (strategy_ == WaitStrategy::SPIN_PARK) {
+                if (park(ready, deadline)) {
+                    return true;
+                }
+            } else if (strategy_ == WaitStrategy::BLOCKING) {
+                if (block(ready, deadline)) {
+                    return true;
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Ready>
+    void wait(Ready&& ready) {
+        waitUntil(ready, Clock::time_point::max());
+    }
+
+    // Wakes one sleeping consumer, if any
+    void notify() { wake(false); }
+    // Wakes every sleeping consumer, e.g. on stop
+    void notifyAll() { wake(true); }
+
+private:
+    static constexpr int kSpinLimit = 256;
+
+    // Both return whether ready() held
+    template<typename Ready>
+    bool park(Ready& ready, Clock::time_point deadline) {
+        uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        // Pairs with the fence in wake(): either the producer sees us asleep
+        // or we see what it published
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool done = ready();
+        if (!done) {
+            futexWait(epoch, deadline);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return done;
+    }
+
+    template<typename Ready>
+    bool block(Ready& ready, Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool done = true;
+        if (deadline == Clock::time_point::max()) {
+            wakeUp_.wait(lock, ready);
+        } else {
+            done = wakeUp_.wait_until(lock, deadline, ready);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return done;
+    }
+
+    void wake(bool all) {
+        if (strategy_ == WaitStrategy::BUSY_SPIN || strategy_ == WaitStrategy::SPIN_YIELD) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        if (strategy_ == WaitStrategy::SPIN_PARK) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            futexWake(all);
+            return;
+        }
+        // Taking the lock orders this wake-up after a consumer's last check
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        if (all) {
+            wakeUp_.notify_all();
+        } else {
+            wakeUp_.notify_one();
+        }
+    }
+
+    void futexWait(uint32_t epoch, Clock::time_point deadline);
+    void futexWake(bool all);
+
+    const WaitStrategy strategy_;
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> sleepers_{0};
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+};
+
+#endif // WAIT_STRATEGY_HPP
@@ -8,6 +8,10 @@
 
 #include "FixMessageHandler.hpp"
 #include "OrderManager.hpp"
+#include "MatchingEngine.hpp"
+#include "RiskChecker.hpp"
+#include "OrderJournal.hpp"
+#include "OrderSnapshot.hpp"
 #include "Logger.hpp"
 #include "NetworkServer.hpp"
 #include "NetworkTypes.hpp"
@@ -28,39 +32,136 @@ int main() {
 
         // Initialize components
         auto logger = std::make_shared<Logger>();
-        auto orderManager = std::make_shared<OrderManager>();
         
         // Configure server
         network::ServerConfig serverConfig;
         serverConfig.port = 8080;
         serverConfig.thread_pool_size = 4;
+        serverConfig.io_threads = 2;
+        serverConfig.reuse_port_listeners = true;
         serverConfig.max_connections = 100;
         serverConfig.client_timeout = std::chrono::milliseconds(5000);
+        serverConfig.order_manager_shards = 16;
+        serverConfig.enable_matching = false;
+        serverConfig.reference_data_file = "examples/data/instruments.csv";
+        serverConfig.journal_file = "order_journal.bin";
+        serverConfig.snapshot_directory = "snapshots";
+        // The journal records the order requests are applied in, which takes one writer
+        serverConfig.single_writer_sequencer = true;
+        serverConfig.order_pipeline = false;
+        serverConfig.bounded_ingress_queue = true;
+        serverConfig.ack_after_durable = false;
+
+        // Symbols are interned once here and shared by every component
+        auto instruments = std::make_shared<InstrumentRegistry>();
+        if (!serverConfig.reference_data_file.empty()) {
+            try {
+                std::size_t loaded = instruments->loadReferenceData(serverConfig.reference_data_file);
+                logger->log(Logger::Level::INFO, "Loaded " + std::to_string(loaded) + " instruments from " +
+                            serverConfig.reference_data_file);
+            } catch (const std::exception& e) {
+                logger->log(Logger::Level::WARNING, "Reference data not loaded: " + std::string(e.what()));
+            }
+        }
+
+        auto orderManager = std::make_shared<OrderManager>(
+            serverConfig.expected_orders, serverConfig.order_manager_shards, instruments,
+            serverConfig.single_writer_sequencer || serverConfig.order_pipeline
+                ? OrderManager::Concurrency::SINGLE_WRITER
+                : OrderManager::Concurrency::LOCKED);
+
+        // Optional internal crossing, with a book per instrument in the reference data
+        std::shared_ptr<MatchingEngine> matchingEngine;
+        if (serverConfig.enable_matching) {
+            matchingEngine = std::make_shared<MatchingEngine>(serverConfig.expected_orders, instruments);
+            matchingEngine->addBooksFromReferenceData();
+        }
+
+        std::shared_ptr<RiskChecker> riskChecker;
+        if (serverConfig.enable_risk_checks) {
+            riskChecker = std::make_shared<RiskChecker>(instruments);
+        }
+
+        std::shared_ptr<OrderJournal> journal;
+        if (!serverConfig.journal_file.empty()) {
+            JournalConfig journalConfig;
+            journalConfig.path = serverConfig.journal_file;
+            journalConfig.capacity = serverConfig.journal_capacity;
+            journalConfig.groupCommitEvents = serverConfig.journal_group_commit_events;
+            journalConfig.groupCommitInterval = serverConfig.journal_group_commit_interval;
+            journal = std::make_shared<OrderJournal>(journalConfig);
+            logger->log(Logger::Level::INFO, "Order journal " + journalConfig.path + " holds " +
+                        std::to_string(journal->lastSequence()) + " events");
+
+            // Rebuild order state from the newest snapshot and the journal tail after it
+            RecoveryResult recovery = recoverOrders(serverConfig.snapshot_directory, *journal, *orderManager);
+            logger->log(Logger::Level::INFO, "Recovered " + std::to_string(orderManager->size()) + " orders (" +
+                        (recovery.snapshot.path.empty() ? std::string("no snapshot")
+                                                        : "snapshot " + recovery.snapshot.path) +
+                        ", " + std::to_string(recovery.replayedEvents) + " journal events replayed) in " +
+                        std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            recovery.elapsed).count()) + "ms");
+            if (recovery.skippedSnapshots > 0) {
+                logger->log(Logger::Level::WARNING, "Skipped " + std::to_string(recovery.skippedSnapshots) +
+                            " unusable snapshots");
+            }
+            // Recovered orders are still open, so their accounts' exposure is
+            // too; the engine starts with empty books
+            if (riskChecker && !matchingEngine) {
+                orderManager->forEachOrder([&](const Order& order) { riskChecker->restoreOrder(order); });
+            }
+        }
+
+        std::unique_ptr<OrderSnapshotter> snapshotter;
+        if (journal && !serverConfig.snapshot_directory.empty()) {
+            SnapshotConfig snapshotConfig;
+            snapshotConfig.directory = serverConfig.snapshot_directory;
+            snapshotConfig.interval = serverConfig.snapshot_interval;
+            snapshotConfig.expectedOrders = serverConfig.expected_orders;
+            snapshotter = std::make_unique<OrderSnapshotter>(snapshotConfig, journal);
+        }
 
         // Initialize the server
         logger->log(Logger::Level::INFO, "Initializing trading gateway server...");
         logger->log(Logger::Level::INFO, "Configuration:");
         logger->log(Logger::Level::INFO, "  - Port: " + std::to_string(serverConfig.port));
         logger->log(Logger::Level::INFO, "  - Thread Pool Size: " + std::to_string(serverConfig.thread_pool_size));
+        logger->log(Logger::Level::INFO, "  - IO Threads: " + std::to_string(serverConfig.io_threads) +
+                    (serverConfig.io_threads > 1
+                         ? (serverConfig.reuse_port_listeners ? " (SO_REUSEPORT listeners)" : " (round-robin accept)")
+                         : ""));
         logger->log(Logger::Level::INFO, "  - Max Connections: " + std::to_string(serverConfig.max_connections));
+        logger->log(Logger::Level::INFO, "  - Order Manager Shards: " + std::to_string(orderManager->shardCount()));
+        logger->log(Logger::Level::INFO, std::string("  - Internal Matching: ") +
+                    (matchingEngine ? "enabled" : "disabled"));
+        logger->log(Logger::Level::INFO, std::string("  - Pre-trade Risk Checks: ") +
+                    (riskChecker ? "enabled" : "disabled"));
+        logger->log(Logger::Level::INFO, std::string("  - Order Path: ") +
+                    (serverConfig.order_pipeline ? "staged order pipeline" :
+                     serverConfig.single_writer_sequencer ? "single-writer sequencer" :
+                     serverConfig.bounded_ingress_queue ? "worker pool, bounded lock-free queue" : "worker pool"));
+        if (serverConfig.order_pipeline) {
+            logger->log(Logger::Level::INFO, std::string("  - Consumer Wait: decode ") +
+                        waitStrategyName(serverConfig.pipeline_decode_wait) + ", risk " +
+                        waitStrategyName(serverConfig.pipeline_risk_wait) + ", order state " +
+                        waitStrategyName(serverConfig.pipeline_order_state_wait) + ", journal " +
+                        waitStrategyName(serverConfig.pipeline_journal_wait) + ", encode " +
+                        waitStrategyName(serverConfig.pipeline_encode_wait));
+        } else {
+            logger->log(Logger::Level::INFO, std::string("  - Consumer Wait: ") +
+                        (serverConfig.single_writer_sequencer ? waitStrategyName(serverConfig.sequencer_wait) :
+                         waitStrategyName(serverConfig.ingress_wait)));
+        }
+        logger->log(Logger::Level::INFO, std::string("  - ACK After Durable: ") +
+                    (serverConfig.ack_after_durable ? "yes" : "no"));
         
-        NetworkServer server(serverConfig, orderManager, logger);
-        
-        // Start the server in a separate thread
-        std::thread serverThread([&server, &logger]() {
-            try {
-                server.start();
-            } catch (const std::exception& e) {
-                logger->log(Logger::Level::FATAL, "Server thread error: " + std::string(e.what()));
-            }
-        });
-
-        // Example of local FIX message processing
+        // Example of local FIX message processing, before the server (and in
+        // sequencer mode, the thread that owns order state) is started
         logger->log(Logger::Level::INFO, "Testing local FIX message processing...");
         FixMessageHandler fixHandler;
         
         // Example new order single message
-        std::string sampleOrder = "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
+        std::string sampleOrder = "35=D|49=SENDER|56=TARGET|11=LOCAL001|55=AAPL|54=1|44=150.50|38=100|40=2|";
         logger->log(Logger::Level::DEBUG, "Processing sample order: " + sampleOrder);
         
         auto fields = fixHandler.parseFixMessage(sampleOrder);
@@ -71,14 +172,28 @@ int main() {
             std::cout << "Tag " << key << ": " << value << std::endl;
         }
 
-        // Process the order locally
-        try {
-            orderManager->processOrder(sampleOrder);
-            logger->log(Logger::Level::INFO, "Sample order processed successfully");
-        } catch (const std::exception& e) {
-            logger->log(Logger::Level::ERROR, "Failed to process sample order: " + std::string(e.what()));
+        // Process the order locally; with a journal it would be live state the
+        // journal knows nothing of, and skip the risk check besides
+        if (!journal) {
+            try {
+                orderManager->processOrder(sampleOrder);
+                logger->log(Logger::Level::INFO, "Sample order processed successfully");
+            } catch (const std::exception& e) {
+                logger->log(Logger::Level::ERROR, "Failed to process sample order: " + std::string(e.what()));
+            }
         }
 
+        NetworkServer server(serverConfig, orderManager, logger, matchingEngine, riskChecker, journal);
+        
+        // Start the server in a separate thread
+        std::thread serverThread([&server, &logger]() {
+            try {
+                server.start();
+            } catch (const std::exception& e) {
+                logger->log(Logger::Level::FATAL, "Server thread error: " + std::string(e.what()));
+            }
+        });
+
         // Server monitoring loop
         logger->log(Logger::Level::INFO, "Server running on port " + std::to_string(serverConfig.port));
         logger->log(Logger::Level::INFO, "Press Ctrl+C to stop the server");
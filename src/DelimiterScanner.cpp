@@ -0,0 +1,122 @@
+// src/DelimiterScanner.cpp
+#include "DelimiterScanner.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GATEWAY_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd {
+namespace {
+    uint64_t maskScalar(const char* block, char a, char b) {
+        uint64_t mask = 0;
+        for (std::size_t i = 0; i < DelimiterScanner::kBlockSize; ++i) {
+            uint64_t hit = (block[i] == a) | (block[i] == b);
+            mask |= hit << i;
+        }
+        return mask;
+    }
+
+#ifdef GATEWAY_X86
+    __attribute__((target("sse2")))
+    uint64_t maskSse2(const char* block, char a, char b) {
+        const __m128i va = _mm_set1_epi8(a);
+        const __m128i vb = _mm_set1_epi8(b);
+        uint64_t mask = 0;
+        for (int i = 0; i < 4; ++i) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+            __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+            mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(hits))) << (i * 16);
+        }
+        return mask;
+    }
+
+    __attribute__((target("avx2")))
+    uint64_t maskAvx2(const char* block, char a, char b) {
+        const __m256i va = _mm256_set1_epi8(a);
+        const __m256i vb = _mm256_set1_epi8(b);
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        __m256i hitsLo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, va), _mm256_cmpeq_epi8(lo, vb));
+        __m256i hitsHi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, va), _mm256_cmpeq_epi8(hi, vb));
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hitsLo))) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hitsHi))) << 32);
+    }
+#endif
+
+    Isa detectIsa() {
+#ifdef GATEWAY_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Isa::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return Isa::SSE2;
+        }
+#endif
+        return Isa::SCALAR;
+    }
+}
+
+Isa activeIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+bool isaSupported(Isa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(activeIsa());
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR: return "scalar";
+        case Isa::SSE2:   return "sse2";
+        case Isa::AVX2:   return "avx2";
+        default:          return "unknown";
+    }
+}
+
+DelimiterMaskFn delimiterMaskFn(Isa isa) {
+    if (!isaSupported(isa)) {
+        isa = activeIsa();
+    }
+    switch (isa) {
+#ifdef GATEWAY_X86
+        case Isa::AVX2: return &maskAvx2;
+        case Isa::SSE2: return &maskSse2;
+#endif
+        default:        return &maskScalar;
+    }
+}
+} // namespace simd
+
+DelimiterScanner::DelimiterScanner(std::string_view data, char a, char b, simd::Isa isa)
+    : data_(data.data())
+    , size_(data.size())
+    , a_(a)
+    , b_(b)
+    , maskFn_(simd::delimiterMaskFn(isa)) {
+    if (size_ > 0) {
+        loadBlock();
+    }
+}
+
+void DelimiterScanner::loadBlock() {
+    std::size_t remaining = size_ - blockBase_;
+    if (remaining >= kBlockSize) {
+        mask_ = maskFn_(data_ + blockBase_, a_, b_);
+        return;
+    }
+
+    // Pad the tail with a byte that is neither delimiter so the vector path
+    // can still be used without reading past the end of the buffer
+    char filler = static_cast<char>(a_ + 1);
+    if (filler == b_) {
+        filler = static_cast<char>(b_ + 1);
+    }
+    alignas(64) char tail[kBlockSize];
+    std::memset(tail, filler, sizeof(tail));
+    std::memcpy(tail, data_ + blockBase_, remaining);
+    mask_ = maskFn_(tail, a_, b_);
+}
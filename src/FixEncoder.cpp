@@ -0,0 +1,190 @@
+// src/FixEncoder.cpp
+#include "FixEncoder.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // "00" "01" ... "99" so two digits are emitted per division
+    constexpr char kDigitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    // Writes value right-aligned so that it ends at `end`; returns the first character
+    char* writeUnsignedBackwards(char* end, uint64_t value) {
+        while (value >= 100) {
+            std::size_t pair = static_cast<std::size_t>(value % 100) * 2;
+            value /= 100;
+            *--end = kDigitPairs[pair + 1];
+            *--end = kDigitPairs[pair];
+        }
+        if (value >= 10) {
+            std::size_t pair = static_cast<std::size_t>(value) * 2;
+            *--end = kDigitPairs[pair + 1];
+            *--end = kDigitPairs[pair];
+        } else {
+            *--end = static_cast<char>('0' + value);
+        }
+        return end;
+    }
+
+    uint64_t magnitude(int64_t value) {
+        // Well defined for INT64_MIN as well
+        return value < 0 ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+    }
+}
+
+FixEncoder::FixEncoder(char* buffer, std::size_t capacity)
+    : body_(buffer + kHeaderReserve)
+    , cursor_(body_)
+    , limit_(buffer + capacity) {
+    if (capacity < kHeaderReserve + kTrailerSize) {
+        throw std::length_error("FIX encode buffer too small");
+    }
+    // BodyLength must fit in the digits reserved for it
+    if (capacity > kHeaderReserve + kMaxBodyLength + kTrailerSize) {
+        limit_ = body_ + kMaxBodyLength + kTrailerSize;
+    }
+}
+
+std::size_t FixEncoder::formatInteger(char* out, int64_t value) {
+    char scratch[20];
+    char* end = scratch + sizeof(scratch);
+    char* start = writeUnsignedBackwards(end, magnitude(value));
+    std::size_t length = 0;
+    if (value < 0) {
+        out[length++] = '-';
+    }
+    std::memcpy(out + length, start, static_cast<std::size_t>(end - start));
+    return length + static_cast<std::size_t>(end - start);
+}
+
+std::size_t FixEncoder::formatDecimal(char* out, int64_t mantissa, unsigned scale) {
+    if (scale == 0) {
+        return formatInteger(out, mantissa);
+    }
+
+    char scratch[48];
+    char* end = scratch + sizeof(scratch);
+    char* start = writeUnsignedBackwards(end, magnitude(mantissa));
+
+    // Left-pad with zeros so there is at least one integer digit
+    while (static_cast<std::size_t>(end - start) <= scale) {
+        *--start = '0';
+    }
+
+    std::size_t integerDigits = static_cast<std::size_t>(end - start) - scale;
+    std::size_t length = 0;
+    if (mantissa < 0) {
+        out[length++] = '-';
+    }
+    std::memcpy(out + length, start, integerDigits);
+    length += integerDigits;
+    out[length++] = '.';
+    std::memcpy(out + length, start + integerDigits, scale);
+    return length + scale;
+}
+
+void FixEncoder::ensure(std::size_t bytes) const {
+    // Always keep room for the trailer
+    if (static_cast<std::size_t>(limit_ - cursor_) < bytes + kTrailerSize) {
+        throw std::length_error("FIX encode buffer overflow");
+    }
+}
+
+void FixEncoder::appendRaw(const char* data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        checksum_ += static_cast<unsigned char>(data[i]);
+    }
+    std::memcpy(cursor_, data, length);
+    cursor_ += length;
+}
+
+void FixEncoder::appendTag(int tag) {
+    char digits[20];
+    std::size_t length = formatInteger(digits, tag);
+    appendRaw(digits, length);
+    appendChar('=');
+}
+
+FixEncoder& FixEncoder::begin(std::string_view msgType) {
+    cursor_ = body_;
+    checksum_ = 0;
+    return field(35, msgType);
+}
+
+FixEncoder& FixEncoder::field(int tag, std::string_view value) {
+    ensure(12 + value.size());
+    appendTag(tag);
+    appendRaw(value.data(), value.size());
+    appendChar(kDelimiter);
+    return *this;
+}
+
+FixEncoder& FixEncoder::field(int tag, char value) {
+    ensure(13);
+    appendTag(tag);
+    appendChar(value);
+    appendChar(kDelimiter);
+    return *this;
+}
+
+FixEncoder& FixEncoder::field(int tag, int64_t value) {
+    ensure(12 + 20);
+    appendTag(tag);
+    char digits[20];
+    appendRaw(digits, formatInteger(digits, value));
+    appendChar(kDelimiter);
+    return *this;
+}
+
+FixEncoder& FixEncoder::decimalField(int tag, int64_t mantissa, unsigned scale) {
+    char digits[48];
+    if (scale > sizeof(digits) - 22) {
+        throw std::invalid_argument("Unsupported decimal scale");
+    }
+    ensure(12 + 22 + scale);
+    appendTag(tag);
+    appendRaw(digits, formatDecimal(digits, mantissa, scale));
+    appendChar(kDelimiter);
+    return *this;
+}
+
+std::string_view FixEncoder::finish() {
+    // Header written right-aligned against the body: 8=<BeginString>|9=<len>|
+    char* headerEnd = body_;
+    *--headerEnd = kDelimiter;
+    headerEnd = writeUnsignedBackwards(headerEnd, bodyLength());
+    *--headerEnd = '=';
+    *--headerEnd = '9';
+    *--headerEnd = kDelimiter;
+    headerEnd -= kBeginString.size();
+    std::memcpy(headerEnd, kBeginString.data(), kBeginString.size());
+    *--headerEnd = '=';
+    *--headerEnd = '8';
+
+    char* start = headerEnd;
+    uint32_t sum = checksum_;
+    for (const char* p = start; p != body_; ++p) {
+        sum += static_cast<unsigned char>(*p);
+    }
+
+    unsigned checksum = sum % 256;
+    char* trailer = cursor_;
+    trailer[0] = '1';
+    trailer[1] = '0';
+    trailer[2] = '=';
+    trailer[3] = static_cast<char>('0' + checksum / 100);
+    trailer[4] = static_cast<char>('0' + (checksum / 10) % 10);
+    trailer[5] = static_cast<char>('0' + checksum % 10);
+    trailer[6] = kDelimiter;
+
+    return std::string_view(start, static_cast<std::size_t>(trailer + kTrailerSize - start));
+}
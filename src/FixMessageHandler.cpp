@@ -1,36 +1,47 @@
 #include "FixMessageHandler.hpp"
-#include <sstream>
-#include <map>
+#include "FixTokenizer.hpp"
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
+
+FixMessageView FixMessageHandler::parseFixMessageView(std::string_view fixMessage) const {
+    FixMessageView view;
+    fix::forEachField(fixMessage, [&view](int tag, std::string_view value) {
+        view.add(tag, value);
+    });
+    return view;
+}
 
 std::unordered_map<std::string, std::string> FixMessageHandler::parseFixMessage(const std::string& fixMessage) {
+    FixMessageView view = parseFixMessageView(fixMessage);
     std::unordered_map<std::string, std::string> fields;
-    std::istringstream stream(fixMessage);
-    std::string field;
-
-    while (std::getline(stream, field, '|')) {
-        auto delimiterPos = field.find('=');
-        if (delimiterPos == std::string::npos) {
-            throw std::invalid_argument("Invalid FIX field: " + field);
-        }
+    fields.reserve(view.size());
 
-        std::string key = field.substr(0, delimiterPos);
-        std::string value = field.substr(delimiterPos + 1);
-        fields[key] = value;
+    for (const auto& field : view) {
+        fields[std::to_string(field.tag)] = std::string(field.value);
     }
 
     return fields;
 }
 
 std::string FixMessageHandler::buildFixMessage(const std::unordered_map<std::string, std::string>& fields) {
-    // Use a map to enforce consistent ordering of keys
-    std::map<std::string, std::string> orderedFields(fields.begin(), fields.end());
-    std::ostringstream oss;
+    // Sort pointers rather than copying into a std::map to get consistent key ordering
+    using Entry = std::unordered_map<std::string, std::string>::value_type;
+    std::vector<const Entry*> orderedFields;
+    orderedFields.reserve(fields.size());
+    std::size_t length = 0;
+    for (const auto& entry : fields) {
+        orderedFields.push_back(&entry);
+        length += entry.first.size() + entry.second.size() + 2;
+    }
+    std::sort(orderedFields.begin(), orderedFields.end(),
+        [](const Entry* lhs, const Entry* rhs) { return lhs->first < rhs->first; });
 
-    for (const auto& [key, value] : orderedFields) {
-        oss << key << "=" << value << "|";
+    std::string message;
+    message.reserve(length);
+    for (const Entry* entry : orderedFields) {
+        message.append(entry->first).append(1, '=').append(entry->second).append(1, '|');
     }
 
-    return oss.str();
+    return message;
 }
-
@@ -0,0 +1,21 @@
+// src/FixedPoint.cpp
+#include "FixedPoint.hpp"
+#include "FixEncoder.hpp"
+
+std::size_t Price::format(char* out) const {
+    return FixEncoder::formatDecimal(out, mantissa, scale);
+}
+
+std::string Price::toString() const {
+    char buffer[32];
+    return std::string(buffer, format(buffer));
+}
+
+std::size_t Qty::format(char* out) const {
+    return FixEncoder::formatInteger(out, value);
+}
+
+std::string Qty::toString() const {
+    char buffer[20];
+    return std::string(buffer, format(buffer));
+}
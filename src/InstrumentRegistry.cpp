@@ -0,0 +1,153 @@
+// src/InstrumentRegistry.cpp
+#include "InstrumentRegistry.hpp"
+#include <fstream>
+#include <stdexcept>
+
+InstrumentRegistry::InstrumentRegistry(std::size_t capacity)
+    : capacity_(capacity)
+    , instruments_(std::make_unique<Instrument[]>(capacity)) {
+    if (capacity == 0 || capacity >= kUnknownInstrument) {
+        throw std::invalid_argument("Invalid instrument registry capacity");
+    }
+    std::size_t slots = 2;
+    while (slots < capacity * 2) {
+        slots <<= 1;
+    }
+    slots_ = std::make_unique<std::atomic<uint32_t>[]>(slots);
+    for (std::size_t i = 0; i < slots; ++i) {
+        slots_[i].store(0, std::memory_order_relaxed);
+    }
+    slotMask_ = slots - 1;
+}
+
+std::size_t InstrumentRegistry::probe(const SymbolCode& symbol, uint64_t hash, InstrumentId& id) const {
+    // Linear probing; entries are never removed, so the first empty slot ends the search
+    for (std::size_t pos = hash & slotMask_;; pos = (pos + 1) & slotMask_) {
+        uint32_t value = slots_[pos].load(std::memory_order_acquire);
+        if (value == 0) {
+            id = kUnknownInstrument;
+            return pos;
+        }
+        if (instruments_[value - 1].symbol == symbol) {
+            id = value - 1;
+            return pos;
+        }
+    }
+}
+
+InstrumentId InstrumentRegistry::find(std::string_view symbol) const {
+    if (!SymbolCode::fits(symbol)) {
+        return kUnknownInstrument;
+    }
+    SymbolCode code(symbol);
+    InstrumentId id;
+    probe(code, code.hash(), id);
+    return id;
+}
+
+InstrumentId InstrumentRegistry::intern(std::string_view symbol) {
+    SymbolCode code(symbol);
+    uint64_t hash = code.hash();
+    InstrumentId id;
+    probe(code, hash, id);
+    if (id != kUnknownInstrument) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    Instrument instrument;
+    instrument.symbol = code;
+    return insertLocked(instrument, hash);
+}
+
+InstrumentId InstrumentRegistry::add(const Instrument& instrument) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    uint64_t hash = instrument.symbol.hash();
+    InstrumentId existing;
+    probe(instrument.symbol, hash, existing);
+    if (existing != kUnknownInstrument) {
+        throw std::invalid_argument("Instrument already registered: " + instrument.symbol.str());
+    }
+    return insertLocked(instrument, hash);
+}
+
+InstrumentId InstrumentRegistry::insertLocked(const Instrument& instrument, uint64_t hash) {
+    // Another writer may have interned the symbol since the unlocked probe
+    InstrumentId id;
+    std::size_t pos = probe(instrument.symbol, hash, id);
+    if (id != kUnknownInstrument) {
+        return id;
+    }
+
+    uint32_t count = count_.load(std::memory_order_relaxed);
+    if (count == capacity_) {
+        throw std::length_error("Instrument registry full (" + std::to_string(capacity_) + " instruments)");
+    }
+    instruments_[count] = instrument;
+    slots_[pos].store(count + 1, std::memory_order_release);
+    count_.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+InstrumentId InstrumentRegistry::resolve(std::string_view symbol) {
+    if (!hasReferenceData()) {
+        return intern(symbol);
+    }
+    InstrumentId id = find(symbol);
+    if (id == kUnknownInstrument) {
+        throw std::invalid_argument("Unknown symbol: " + std::string(symbol));
+    }
+    return id;
+}
+
+std::size_t InstrumentRegistry::loadReferenceData(std::istream& input) {
+    std::size_t added = 0;
+    std::string line;
+    std::size_t lineNumber = 0;
+    while (std::getline(input, line)) {
+        ++lineNumber;
+        std::string_view text(line);
+        while (!text.empty() && (text.back() == '\r' || text.back() == ' ')) {
+            text.remove_suffix(1);
+        }
+        if (text.empty() || text[0] == '#') {
+            continue;
+        }
+
+        // One field more than allowed is enough to reject the line
+        std::string_view fields[5];
+        std::size_t count = 0;
+        for (std::size_t start = 0; count < 5;) {
+            std::size_t comma = text.find(',', start);
+            fields[count++] = text.substr(start, comma == std::string_view::npos ? comma : comma - start);
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            start = comma + 1;
+        }
+        if (fields[0].empty() || (count != 1 && count != 4)) {
+            throw std::invalid_argument("Invalid reference data at line " + std::to_string(lineNumber) +
+                                        ": " + line);
+        }
+
+        Instrument instrument;
+        instrument.symbol = SymbolCode(fields[0]);
+        if (count == 4) {
+            instrument.tickSize = Price::parse(fields[1]);
+            instrument.minPrice = Price::parse(fields[2]);
+            instrument.maxPrice = Price::parse(fields[3]);
+        }
+        add(instrument);
+        ++added;
+    }
+    referenceData_.store(true, std::memory_order_release);
+    return added;
+}
+
+std::size_t InstrumentRegistry::loadReferenceData(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open reference data file: " + path);
+    }
+    return loadReferenceData(file);
+}
@@ -15,6 +15,9 @@ std::string Logger::levelToString(Level level) {
 }
 
 void Logger::log(Level level, const std::string& message) {
+    if (!enabled(level)) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Get current time
@@ -1,16 +1,69 @@
 #include "MarketDataProcessor.hpp"
-#include <sstream>
+#include "DelimiterScanner.hpp"
+#include <stdexcept>
+
+MarketDataProcessor::MarketDataProcessor(std::shared_ptr<InstrumentRegistry> instruments)
+    : instruments_(instruments ? std::move(instruments) : std::make_shared<InstrumentRegistry>()) {
+}
 
 std::vector<std::string> MarketDataProcessor::process(const std::string& rawMarketData) {
     std::vector<std::string> processedData;
-    std::istringstream stream(rawMarketData);
-    std::string dataPoint;
+    std::string_view data(rawMarketData);
+    DelimiterScanner scanner(data, ',');
+    std::size_t start = 0;
 
     // Split raw market data by commas and store in the vector
-    while (std::getline(stream, dataPoint, ',')) {
-        processedData.push_back(dataPoint);
+    for (std::size_t pos = scanner.next(); pos != DelimiterScanner::npos; pos = scanner.next()) {
+        processedData.emplace_back(data.substr(start, pos - start));
+        start = pos + 1;
+    }
+    if (start < data.size()) {
+        processedData.emplace_back(data.substr(start));
     }
 
     return processedData;
 }
 
+std::size_t MarketDataProcessor::processUpdates(std::string_view rawMarketData,
+                                                std::vector<MarketDataUpdate>& updates) {
+    DelimiterScanner scanner(rawMarketData, ',');
+    std::size_t start = 0;
+    std::size_t added = 0;
+    InstrumentId instrument = kUnknownInstrument;
+    bool expectPrice = false;
+
+    auto field = [&](std::string_view text) {
+        if (!expectPrice) {
+            // A feed carries more than the gateway trades
+            instrument = instruments_->hasReferenceData() ? instruments_->find(text) : instruments_->intern(text);
+            expectPrice = true;
+            return;
+        }
+        // Parsed first, so a bad price leaves no half-filled update behind
+        Price price = Price::parse(text);
+        expectPrice = false;
+        if (instrument == kUnknownInstrument) {
+            return;
+        }
+        MarketDataUpdate& update = updates.emplace_back();
+        update.instrument = instrument;
+        update.price = price;
+        if (instrument >= lastPrices_.size()) {
+            lastPrices_.resize(instrument + 1);
+        }
+        lastPrices_[instrument] = price;
+        ++added;
+    };
+
+    for (std::size_t pos = scanner.next(); pos != DelimiterScanner::npos; pos = scanner.next()) {
+        field(rawMarketData.substr(start, pos - start));
+        start = pos + 1;
+    }
+    if (start < rawMarketData.size()) {
+        field(rawMarketData.substr(start));
+    }
+    if (expectPrice) {
+        throw std::invalid_argument("Market data symbol without a price");
+    }
+    return added;
+}
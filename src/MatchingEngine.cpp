@@ -0,0 +1,305 @@
+// src/MatchingEngine.cpp
+#include "MatchingEngine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    char ordStatusOf(const Order& order) {
+        switch (order.state) {
+            case OrderState::NEW: return fix::status::New;
+            case OrderState::PARTIALLY_FILLED: return fix::status::PartiallyFilled;
+            case OrderState::FILLED: return fix::status::Filled;
+            case OrderState::REPLACED: return fix::status::Replaced;
+            case OrderState::CANCELLED: return fix::status::Canceled;
+        }
+        return fix::status::New;
+    }
+
+    void applyFill(Order& order, Qty quantity, int64_t now) {
+        order.cumQty += quantity;
+        order.state = order.leavesQty().isZero() ? OrderState::FILLED : OrderState::PARTIALLY_FILLED;
+        order.updatedNs = now;
+    }
+
+    void validateSide(char side) {
+        if (side != fix::side::Buy && side != fix::side::Sell) {
+            throw std::invalid_argument(std::string("Unsupported side: ") + side);
+        }
+    }
+}
+
+std::string_view encodeExecutionReport(const Execution& execution, const InstrumentRegistry& instruments,
+                                       FixEncoder& encoder) {
+    char orderId[20];
+    char execId[20];
+    fix::ExecutionReport report;
+    report.orderId = std::string_view(
+        orderId, FixEncoder::formatInteger(orderId, static_cast<int64_t>(execution.orderId)));
+    report.execId = std::string_view(
+        execId, FixEncoder::formatInteger(execId, static_cast<int64_t>(execution.execId)));
+    report.clOrdId = execution.clOrdId.view();
+    report.origClOrdId = execution.origClOrdId.view();
+    report.execType = execution.execType;
+    report.ordStatus = execution.ordStatus;
+    report.symbol = instruments.symbol(execution.instrument);
+    report.side = execution.side;
+    report.orderQty = execution.orderQty;
+    report.price = execution.price;
+    report.lastQty = execution.lastQty;
+    report.lastPx = execution.lastPx;
+    report.leavesQty = execution.leavesQty;
+    report.cumQty = execution.cumQty;
+    return fix::encode(report, encoder);
+}
+
+MatchingEngine::MatchingEngine(std::size_t expectedOrders, std::shared_ptr<InstrumentRegistry> instruments)
+    : orders_(expectedOrders)
+    , index_(expectedOrders)
+    , instruments_(instruments ? std::move(instruments) : std::make_shared<InstrumentRegistry>()) {
+}
+
+void MatchingEngine::addSymbol(std::string_view symbol, const BookConfig& config) {
+    openBook(instruments_->intern(symbol), config);
+}
+
+std::size_t MatchingEngine::addBooksFromReferenceData() {
+    std::size_t opened = 0;
+    for (InstrumentId id = 0; id < instruments_->size(); ++id) {
+        const Instrument& instrument = instruments_->instrument(id);
+        if (instrument.hasPriceBand() && !book(id)) {
+            openBook(id, BookConfig{instrument.minPrice, instrument.maxPrice, instrument.tickSize});
+            ++opened;
+        }
+    }
+    return opened;
+}
+
+void MatchingEngine::openBook(InstrumentId instrument, const BookConfig& config) {
+    if (book(instrument)) {
+        throw std::invalid_argument("Book already exists for symbol: " +
+                                    std::string(instruments_->symbol(instrument)));
+    }
+    if (instrument >= books_.size()) {
+        books_.resize(instrument + 1);
+    }
+    books_[instrument] = std::make_unique<OrderBook>(config, orders_);
+}
+
+bool MatchingEngine::hasSymbol(std::string_view symbol) const {
+    return book(symbol) != nullptr;
+}
+
+const OrderBook* MatchingEngine::book(std::string_view symbol) const {
+    InstrumentId id = instruments_->find(symbol);
+    return id == kUnknownInstrument ? nullptr : book(id);
+}
+
+OrderBook& MatchingEngine::bookFor(InstrumentId instrument, std::string_view symbol) {
+    auto* found = const_cast<OrderBook*>(book(instrument));
+    if (!found) {
+        throw std::invalid_argument("Unknown symbol: " + std::string(symbol));
+    }
+    return *found;
+}
+
+uint32_t MatchingEngine::slotFor(std::string_view clOrdId) const {
+    uint32_t slot = ClOrdId::fits(clOrdId) ? index_.find(ClOrdId(clOrdId)) : OrderIndex::kNotFound;
+    if (slot == OrderIndex::kNotFound) {
+        throw std::runtime_error("Order not found: " + std::string(clOrdId));
+    }
+    return slot;
+}
+
+const Order* MatchingEngine::findOrder(std::string_view clOrdId) const {
+    if (!ClOrdId::fits(clOrdId)) {
+        return nullptr;
+    }
+    uint32_t slot = index_.find(ClOrdId(clOrdId));
+    return slot == OrderIndex::kNotFound ? nullptr : &orders_[slot];
+}
+
+void MatchingEngine::submit(const fix::NewOrderSingle& request, std::vector<Execution>& reports,
+                            AccountId account, uint32_t session) {
+    InstrumentId instrument = request.instrument == kUnknownInstrument
+        ? instruments_->find(request.symbol) : request.instrument;
+    OrderBook& book = bookFor(instrument, request.symbol);
+    validateSide(request.side);
+    if (request.orderQty.value <= 0) {
+        throw std::invalid_argument("Order quantity must be positive");
+    }
+    bool isMarket = request.ordType == fix::ord_type::Market;
+    if (!isMarket && request.ordType != fix::ord_type::Limit) {
+        throw std::invalid_argument(std::string("Unsupported OrdType: ") + request.ordType);
+    }
+    // Normalise limit prices to the book's scale; this also rejects off-tick prices
+    Price price = isMarket ? Price() : book.priceAt(book.levelFor(request.price));
+
+    ClOrdId key(request.clOrdId);
+    uint64_t hash = key.hash();
+    if (index_.find(key, hash) != OrderIndex::kNotFound) {
+        throw std::runtime_error("Order ID already exists: " + std::string(request.clOrdId));
+    }
+
+    uint32_t slot = orders_.allocate();
+    Order& order = orders_[slot];
+    order.clOrdId = key;
+    order.side = request.side;
+    order.ordType = request.ordType;
+    order.state = OrderState::NEW;
+    order.instrument = instrument;
+    order.account = account;
+    order.session = session;
+    order.orderId = nextOrderId_++;
+    order.price = price;
+    order.orderQty = request.orderQty;
+    order.createdNs = nowNanos();
+    order.updatedNs = order.createdNs;
+    index_.insert(key, hash, slot);
+
+    report(order, fix::status::New, reports);
+    match(book, slot, reports);
+    restOrCancel(book, slot, reports);
+}
+
+void MatchingEngine::cancel(const fix::OrderCancelRequest& request, std::vector<Execution>& reports) {
+    ClOrdId cancelId(request.clOrdId);
+    uint32_t slot = slotFor(request.origClOrdId);
+    Order& order = orders_[slot];
+    OrderBook& book = *books_[order.instrument];
+
+    book.unlink(slot, book.levelFor(order.price));
+    order.state = OrderState::CANCELLED;
+    order.updatedNs = nowNanos();
+
+    report(order, fix::status::Canceled, reports);
+    reports.back().clOrdId = cancelId;
+    reports.back().origClOrdId = order.clOrdId;
+    releaseOrder(slot);
+}
+
+void MatchingEngine::replace(const fix::OrderCancelReplaceRequest& request,
+                             std::vector<Execution>& reports) {
+    ClOrdId newKey(request.clOrdId);
+    uint32_t slot = slotFor(request.origClOrdId);
+    Order& order = orders_[slot];
+    OrderBook& book = *books_[order.instrument];
+
+    if (request.side != order.side) {
+        throw std::invalid_argument("Cancel/replace cannot change the side of an order");
+    }
+    if (request.orderQty <= order.cumQty) {
+        throw std::invalid_argument("Replacement quantity must exceed the filled quantity");
+    }
+    if (newKey != order.clOrdId && index_.find(newKey) != OrderIndex::kNotFound) {
+        throw std::runtime_error("Order ID already exists: " + std::string(request.clOrdId));
+    }
+    std::size_t oldLevel = book.levelFor(order.price);
+    std::size_t newLevel = request.price.isZero() ? oldLevel : book.levelFor(request.price);
+
+    ClOrdId oldKey = order.clOrdId;
+    index_.erase(oldKey);
+    order.clOrdId = newKey;
+    index_.insert(newKey, slot);
+    order.state = OrderState::REPLACED;
+    order.updatedNs = nowNanos();
+
+    if (newLevel == oldLevel && request.orderQty <= order.orderQty) {
+        // Shrinking in place keeps the order's place in the queue
+        book.reduce(oldLevel, order.orderQty - request.orderQty);
+        order.orderQty = request.orderQty;
+        report(order, fix::status::Replaced, reports);
+        reports.back().origClOrdId = oldKey;
+        return;
+    }
+
+    book.unlink(slot, oldLevel);
+    order.price = book.priceAt(newLevel);
+    order.orderQty = request.orderQty;
+    report(order, fix::status::Replaced, reports);
+    reports.back().origClOrdId = oldKey;
+    match(book, slot, reports);
+    restOrCancel(book, slot, reports);
+}
+
+void MatchingEngine::match(OrderBook& book, uint32_t slot, std::vector<Execution>& reports) {
+    Order& taker = orders_[slot];
+    bool isMarket = taker.ordType == fix::ord_type::Market;
+    std::size_t limit = isMarket ? 0 : book.levelFor(taker.price);
+
+    while (!taker.leavesQty().isZero()) {
+        std::size_t levelIndex = taker.isBuy() ? book.bestAsk() : book.bestBid();
+        if (levelIndex == OrderBook::kNoLevel) {
+            break;
+        }
+        if (!isMarket && (taker.isBuy() ? levelIndex > limit : levelIndex < limit)) {
+            break;
+        }
+
+        // Fills happen at the resting order's price, oldest order first
+        Price levelPrice = book.priceAt(levelIndex);
+        int64_t now = nowNanos();
+        while (!taker.leavesQty().isZero() && !book.level(levelIndex).empty()) {
+            uint32_t makerSlot = book.level(levelIndex).head;
+            Order& maker = orders_[makerSlot];
+            Qty quantity = std::min(taker.leavesQty(), maker.leavesQty());
+
+            applyFill(maker, quantity, now);
+            applyFill(taker, quantity, now);
+            book.reduce(levelIndex, quantity);
+
+            report(maker, ordStatusOf(maker), reports, quantity, levelPrice);
+            report(taker, ordStatusOf(taker), reports, quantity, levelPrice);
+
+            if (maker.leavesQty().isZero()) {
+                book.unlink(makerSlot, levelIndex);
+                releaseOrder(makerSlot);
+            }
+        }
+    }
+}
+
+void MatchingEngine::restOrCancel(OrderBook& book, uint32_t slot, std::vector<Execution>& reports) {
+    Order& order = orders_[slot];
+    if (order.leavesQty().isZero()) {
+        releaseOrder(slot);
+    } else if (order.ordType == fix::ord_type::Market) {
+        order.state = OrderState::CANCELLED;
+        report(order, fix::status::Canceled, reports);
+        releaseOrder(slot);
+    } else {
+        book.append(slot, book.levelFor(order.price));
+    }
+}
+
+void MatchingEngine::releaseOrder(uint32_t slot) {
+    index_.erase(orders_[slot].clOrdId);
+    orders_.release(slot);
+}
+
+void MatchingEngine::report(const Order& order, char execType, std::vector<Execution>& reports,
+                            Qty lastQty, Price lastPx) {
+    Execution& execution = reports.emplace_back();
+    execution.clOrdId = order.clOrdId;
+    execution.instrument = order.instrument;
+    execution.account = order.account;
+    execution.session = order.session;
+    execution.orderId = order.orderId;
+    execution.execId = nextExecId_++;
+    execution.execType = execType;
+    execution.ordStatus = ordStatusOf(order);
+    execution.side = order.side;
+    execution.price = order.price;
+    execution.orderQty = order.orderQty;
+    execution.lastQty = lastQty;
+    execution.lastPx = lastPx;
+    // A cancelled order has nothing left open
+    execution.leavesQty = order.state == OrderState::CANCELLED ? Qty() : order.leavesQty();
+    execution.cumQty = order.cumQty;
+}
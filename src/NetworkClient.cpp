@@ -1,11 +1,40 @@
 // src/NetworkClient.cpp
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS
 #include "NetworkClient.hpp"
+#include "BinaryProtocol.hpp"
 #include <fstream>
 #include <boost/asio/deadline_timer.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
+namespace {
+    // Value of the first `name=` field in a '|'-delimited message; empty if absent
+    std::string_view fieldValue(std::string_view message, std::string_view name) {
+        std::size_t start = 0;
+        while (start < message.size()) {
+            std::size_t end = message.find('|', start);
+            if (end == std::string_view::npos) {
+                end = message.size();
+            }
+            std::string_view field = message.substr(start, end - start);
+            if (field.substr(0, name.size()) == name) {
+                return field.substr(name.size());
+            }
+            start = end + 1;
+        }
+        return {};
+    }
+
+    // ClOrdID a response names: tag 11 of a FIX report, OrderID of an ACK or NAK
+    std::string_view respondingTo(std::string_view response) {
+        if (response.substr(0, 2) == "8=") {
+            return fieldValue(response, "11=");
+        }
+        return fieldValue(response, "OrderID=");
+    }
+}
+
 NetworkClient::NetworkClient(const network::ClientConfig& config,
                            std::shared_ptr<Logger> logger)
     : logger_(std::move(logger)), config_(config) {
@@ -39,8 +68,21 @@ bool NetworkClient::connect() {
         boost::asio::connect(*socket_, endpoints, error);
 
         if (!error) {
+            if (config_.encoding == network::Encoding::BINARY && !logOnBinary()) {
+                boost::system::error_code ignored;
+                socket_->close(ignored);
+                return false;
+            }
             connected_ = true;
             logger_->log(Logger::Level::INFO, "Successfully connected to server");
+            if (config_.pipeline_window > 0) {
+                if (!io_thread_.joinable()) {
+                    io_work_ = std::make_unique<boost::asio::executor_work_guard<
+                        boost::asio::io_context::executor_type>>(io_context_.get_executor());
+                    io_thread_ = std::thread([this] { io_context_.run(); });
+                }
+                boost::asio::post(io_context_, [this] { startReading(); });
+            }
             return true;
         }
 
@@ -54,6 +96,23 @@ bool NetworkClient::connect() {
 }
 
 void NetworkClient::disconnect() {
+    if (io_thread_.joinable()) {
+        // The I/O thread owns the socket: close it there, which fails
+        // whatever is still in flight, then let the thread finish
+        boost::asio::post(io_context_, [this] {
+            boost::system::error_code ignored;
+            socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+            socket_->close(ignored);
+        });
+        io_work_.reset();
+        io_thread_.join();
+        io_context_.restart();
+        if (connected_) {
+            connected_ = false;
+            logger_->log(Logger::Level::INFO, "Disconnected from server");
+        }
+        return;
+    }
     if (!connected_) {
         logger_->log(Logger::Level::DEBUG, "Already disconnected");
         return;
@@ -72,6 +131,9 @@ void NetworkClient::disconnect() {
 }
 
 bool NetworkClient::send(const network::Message& message) {
+    if (config_.pipeline_window > 0) {
+        return sendAsync(message).get();
+    }
     if (!connected_ && !reconnect()) {
         return false;
     }
@@ -87,6 +149,13 @@ bool NetworkClient::send(const network::Message& message) {
 }
 
 std::future<bool> NetworkClient::sendAsync(const network::Message& message) {
+    if (config_.pipeline_window > 0) {
+        auto result = std::make_shared<std::promise<bool>>();
+        if (!sendPipelined(message, [result](bool accepted, const std::string&) { result->set_value(accepted); })) {
+            result->set_value(false);
+        }
+        return result->get_future();
+    }
     return std::async(std::launch::async, [this, message]() {
         logger_->log(Logger::Level::DEBUG, "Starting async message send");
         bool result = send(message);
@@ -109,6 +178,37 @@ bool NetworkClient::sendFile(const std::string& filepath, network::Message::Type
     size_t successCount = 0;
     std::string line;
 
+    if (config_.pipeline_window > 0) {
+        // No pacing: the window is what keeps the server from being overwhelmed
+        std::atomic<size_t> accepted{0};
+        while (std::getline(file, line)) {
+            ++lineCount;
+            if (line.empty()) {
+                continue;
+            }
+            size_t lineNumber = lineCount;
+            bool queued = sendPipelined(network::Message(type, line),
+                [this, &accepted, lineNumber](bool ok, const std::string& response) {
+                    if (ok) {
+                        accepted.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        logger_->log(Logger::Level::ERROR, "Line " + std::to_string(lineNumber) +
+                                     " rejected: " + response);
+                    }
+                });
+            if (!queued) {
+                logger_->log(Logger::Level::ERROR, "Failed to send line " +
+                             std::to_string(lineCount) + " from file");
+            }
+        }
+        flush();
+        successCount = accepted.load();
+        logger_->log(Logger::Level::INFO,
+            "File sending completed. Successfully sent " + std::to_string(successCount) +
+            " of " + std::to_string(lineCount) + " lines");
+        return successCount == lineCount;
+    }
+
     while (std::getline(file, line)) {
         ++lineCount;
         if (line.empty()) {
@@ -134,11 +234,83 @@ bool NetworkClient::sendFile(const std::string& filepath, network::Message::Type
     return successCount == lineCount;
 }
 
+bool NetworkClient::logOnBinary() {
+    std::string logon = "35=A|" + std::to_string(fix::tag::WireEncoding) + "=BINARY|\n";
+    boost::system::error_code error;
+    boost::asio::write(*socket_, boost::asio::buffer(logon), error);
+
+    // The Logon is answered in text; binary starts after it
+    boost::asio::streambuf reply;
+    if (!error) {
+        boost::asio::read_until(*socket_, reply, '\n', error);
+    }
+    if (error) {
+        handleError("Logon error: " + error.message());
+        return false;
+    }
+    std::string response{boost::asio::buffers_begin(reply.data()),
+                         boost::asio::buffers_begin(reply.data()) + reply.size() - 1};
+    if (response.substr(0, 3) != "ACK") {
+        handleError("Logon rejected: " + response);
+        return false;
+    }
+    logger_->log(Logger::Level::INFO, "Logged on for binary messages");
+    return true;
+}
+
+void NetworkClient::encodeRequest(const network::Message& message, std::string& out) const {
+    if (config_.encoding == network::Encoding::BINARY) {
+        binary::appendFromFix(message.payload, out);
+    } else {
+        out += message.payload;
+        out += '\n';
+    }
+}
+
+bool NetworkClient::readResponse(std::string& response, boost::system::error_code& error) {
+    if (config_.encoding == network::Encoding::BINARY) {
+        // The header first, for the length of the rest
+        binary::ExecutionReport report;
+        auto* bytes = reinterpret_cast<char*>(&report);
+        boost::asio::read(*socket_, boost::asio::buffer(bytes, sizeof(binary::MessageHeader)), error);
+        if (error) {
+            return false;
+        }
+        if (report.header.length != sizeof report ||
+            binary::templateId(std::string_view(bytes, sizeof(binary::MessageHeader))) !=
+                binary::ExecutionReport::kTemplateId) {
+            throw std::runtime_error("Unexpected binary response");
+        }
+        boost::asio::read(*socket_, boost::asio::buffer(bytes + sizeof(binary::MessageHeader),
+                                                        sizeof report - sizeof(binary::MessageHeader)), error);
+        if (error) {
+            return false;
+        }
+        response = binary::describe(report);
+        return true;
+    }
+
+    boost::asio::streambuf response_buffer;
+    boost::asio::read_until(*socket_, response_buffer, '\n', error);
+    if (error) {
+        return false;
+    }
+    response.assign(boost::asio::buffers_begin(response_buffer.data()),
+                    boost::asio::buffers_begin(response_buffer.data()) +
+                        response_buffer.size() - 1);  // -1 to remove newline
+    return true;
+}
+
 bool NetworkClient::sendInternal(const network::Message& message) {
+    std::string data;
     try {
-        // Prepare the message with a delimiter
-        std::string data = message.payload + "\n";
+        encodeRequest(message, data);
+    } catch (const std::exception& e) {
+        handleError("Encode error: " + std::string(e.what()));
+        return false;
+    }
 
+    try {
         // Send the message
         boost::system::error_code error;
         boost::asio::write(*socket_, boost::asio::buffer(data), error);
@@ -149,22 +321,21 @@ bool NetworkClient::sendInternal(const network::Message& message) {
             return false;
         }
 
-        // Wait for and read the response
-        boost::asio::streambuf response_buffer;
-        boost::asio::read_until(*socket_, response_buffer, '\n', error);
-
-        if (error) {
-            handleError("Read error: " + error.message());
-            return false;
+        // Wait for and read the response, passing on reports for other orders
+        std::string_view clOrdId = fieldValue(message.payload, "11=");
+        std::string response;
+        for (;;) {
+            if (!readResponse(response, error)) {
+                handleError("Read error: " + error.message());
+                return false;
+            }
+            std::string_view answering = respondingTo(response);
+            if (answering.empty() || answering == clOrdId) {
+                break;
+            }
+            unsolicitedReport(response);
         }
 
-        // Process the response
-        std::string response{
-            boost::asio::buffers_begin(response_buffer.data()),
-            boost::asio::buffers_begin(response_buffer.data()) +
-                response_buffer.size() - 1  // -1 to remove newline
-        };
-
         // Log and handle the response
         if (response.substr(0, 3) == "ACK") {
             logger_->log(Logger::Level::INFO, "Server acknowledged message: " + response);
@@ -181,6 +352,205 @@ bool NetworkClient::sendInternal(const network::Message& message) {
     }
 }
 
+bool NetworkClient::sendPipelined(const network::Message& message, ResponseHandler onResponse) {
+    if (config_.pipeline_window == 0) {
+        handleError("Pipelined send needs a pipeline window");
+        return false;
+    }
+    if (!connected_ && !reconnect()) {
+        return false;
+    }
+
+    bool scheduleWrite = false;
+    {
+        std::unique_lock<std::mutex> lock(pipeline_mutex_);
+        window_open_.wait(lock, [this] { return in_flight_.size() < config_.pipeline_window || !connected_; });
+        if (!connected_) {
+            return false;
+        }
+        try {
+            encodeRequest(message, outbound_);
+        } catch (const std::exception& e) {
+            lock.unlock();
+            handleError("Encode error: " + std::string(e.what()));
+            return false;
+        }
+        in_flight_.push_back(PendingRequest{std::string(fieldValue(message.payload, "11=")), std::move(onResponse)});
+        // Requests sent while a write is in progress go out together in the next one
+        scheduleWrite = !write_scheduled_;
+        write_scheduled_ = true;
+    }
+    if (scheduleWrite) {
+        boost::asio::post(io_context_, [this] { startWriting(); });
+    }
+    return true;
+}
+
+void NetworkClient::setUnsolicitedReportHandler(ReportHandler onReport) {
+    on_unsolicited_report_ = std::move(onReport);
+}
+
+void NetworkClient::unsolicitedReport(const std::string& report) {
+    if (on_unsolicited_report_) {
+        on_unsolicited_report_(report);
+    } else {
+        logger_->log(Logger::Level::INFO, "Unsolicited report: " + report);
+    }
+}
+
+void NetworkClient::flush() {
+    std::unique_lock<std::mutex> lock(pipeline_mutex_);
+    window_open_.wait(lock, [this] { return in_flight_.empty() && answering_ == 0; });
+}
+
+size_t NetworkClient::inFlight() const {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    return in_flight_.size();
+}
+
+void NetworkClient::startWriting() {
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        if (outbound_.empty()) {
+            write_scheduled_ = false;
+            return;
+        }
+        writing_.clear();
+        writing_.swap(outbound_);
+    }
+    boost::asio::async_write(*socket_, boost::asio::buffer(writing_),
+        [this](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+            if (error) {
+                failInFlight("Write error: " + error.message(), error != boost::asio::error::operation_aborted);
+                return;
+            }
+            startWriting();
+        });
+}
+
+void NetworkClient::startReading() {
+    if (config_.encoding == network::Encoding::BINARY) {
+        boost::asio::async_read(*socket_, read_buffer_, boost::asio::transfer_at_least(1),
+            [this](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+                if (error) {
+                    failInFlight("Read error: " + error.message(), error != boost::asio::error::operation_aborted);
+                    return;
+                }
+                try {
+                    completeBinaryRequests();
+                } catch (const std::exception& e) {
+                    failInFlight("Read error: " + std::string(e.what()), true);
+                    return;
+                }
+                startReading();
+            });
+        return;
+    }
+    boost::asio::async_read_until(*socket_, read_buffer_, '\n',
+        [this](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+            if (error) {
+                failInFlight("Read error: " + error.message(), error != boost::asio::error::operation_aborted);
+                return;
+            }
+            // Answer every complete response that arrived with this read
+            std::string_view received(static_cast<const char*>(read_buffer_.data().data()), read_buffer_.size());
+            std::size_t consumed = 0;
+            for (std::size_t end; (end = received.find('\n', consumed)) != std::string_view::npos; consumed = end + 1) {
+                completeRequest(received.substr(consumed, end - consumed));
+            }
+            read_buffer_.consume(consumed);
+            startReading();
+        });
+}
+
+void NetworkClient::completeBinaryRequests() {
+    std::string_view received(static_cast<const char*>(read_buffer_.data().data()), read_buffer_.size());
+    std::size_t consumed = 0;
+    while (received.size() - consumed >= sizeof(binary::MessageHeader)) {
+        std::string_view unread = received.substr(consumed);
+        std::size_t length = reinterpret_cast<const binary::MessageHeader*>(unread.data())->length;
+        if (unread.size() < length) {
+            break;
+        }
+        if (binary::templateId(unread) != binary::ExecutionReport::kTemplateId) {
+            throw std::invalid_argument("Unexpected binary response");
+        }
+        // Throws for a length too short to be a report, so the loop always advances
+        completeRequest(binary::describe(binary::overlay<binary::ExecutionReport>(unread.substr(0, length))));
+        consumed += length;
+    }
+    read_buffer_.consume(consumed);
+}
+
+void NetworkClient::completeRequest(std::string_view response) {
+    ResponseHandler onResponse;
+    bool answered = false;
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        auto request = in_flight_.end();
+        std::string_view clOrdId = respondingTo(response);
+        if (!clOrdId.empty()) {
+            request = std::find_if(in_flight_.begin(), in_flight_.end(),
+                                   [clOrdId](const PendingRequest& pending) { return pending.clOrdId == clOrdId; });
+        } else if (response.substr(0, 3) == "NAK" && !in_flight_.empty()) {
+            request = in_flight_.begin();
+        }
+        if (request != in_flight_.end()) {
+            answered = true;
+            onResponse = std::move(request->onResponse);
+            in_flight_.erase(request);
+            ++answering_;
+        }
+    }
+    if (!answered) {
+        // A report for an order with nothing in flight, e.g. a fill of one that rests
+        if (!respondingTo(response).empty()) {
+            unsolicitedReport(std::string(response));
+        } else {
+            logger_->log(Logger::Level::WARNING, "Unexpected response: " + std::string(response));
+        }
+        return;
+    }
+    window_open_.notify_all();
+    if (onResponse) {
+        onResponse(response.substr(0, 3) == "ACK", std::string(response));
+    }
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        --answering_;
+    }
+    window_open_.notify_all();
+}
+
+void NetworkClient::failInFlight(const std::string& error, bool unexpected) {
+    std::deque<PendingRequest> failed;
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        failed.swap(in_flight_);
+        outbound_.clear();
+        write_scheduled_ = false;
+        connected_ = false;
+        ++answering_;
+    }
+    window_open_.notify_all();
+    if (unexpected) {
+        handleError(error);
+    }
+    boost::system::error_code ignored;
+    socket_->close(ignored);
+    read_buffer_.consume(read_buffer_.size());
+    for (auto& request : failed) {
+        if (request.onResponse) {
+            request.onResponse(false, error);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(pipeline_mutex_);
+        --answering_;
+    }
+    window_open_.notify_all();
+}
+
 bool NetworkClient::reconnect() {
     logger_->log(Logger::Level::INFO, "Attempting to reconnect...");
 
@@ -1,21 +1,132 @@
 // src/NetworkServer.cpp
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS
 #include "NetworkServer.hpp"
+#include "BinaryProtocol.hpp"
+#include "FixEncoder.hpp"
+#include "FixSchema.hpp"
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/bind.hpp>
 #include <chrono>
+#include <cstring>
 #include <iostream>
-#include <sstream>
+
+namespace {
+#ifdef SO_REUSEPORT
+    using ReusePort = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+    // Messages a worker takes from the bounded ingress queue at a time
+    constexpr std::size_t kIngressBatch = 32;
+    // Room for one encoded ExecutionReport, with every id and text field full
+    constexpr std::size_t kReportBufferSize = 512;
+
+    int64_t steadyNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void appendInteger(std::string& out, int64_t value) {
+        char digits[20];
+        out.append(digits, FixEncoder::formatInteger(digits, value));
+    }
+
+    void appendPrice(std::string& out, const Price& price) {
+        char digits[32];
+        out.append(digits, price.format(digits));
+    }
+
+    void enforce(RiskCheck check) {
+        if (check != RiskCheck::PASSED) {
+            throw std::runtime_error(std::string("Risk check failed: ") + riskCheckName(check));
+        }
+    }
+
+    // OrdStatus of the request's own order from its last report after matching
+    char statusAfterMatching(const std::vector<Execution>& reports, std::string_view clOrdId, Qty& filledQty) {
+        for (auto it = reports.rbegin(); it != reports.rend(); ++it) {
+            if (it->clOrdId.view() != clOrdId) {
+                continue;
+            }
+            filledQty = it->cumQty;
+            switch (it->ordStatus) {
+                case fix::status::PartiallyFilled:
+                case fix::status::Filled:
+                case fix::status::Canceled:
+                case fix::status::Replaced:
+                    return it->ordStatus;
+                default:
+                    return fix::status::New;
+            }
+        }
+        return fix::status::New;
+    }
+}
 
 NetworkServer::NetworkServer(const network::ServerConfig& config,
                            std::shared_ptr<OrderManager> orderManager,
-                           std::shared_ptr<Logger> logger)
-    : acceptor_(io_context_, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), config.port))
+                           std::shared_ptr<Logger> logger,
+                           std::shared_ptr<MatchingEngine> matchingEngine,
+                           std::shared_ptr<RiskChecker> riskChecker,
+                           std::shared_ptr<OrderJournal> journal)
+    : acceptor_(io_context_)
     , order_manager_(std::move(orderManager))
     , logger_(std::move(logger))
+    , matching_engine_(std::move(matchingEngine))
+    , risk_checker_(std::move(riskChecker))
+    , journal_(std::move(journal))
+    // Shares the order manager's registry, and keeps it alive the same way
+    , market_data_(std::shared_ptr<InstrumentRegistry>(order_manager_, &order_manager_->instruments()))
     , config_(config) {
     
-    message_queue_ = std::make_shared<MessageQueue<network::Message>>();
+    // Decoded instrument ids are resolved once and used by both components
+    if ((matching_engine_ && &matching_engine_->instruments() != &order_manager_->instruments()) ||
+        (risk_checker_ && &risk_checker_->instruments() != &order_manager_->instruments())) {
+        throw std::invalid_argument("OrderManager, MatchingEngine and RiskChecker must share an InstrumentRegistry");
+    }
+    if (config.order_pipeline && (matching_engine_ || config.single_writer_sequencer)) {
+        throw std::invalid_argument("The order pipeline runs without the matching engine or the sequencer");
+    }
+    // Both own the order state that the engine's books replace
+    if (config.single_writer_sequencer && matching_engine_) {
+        throw std::invalid_argument("The sequencer runs without the matching engine");
+    }
+    // Several workers apply requests in whatever order they pop them, so a
+    // journal written in arrival order would replay to a different state
+    if (journal_ && !config.single_writer_sequencer && !config.order_pipeline && !matching_engine_) {
+        throw std::invalid_argument("The journal needs the sequencer, the order pipeline or the matching engine");
+    }
+
+    // Every io thread listens on the same port with SO_REUSEPORT; without it,
+    // the first one accepts for all of them
+    bool reusePort = config.io_threads > 1 && config.reuse_port_listeners;
+#ifndef SO_REUSEPORT
+    reusePort = false;
+#endif
+    listen(acceptor_, config.port, reusePort);
+    for (size_t i = 1; i < config.io_threads; ++i) {
+        auto io = std::make_unique<IoThread>();
+        if (reusePort) {
+            io->acceptor = std::make_unique<boost::asio::ip::tcp::acceptor>(io->context);
+            listen(*io->acceptor, port(), true);
+        }
+        io_threads_.push_back(std::move(io));
+    }
+    deal_connections_ = !io_threads_.empty() && !reusePort;
+
+    message_queue_ = std::make_shared<MessageQueue<network::Message>>(config.ingress_wait);
+    // Only the worker pool takes decoded requests, through either queue
+    if (!config.single_writer_sequencer && !config.order_pipeline && !matching_engine_) {
+        decoded_messages_ = std::make_unique<MessagePool<DecodedRequest>>(config.decoded_message_pool);
+        if (config.bounded_ingress_queue) {
+            bounded_queue_ = std::make_unique<MpmcQueue<network::Message>>(config.ingress_queue_capacity,
+                                                                          config.ingress_wait);
+        }
+    }
     worker_threads_.reserve(config.thread_pool_size);
 }
 
@@ -32,17 +143,50 @@ void NetworkServer::start() {
     running_ = true;
     logger_->log(Logger::Level::INFO, "Starting server on port " + std::to_string(config_.port));
     
-    // Start worker threads
-    for (size_t i = 0; i < config_.thread_pool_size; ++i) {
-        worker_threads_.emplace_back([this] { processMessages(); });
+    if (config_.order_pipeline) {
+        PipelineConfig pipelineConfig;
+        pipelineConfig.capacity = config_.pipeline_capacity;
+        pipelineConfig.wait = {config_.pipeline_decode_wait, config_.pipeline_risk_wait,
+                               config_.pipeline_order_state_wait, config_.pipeline_journal_wait,
+                               config_.pipeline_encode_wait};
+        pipelineConfig.ackAfterDurable = config_.ack_after_durable;
+        pipelineConfig.onResponse = [this](const PipelineEvent& event) { answerFromPipeline(event); };
+        pipeline_ = std::make_unique<OrderPipeline>(pipelineConfig, order_manager_, journal_, risk_checker_);
+        logger_->log(Logger::Level::INFO, "Started order pipeline");
+    } else if (config_.single_writer_sequencer) {
+        SequencerConfig sequencerConfig;
+        sequencerConfig.capacity = config_.sequencer_capacity;
+        sequencerConfig.cpu = config_.sequencer_cpu;
+        sequencerConfig.wait = config_.sequencer_wait;
+        sequencer_ = std::make_unique<OrderSequencer>(sequencerConfig, order_manager_, journal_, risk_checker_);
+        logger_->log(Logger::Level::INFO, "Started single-writer order sequencer");
+    } else {
+        // Start worker threads
+        for (size_t i = 0; i < config_.thread_pool_size; ++i) {
+            worker_threads_.emplace_back([this] { processMessages(); });
+        }
+        logger_->log(Logger::Level::INFO, "Started " + std::to_string(config_.thread_pool_size) + " worker threads");
     }
-    logger_->log(Logger::Level::INFO, "Started " + std::to_string(config_.thread_pool_size) + " worker threads");
 
     // Start accepting connections
-    startAccept();
+    for (auto& io : io_threads_) {
+        if (io->acceptor) {
+            startAccept(*io->acceptor, io->context, io->acceptMemory);
+        }
+        io->thread = std::thread([this, &io = *io] { runIoContext(io.context); });
+    }
+    startAccept(acceptor_, io_context_, accept_memory_);
+    if (!io_threads_.empty()) {
+        logger_->log(Logger::Level::INFO, "Started " + std::to_string(io_threads_.size() + 1) + " io threads" +
+                     (deal_connections_ ? ", connections dealt round-robin" : " with SO_REUSEPORT listeners"));
+    }
+
+    runIoContext(io_context_);
+}
 
+void NetworkServer::runIoContext(boost::asio::io_context& context) {
     try {
-        io_context_.run();
+        context.run();
     } catch (const std::exception& e) {
         logger_->log(Logger::Level::ERROR, "IO context error: " + std::string(e.what()));
         handleError(e.what());
@@ -55,10 +199,22 @@ void NetworkServer::stop() {
     logger_->log(Logger::Level::INFO, "Stopping server...");
     running_ = false;
     message_queue_->stop();
+    if (bounded_queue_) {
+        bounded_queue_->stop();
+    }
     
     // Stop accepting new connections
     acceptor_.close();
     io_context_.stop();
+    for (auto& io : io_threads_) {
+        io->context.stop();
+        if (io->thread.joinable()) {
+            io->thread.join();
+        }
+        if (io->acceptor) {
+            io->acceptor->close();
+        }
+    }
 
     // Wait for all worker threads to finish
     for (auto& thread : worker_threads_) {
@@ -67,25 +223,71 @@ void NetworkServer::stop() {
         }
     }
     worker_threads_.clear();
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions_.clear();
+    }
+    // Applies whatever was already published before stopping
+    sequencer_.reset();
+    pipeline_.reset();
 
     logger_->log(Logger::Level::INFO, "Server stopped");
 }
 
-void NetworkServer::startAccept() {
-    auto socket = std::make_shared<boost::asio::ip::tcp::socket>(io_context_);
-    
-    acceptor_.async_accept(*socket,
-        [this, socket](const boost::system::error_code& error) {
+void NetworkServer::listen(boost::asio::ip::tcp::acceptor& acceptor, uint16_t port, bool reusePort) {
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+#ifdef SO_REUSEPORT
+    if (reusePort) {
+        acceptor.set_option(ReusePort(true));
+    }
+#endif
+    acceptor.bind(endpoint);
+    acceptor.listen();
+}
+
+uint16_t NetworkServer::port() const {
+    return acceptor_.local_endpoint().port();
+}
+
+void NetworkServer::startAccept(boost::asio::ip::tcp::acceptor& acceptor, boost::asio::io_context& home,
+                                HandlerMemory& memory) {
+    boost::asio::io_context* owner = &home;
+    if (deal_connections_) {
+        size_t next = next_io_thread_.fetch_add(1, std::memory_order_relaxed) % (io_threads_.size() + 1);
+        owner = next == 0 ? &io_context_ : &io_threads_[next - 1]->context;
+    }
+
+    // The socket belongs to its owner's io_context from the start
+    acceptor.async_accept(*owner, allocatingHandler(memory,
+        [this, &acceptor, &home, &memory](const boost::system::error_code& error, boost::asio::ip::tcp::socket peer) {
             if (!error) {
-                if (stats_.active_connections < config_.max_connections) {
-                    handleClient(socket);
-                    {
-                        std::lock_guard<std::mutex> lock(stats_mutex_);
+                bool accepted = false;
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    if (stats_.active_connections < config_.max_connections) {
+                        accepted = true;
                         ++stats_.active_connections;
                         logger_->log(Logger::Level::DEBUG, 
                             "New client connected. Active connections: " + 
                             std::to_string(stats_.active_connections));
                     }
+                }
+                if (accepted) {
+                    ConnectionPtr connection(new Connection(std::move(peer), config_.receive_buffer_size));
+                    // ACKs go out as soon as they are written, not held back by Nagle
+                    boost::system::error_code ignored;
+                    connection->socket.set_option(boost::asio::ip::tcp::no_delay(true), ignored);
+                    if (matching_engine_) {
+                        std::lock_guard<std::mutex> lock(sessions_mutex_);
+                        connection->session = next_session_++;
+                        sessions_.emplace(connection->session, connection);
+                    }
+                    // Reads start on the thread that owns the connection
+                    boost::asio::dispatch(connection->socket.get_executor(), [this, connection] {
+                        handleClient(connection);
+                    });
                 } else {
                     logger_->log(Logger::Level::WARNING, 
                         "Max connections reached (" + 
@@ -97,119 +299,585 @@ void NetworkServer::startAccept() {
             }
             
             if (running_) {
-                startAccept();
+                startAccept(acceptor, home, memory);
             }
-        });
+        }));
 }
 
-void NetworkServer::handleClient(std::shared_ptr<boost::asio::ip::tcp::socket> socket) {
-    auto buffer = std::make_shared<boost::asio::streambuf>();
-    
-    boost::asio::async_read_until(*socket, *buffer, '\n',
-        [this, socket, buffer](const boost::system::error_code& error, std::size_t bytes_transferred) {
+void NetworkServer::handleClient(ConnectionPtr connection) {
+    // Takes whatever has arrived, up to the free space, in one read
+    Connection& client = *connection;
+    ReceiveBuffer& received = client.received;
+    client.socket.async_read_some(boost::asio::buffer(received.writeData(), received.writeSize()),
+        allocatingHandler(client.readMemory,
+        [this, connection = std::move(connection)](const boost::system::error_code& error, std::size_t bytes_transferred) {
+            ReceiveBuffer& received = connection->received;
             if (!error) {
-                std::string data{
-                    boost::asio::buffers_begin(buffer->data()),
-                    boost::asio::buffers_begin(buffer->data()) + bytes_transferred - 1
-                };
-                
-                logger_->log(Logger::Level::DEBUG, "Received message: " + data);
-                
-                // Process the message and get the result
-                std::string response = processMessageAndGetResponse(data);
-                
-                // Send acknowledgment back to client
-                sendResponse(socket, response);
-                
-                // Continue reading from this client
-                handleClient(socket);
-            } else {
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                --stats_.active_connections;
-                logger_->log(Logger::Level::DEBUG, 
-                    "Client disconnected. Active connections: " + 
-                    std::to_string(stats_.active_connections));
+                received.commit(bytes_transferred);
+                socket_reads_.fetch_add(1, std::memory_order_relaxed);
+                if (connection->encoding == network::Encoding::TEXT) {
+                    received.consumeFrames('\n', [&](std::string_view data) {
+                        if (logger_->enabled(Logger::Level::DEBUG)) {
+                            logger_->log(Logger::Level::DEBUG, "Received message: " + std::string(data));
+                        }
+
+                        if (pipeline_ && fix::messageType(data) == fix::Logon::kMsgType) {
+                            logonThroughPipeline(data, connection);
+                        } else if (pipeline_) {
+                            // Answered from the pipeline's encode stage; the
+                            // event holds the connection until then
+                            pipeline_->publish(data, connection);
+                        } else {
+                            // Process the message and queue the result for the client
+                            processMessageAndGetResponse(data, *connection);
+                        }
+                        // After a Logon to binary, the rest is framed by length
+                        return connection->encoding == network::Encoding::TEXT;
+                    });
+                }
+                if (connection->encoding == network::Encoding::BINARY) {
+                    received.consumeMessages([&](std::string_view data) {
+                        if (pipeline_) {
+                            pipeline_->publish(data, connection, PipelineRequest::BINARY);
+                        } else {
+                            processBinaryMessage(data, *connection);
+                        }
+                    });
+                }
+                // The ACKs for everything this read brought in go out together
+                startWrite(connection);
+
+                if (!received.full()) {
+                    // Continue reading from this client
+                    handleClient(connection);
+                    return;
+                }
+                handleError("Message longer than the " + std::to_string(received.capacity()) +
+                            " byte receive buffer; closing connection");
+                boost::system::error_code ignored;
+                connection->socket.close(ignored);
             }
-        });
+
+            if (connection->session != 0) {
+                // Reports for its resting orders have nowhere to go from here on
+                std::lock_guard<std::mutex> lock(sessions_mutex_);
+                sessions_.erase(connection->session);
+            }
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            --stats_.active_connections;
+            logger_->log(Logger::Level::DEBUG, 
+                "Client disconnected. Active connections: " + 
+                std::to_string(stats_.active_connections));
+        }));
 }
 
-void NetworkServer::sendResponse(std::shared_ptr<boost::asio::ip::tcp::socket> socket, 
-                               const std::string& response) {
-    auto response_buffer = std::make_shared<std::string>(response + "\n");
-    
-    boost::asio::async_write(*socket, 
-        boost::asio::buffer(*response_buffer),
-        [this, socket, response_buffer](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+void NetworkServer::sendResponse(const ConnectionPtr& connection, std::string_view response) {
+    connection->outbound.append(response, '\n');
+    startWrite(connection);
+}
+
+void NetworkServer::logonThroughPipeline(std::string_view data, const ConnectionPtr& connection) {
+    std::string& response = connection->response;
+    response.clear();
+    try {
+        logon(fix::decode<fix::Logon>(data), *connection);
+    } catch (const std::exception& e) {
+        logger_->log(Logger::Level::ERROR, "Message processing error: " + std::string(e.what()));
+        response.assign("NAK|Error=").append(e.what());
+    }
+    pipeline_->publish(response, connection, PipelineRequest::RESPONSE);
+}
+
+void NetworkServer::answerFromPipeline(const PipelineEvent& event) {
+    if (event.context) {
+        auto& connection = static_cast<Connection&>(*event.context);
+        bool handOff;
+        {
+            std::lock_guard<std::mutex> lock(connection.answeredMutex);
+            handOff = connection.answered.empty();
+            connection.answered.append(event.response);
+            // Binary reports carry their own length
+            if (event.kind != PipelineRequest::BINARY) {
+                connection.answered.push_back('\n');
+            }
+        }
+        // Responses that arrive before the io thread takes these ride along
+        // with them; writes belong on the connection's io thread
+        if (handOff) {
+            boost::asio::post(connection.socket.get_executor(),
+                allocatingHandler(connection.answeredMemory, [this, client = ConnectionPtr(&connection)] {
+                    takePipelineResponses(client);
+                }));
+        }
+    }
+    // A Logon is not counted on the other paths either
+    if (!event.rejected && event.kind != PipelineRequest::RESPONSE) {
+        messages_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void NetworkServer::takePipelineResponses(const ConnectionPtr& connection) {
+    std::string& taken = connection->answeredTaken;
+    {
+        std::lock_guard<std::mutex> lock(connection->answeredMutex);
+        taken.swap(connection->answered);
+    }
+    connection->outbound.append(taken);
+    taken.clear();
+    startWrite(connection);
+}
+
+void NetworkServer::startWrite(const ConnectionPtr& connection) {
+    OutboundQueue& outbound = connection->outbound;
+    // Responses queued meanwhile go out in one gather write after this one
+    if (outbound.writing() || outbound.empty()) {
+        return;
+    }
+    boost::asio::async_write(connection->socket, outbound.beginWrite(),
+        allocatingHandler(connection->writeMemory,
+        [this, connection](const boost::system::error_code& error, std::size_t /*bytes_transferred*/) {
+            connection->outbound.endWrite();
             if (error) {
                 logger_->log(Logger::Level::ERROR, "Failed to send response: " + error.message());
+                return;
             }
-        });
+            socket_writes_.fetch_add(1, std::memory_order_relaxed);
+            startWrite(connection);
+        }));
 }
 
-std::string NetworkServer::processMessageAndGetResponse(const std::string& data) {
+void NetworkServer::processMessageAndGetResponse(std::string_view data, Connection& connection) {
+    std::string& response = connection.response;
+    response.clear();
     try {
         auto start_time = std::chrono::steady_clock::now();
-        
-        network::Message msg(network::Message::Type::FIX, data);
-        message_queue_->push(msg);
-
-        // Extract orderId from FIX message for the response
-        FixMessageHandler fixHandler;
-        auto fields = fixHandler.parseFixMessage(data);
-        std::string orderId = fields["11"]; // ClOrdID
-        std::string symbol = fields["55"];  // Symbol
-        std::string side = fields["54"];    // Side
-        std::string quantity = fields["38"]; // OrderQty
-        std::string price = fields["44"];    // Price
+
+        // Decode straight into the typed message for its MsgType; this also
+        // validates required tags before the order is queued. The response is
+        // built in place, without a stream or temporary strings.
+        std::string_view msgType = fix::messageType(data);
+        if (msgType == fix::NewOrderSingle::kMsgType) {
+            auto order = fix::decode<fix::NewOrderSingle>(data, order_manager_->instruments());
+            Qty filledQty;
+            char status = handleNewOrder(order, filledQty, connection.session);
+            response.append("ACK|OrderID=").append(order.clOrdId)
+                    .append("|Symbol=").append(order.symbol)
+                    .append("|Side=").append(order.side == '1' ? "BUY" : "SELL")
+                    .append("|Quantity=");
+            appendInteger(response, order.orderQty.value);
+            response.append("|Price=");
+            appendPrice(response, order.price);
+            response.append("|Status=").append(binary::ackStatus(status)).append("|");
+            if (matching_engine_) {
+                response.append("FilledQty=");
+                appendInteger(response, filledQty.value);
+                response.append("|");
+            }
+        } else if (msgType == fix::OrderCancelRequest::kMsgType) {
+            auto cancel = fix::decode<fix::OrderCancelRequest>(data, order_manager_->instruments());
+            handleCancel(cancel);
+            response.append("ACK|OrderID=").append(cancel.clOrdId)
+                    .append("|OrigOrderID=").append(cancel.origClOrdId)
+                    .append("|Status=CANCEL_ACCEPTED|");
+        } else if (msgType == fix::OrderCancelReplaceRequest::kMsgType) {
+            auto replace = fix::decode<fix::OrderCancelReplaceRequest>(data, order_manager_->instruments());
+            Qty filledQty;
+            char status = handleReplace(replace, filledQty);
+            response.append("ACK|OrderID=").append(replace.clOrdId)
+                    .append("|OrigOrderID=").append(replace.origClOrdId)
+                    .append("|Symbol=").append(replace.symbol)
+                    .append("|Side=").append(replace.side == '1' ? "BUY" : "SELL")
+                    .append("|Quantity=");
+            appendInteger(response, replace.orderQty.value);
+            response.append("|Price=");
+            appendPrice(response, replace.price);
+            response.append("|Status=").append(binary::ackStatus(status)).append("|");
+        } else if (msgType == fix::Logon::kMsgType) {
+            logon(fix::decode<fix::Logon>(data), connection);
+            connection.outbound.append(response, '\n');
+            return;
+        } else {
+            throw std::invalid_argument("Unsupported MsgType: " + std::string(msgType));
+        }
 
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::steady_clock::now() - start_time);
+        response.append("ProcessingTime=");
+        appendInteger(response, duration.count());
+        response.append("us");
 
-        std::ostringstream response;
-        response << "ACK|"
-                << "OrderID=" << orderId << "|"
-                << "Symbol=" << symbol << "|"
-                << "Side=" << (side == "1" ? "BUY" : "SELL") << "|"
-                << "Quantity=" << quantity << "|"
-                << "Price=" << price << "|"
-                << "Status=ACCEPTED|"
-                << "ProcessingTime=" << duration.count() << "us";
+        messages_processed_.fetch_add(1, std::memory_order_relaxed);
 
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        ++stats_.messages_processed;
+    } catch (const std::exception& e) {
+        logger_->log(Logger::Level::ERROR, "Message processing error: " + std::string(e.what()));
+        response.assign("NAK|Error=").append(e.what());
+    }
+    connection.outbound.append(response, '\n');
+}
+
+void NetworkServer::processBinaryMessage(std::string_view data, Connection& connection) {
+    binary::ExecutionReport report{};
+    binary::initHeader(report);
+    try {
+        // Fields are echoed into the report before the request is handled,
+        // so a rejection names it too
+        switch (binary::echoRequest(data, report)) {
+            case binary::NewOrder::kTemplateId: {
+                Qty filledQty;
+                report.ordStatus = handleNewOrder(binary::decode(binary::overlay<binary::NewOrder>(data),
+                                                                 order_manager_->instruments()),
+                                                  filledQty, connection.session);
+                report.cumQty = filledQty.value;
+                break;
+            }
+            case binary::Cancel::kTemplateId:
+                handleCancel(binary::decode(binary::overlay<binary::Cancel>(data), order_manager_->instruments()));
+                report.ordStatus = fix::status::Canceled;
+                break;
+            case binary::Replace::kTemplateId: {
+                Qty filledQty;
+                report.ordStatus = handleReplace(binary::decode(binary::overlay<binary::Replace>(data),
+                                                                order_manager_->instruments()),
+                                                 filledQty);
+                report.cumQty = filledQty.value;
+                break;
+            }
+        }
+        // FIX 4.2 reports fills with ExecType equal to the OrdStatus
+        report.execType = report.ordStatus;
 
-        return response.str();
+        messages_processed_.fetch_add(1, std::memory_order_relaxed);
 
     } catch (const std::exception& e) {
         logger_->log(Logger::Level::ERROR, "Message processing error: " + std::string(e.what()));
-        return "NAK|Error=" + std::string(e.what());
+        report.execType = report.ordStatus = fix::status::Rejected;
+        binary::setTruncatedText(report.text, e.what());
+    }
+    connection.outbound.append(std::string_view(reinterpret_cast<const char*>(&report), sizeof report));
+}
+
+void NetworkServer::logon(const fix::Logon& logon, Connection& connection) {
+    if (logon.wireEncoding == "BINARY") {
+        connection.encoding = network::Encoding::BINARY;
+    } else if (!logon.wireEncoding.empty() && logon.wireEncoding != "TEXT") {
+        throw std::invalid_argument("Unsupported WireEncoding: " + std::string(logon.wireEncoding));
+    }
+    // Answered in text either way; binary starts with the next message
+    connection.response.append("ACK|Status=LOGGED_ON|Encoding=")
+                       .append(connection.encoding == network::Encoding::BINARY ? "BINARY" : "TEXT")
+                       .append("|");
+}
+
+char NetworkServer::handleNewOrder(const fix::NewOrderSingle& order, Qty& filledQty, uint32_t session) {
+    AccountId account = 0;
+    if (risk_checker_) {
+        account = risk_checker_->account(order.account);
+        enforce(risk_checker_->checkNewOrder(order, account, steadyNanos()));
+    }
+    JournalRecord record = JournalRecord::newOrder(order);
+    uint64_t journalSequence = 0;
+    char status = fix::status::New;
+    if (matching_engine_) {
+        std::lock_guard<std::mutex> lock(matching_mutex_);
+        executions_.clear();
+        try {
+            checkJournalRoom();
+            matching_engine_->submit(order, executions_, account, session);
+        } catch (...) {
+            // Rejected by the book: hand back the exposure just reserved
+            if (risk_checker_ && order.ordType != fix::ord_type::Market) {
+                risk_checker_->release(account, order.price, order.orderQty);
+            }
+            throw;
+        }
+        // Journaled once the book has taken it, in the order the engine saw it
+        journalSequence = journalEvent(record);
+        recordExecutions();
+        routeExecutions(order.clOrdId);
+        status = statusAfterMatching(executions_, order.clOrdId, filledQty);
+    } else {
+        journalSequence = journalEvent(record);
+    }
+    submit(record, account, journalSequence);
+    return status;
+}
+
+void NetworkServer::handleCancel(const fix::OrderCancelRequest& cancel) {
+    AccountId account = 0;
+    if (risk_checker_) {
+        account = risk_checker_->account(cancel.account);
+    }
+    JournalRecord record = JournalRecord::cancel(cancel);
+    uint64_t journalSequence = 0;
+    if (matching_engine_) {
+        std::lock_guard<std::mutex> lock(matching_mutex_);
+        executions_.clear();
+        checkJournalRoom();
+        matching_engine_->cancel(cancel, executions_);
+        journalSequence = journalEvent(record);
+        recordExecutions();
+    } else {
+        journalSequence = journalEvent(record);
+    }
+    // Without the engine, whoever applies the cancel releases the order's exposure
+    submit(record, account, journalSequence);
+}
+
+char NetworkServer::handleReplace(const fix::OrderCancelReplaceRequest& replace, Qty& filledQty) {
+    AccountId account = 0;
+    uint64_t journalSequence = 0;
+    int64_t exposureDelta = 0;
+    JournalRecord record = JournalRecord::modify(replace);
+    char status = fix::status::Replaced;
+    if (matching_engine_) {
+        std::lock_guard<std::mutex> lock(matching_mutex_);
+        executions_.clear();
+        const Order* existing = matching_engine_->findOrder(replace.origClOrdId);
+        if (risk_checker_ && existing) {
+            account = existing->account;
+            enforce(risk_checker_->checkReplace(replace, account, *existing, steadyNanos(), exposureDelta));
+        }
+        try {
+            checkJournalRoom();
+            matching_engine_->replace(replace, executions_);
+        } catch (...) {
+            if (risk_checker_) {
+                risk_checker_->adjustExposure(account, -exposureDelta);
+            }
+            throw;
+        }
+        journalSequence = journalEvent(record);
+        recordExecutions();
+        routeExecutions(replace.clOrdId);
+        status = statusAfterMatching(executions_, replace.clOrdId, filledQty);
+    } else if (risk_checker_) {
+        account = risk_checker_->account(replace.account);
+        // The sequencer checks against the order state it owns
+        auto existing = sequencer_ ? std::nullopt : order_manager_->getOrder(replace.origClOrdId);
+        if (existing) {
+            enforce(risk_checker_->checkReplace(replace, account, *existing, steadyNanos(), exposureDelta));
+        }
+    }
+    if (!matching_engine_) {
+        journalSequence = journalEvent(record);
+    }
+    // Without the engine, whoever applies the replace settles the delta
+    submit(record, account, journalSequence, exposureDelta);
+    return status;
+}
+
+void NetworkServer::submit(const JournalRecord& record, AccountId account, uint64_t journalSequence,
+                           int64_t exposureDelta) {
+    if (sequencer_) {
+        // A replace is checked against the order state the sequencer owns,
+        // so its answer has to wait for the sequencer
+        bool answerFromSequencer = record.type == JournalEventType::MODIFY;
+        SequencerOutcome outcome;
+        uint64_t ticket = sequencer_->publish(record, account, answerFromSequencer ? &outcome : nullptr);
+        if (answerFromSequencer) {
+            OrderSequencer::wait(outcome);
+            enforce(outcome.risk);
+            if (!outcome.applied) {
+                throw std::runtime_error("Order state rejected the replace");
+            }
+        }
+        if (journal_ && config_.ack_after_durable) {
+            sequencer_->waitDurable(ticket);
+        }
+        return;
+    }
+    // With the engine, its books hold the order state and there is nothing
+    // more to apply
+    if (!matching_engine_) {
+        // The workers apply the record decoded here rather than parse the text again
+        auto handle = decoded_messages_->acquire();
+        DecodedRequest& request = (*decoded_messages_)[handle];
+        request.record = record;
+        request.account = account;
+        request.exposureDelta = exposureDelta;
+        network::Message message(network::Message::Type::FIX, handle);
+        if (bounded_queue_) {
+            bounded_queue_->push(std::move(message));
+        } else {
+            message_queue_->push(std::move(message));
+        }
+    }
+    if (journalSequence != 0 && config_.ack_after_durable) {
+        journal_->waitDurable(journalSequence);
+    }
+}
+
+uint64_t NetworkServer::journalEvent(JournalRecord& record) {
+    // The sequencer stamps and journals events itself, in the order it applies them
+    if (sequencer_) {
+        return 0;
+    }
+    // Stamped once, so the journal and the worker applying it agree on the time
+    record.timestampNs = nowNanos();
+    if (!journal_) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    return journal_->append(record);
+}
+
+void NetworkServer::checkJournalRoom() const {
+    if (journal_ && !sequencer_ && journal_->lastSequence() >= journal_->endSequence()) {
+        throw std::length_error("Order journal full");
     }
 }
 
+void NetworkServer::recordExecutions() {
+    if (risk_checker_) {
+        for (const auto& execution : executions_) {
+            risk_checker_->onExecution(execution);
+        }
+    }
+}
+
+void NetworkServer::routeExecutions(std::string_view clOrdId) {
+    for (const auto& execution : executions_) {
+        if (execution.clOrdId.view() == clOrdId || execution.session == 0) {
+            continue;
+        }
+        ConnectionPtr owner;
+        {
+            std::lock_guard<std::mutex> lock(sessions_mutex_);
+            auto it = sessions_.find(execution.session);
+            if (it == sessions_.end()) {
+                continue;
+            }
+            owner = it->second;
+        }
+        boost::asio::post(owner->socket.get_executor(), [this, owner, execution] {
+            sendExecution(owner, execution);
+        });
+    }
+}
+
+void NetworkServer::sendExecution(const ConnectionPtr& connection, const Execution& execution) {
+    if (connection->encoding == network::Encoding::BINARY) {
+        // Orders sent as text before a Logon to binary may have longer ids
+        binary::ExecutionReport report{};
+        binary::initHeader(report);
+        binary::setTruncatedText(report.clOrdId, execution.clOrdId.view());
+        binary::setTruncatedText(report.origClOrdId, execution.origClOrdId.view());
+        binary::setTruncatedText(report.symbol, order_manager_->instruments().symbol(execution.instrument));
+        report.price = execution.price.mantissa;
+        report.priceScale = execution.price.scale;
+        report.orderQty = execution.orderQty.value;
+        report.cumQty = execution.cumQty.value;
+        report.execType = execution.execType;
+        report.ordStatus = execution.ordStatus;
+        report.side = execution.side;
+        connection->outbound.append(std::string_view(reinterpret_cast<const char*>(&report), sizeof report));
+        startWrite(connection);
+        return;
+    }
+    char buffer[kReportBufferSize];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    sendResponse(connection, encodeExecutionReport(execution, order_manager_->instruments(), encoder));
+}
+
 void NetworkServer::processMessages() {
+    if (bounded_queue_) {
+        // Drain in batches: one claim on the queue per batch, not per message
+        std::vector<network::Message> batch;
+        batch.reserve(kIngressBatch);
+        while (running_) {
+            batch.clear();
+            bounded_queue_->pop_n(std::back_inserter(batch), kIngressBatch, std::chrono::milliseconds(100));
+            for (const auto& message : batch) {
+                processMessage(message);
+            }
+        }
+        return;
+    }
     while (running_) {
         if (auto message = message_queue_->pop()) {
-            try {
-                switch (message->type) {
-                    case network::Message::Type::FIX:
-                        logger_->log(Logger::Level::DEBUG, "Processing FIX message");
-                        order_manager_->processOrder(message->payload);
-                        break;
-                    case network::Message::Type::MARKET_DATA:
-                        logger_->log(Logger::Level::DEBUG, "Processing market data message");
-                        // Handle market data
-                        break;
-                    case network::Message::Type::CONTROL:
-                        logger_->log(Logger::Level::DEBUG, "Processing control message");
-                        // Handle control messages
-                        break;
+            processMessage(*message);
+        }
+    }
+}
+
+void NetworkServer::processMessage(const network::Message& message) {
+    try {
+        switch (message.type) {
+            case network::Message::Type::FIX:
+                if (logger_->enabled(Logger::Level::DEBUG)) {
+                    logger_->log(Logger::Level::DEBUG, "Processing FIX message");
+                }
+                if (message.decoded != network::Message::kNotDecoded) {
+                    bool applied = applyDecoded((*decoded_messages_)[message.decoded]);
+                    decoded_messages_->release(message.decoded);
+                    if (!applied) {
+                        throw std::runtime_error("Order state rejected the request");
+                    }
+                } else {
+                    order_manager_->processOrder(message.payload);
                 }
-                
-            } catch (const std::exception& e) {
-                handleError("Message processing error: " + std::string(e.what()));
+                break;
+            case network::Message::Type::MARKET_DATA:
+                logger_->log(Logger::Level::DEBUG, "Processing market data message");
+                processMarketData(message.payload);
+                break;
+            case network::Message::Type::CONTROL:
+                logger_->log(Logger::Level::DEBUG, "Processing control message");
+                // Handle control messages
+                break;
+        }
+        
+    } catch (const std::exception& e) {
+        handleError("Message processing error: " + std::string(e.what()));
+    }
+}
+
+void NetworkServer::processMarketData(std::string_view rawMarketData) {
+    std::lock_guard<std::mutex> lock(market_data_mutex_);
+    market_updates_.clear();
+    market_data_.processUpdates(rawMarketData, market_updates_);
+    // Without the engine, the feed is the only source of trades to band orders around
+    if (risk_checker_) {
+        for (const auto& update : market_updates_) {
+            risk_checker_->onTrade(update.instrument, update.price);
+        }
+    }
+}
+
+Price NetworkServer::lastPrice(InstrumentId instrument) const {
+    std::lock_guard<std::mutex> lock(market_data_mutex_);
+    return market_data_.lastPrice(instrument);
+}
+
+bool NetworkServer::applyDecoded(const DecodedRequest& request) {
+    const JournalRecord& record = request.record;
+    Order previous;
+    bool applied = order_manager_->apply(record, &previous);
+    // With the engine, exposure follows its reports instead
+    if (!risk_checker_ || matching_engine_) {
+        return applied;
+    }
+    switch (record.type) {
+        case JournalEventType::NEW_ORDER:
+            // A rejected order (duplicate ClOrdID) gives back what its check reserved
+            if (!applied && record.ordType != fix::ord_type::Market) {
+                risk_checker_->release(request.account, record.price(), Qty(record.orderQty));
             }
+            break;
+        case JournalEventType::MODIFY: {
+            // The check reserved against the order as the io thread saw it;
+            // correct that to the order the replace actually changed
+            int64_t delta = applied ? RiskChecker::replaceDelta(previous, record.price(), Qty(record.orderQty)) : 0;
+            risk_checker_->adjustExposure(request.account, delta - request.exposureDelta);
+            break;
         }
+        case JournalEventType::CANCEL:
+            if (applied) {
+                risk_checker_->release(request.account, previous.price, previous.leavesQty());
+            }
+            break;
     }
+    return applied;
 }
 
 void NetworkServer::handleError(const std::string& error_msg) {
@@ -219,6 +887,13 @@ void NetworkServer::handleError(const std::string& error_msg) {
 }
 
 NetworkServer::Statistics NetworkServer::getStatistics() const {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    return stats_;
+    Statistics stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats = stats_;
+    }
+    stats.messages_processed = messages_processed_.load(std::memory_order_relaxed);
+    stats.socket_reads = socket_reads_.load(std::memory_order_relaxed);
+    stats.socket_writes = socket_writes_.load(std::memory_order_relaxed);
+    return stats;
 }
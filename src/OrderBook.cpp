@@ -0,0 +1,99 @@
+// src/OrderBook.cpp
+#include "OrderBook.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+OrderBook::OrderBook(const BookConfig& config, ObjectPool<Order>& pool)
+    : pool_(pool) {
+    // All three prices are held at the finest of their scales
+    scale_ = std::max({config.minPrice.scale, config.maxPrice.scale, config.tickSize.scale});
+    minMantissa_ = config.minPrice.rescale(scale_).mantissa;
+    tickMantissa_ = config.tickSize.rescale(scale_).mantissa;
+    int64_t maxMantissa = config.maxPrice.rescale(scale_).mantissa;
+
+    if (tickMantissa_ <= 0 || maxMantissa < minMantissa_ ||
+        (maxMantissa - minMantissa_) % tickMantissa_ != 0) {
+        throw std::invalid_argument("Invalid book price band or tick size");
+    }
+    levels_.resize(static_cast<std::size_t>((maxMantissa - minMantissa_) / tickMantissa_) + 1);
+}
+
+std::size_t OrderBook::levelFor(const Price& price) const {
+    Price scaled;
+    if (!price.tryRescale(scale_, scaled)) {
+        throw std::invalid_argument("Price " + price.toString() + " is finer than the tick size");
+    }
+    int64_t offset = scaled.mantissa - minMantissa_;
+    if (offset < 0 || offset / tickMantissa_ >= static_cast<int64_t>(levels_.size())) {
+        throw std::invalid_argument("Price " + price.toString() + " is outside the book's band");
+    }
+    if (offset % tickMantissa_ != 0) {
+        throw std::invalid_argument("Price " + price.toString() + " is not on a tick");
+    }
+    return static_cast<std::size_t>(offset / tickMantissa_);
+}
+
+void OrderBook::append(uint32_t slot, std::size_t index) {
+    Order& order = pool_[slot];
+    Level& level = levels_[index];
+
+    order.prevInLevel = level.tail;
+    order.nextInLevel = kNoOrder;
+    if (level.empty()) {
+        level.head = slot;
+    } else {
+        pool_[level.tail].nextInLevel = slot;
+    }
+    level.tail = slot;
+    ++level.orders;
+    level.quantity += order.leavesQty();
+
+    if (order.isBuy()) {
+        if (bestBid_ == kNoLevel || index > bestBid_) {
+            bestBid_ = index;
+        }
+    } else if (bestAsk_ == kNoLevel || index < bestAsk_) {
+        bestAsk_ = index;
+    }
+}
+
+void OrderBook::unlink(uint32_t slot, std::size_t index) {
+    Order& order = pool_[slot];
+    Level& level = levels_[index];
+
+    if (order.prevInLevel == kNoOrder) {
+        level.head = order.nextInLevel;
+    } else {
+        pool_[order.prevInLevel].nextInLevel = order.nextInLevel;
+    }
+    if (order.nextInLevel == kNoOrder) {
+        level.tail = order.prevInLevel;
+    } else {
+        pool_[order.nextInLevel].prevInLevel = order.prevInLevel;
+    }
+    order.prevInLevel = kNoOrder;
+    order.nextInLevel = kNoOrder;
+    --level.orders;
+    level.quantity -= order.leavesQty();
+
+    if (!level.empty()) {
+        return;
+    }
+    // Walk to the next occupied level; books are dense near the touch, so
+    // this is normally a few steps
+    if (order.isBuy() && index == bestBid_) {
+        while (bestBid_ > 0 && levels_[bestBid_].empty()) {
+            --bestBid_;
+        }
+        if (levels_[bestBid_].empty()) {
+            bestBid_ = kNoLevel;
+        }
+    } else if (!order.isBuy() && index == bestAsk_) {
+        while (bestAsk_ + 1 < levels_.size() && levels_[bestAsk_].empty()) {
+            ++bestAsk_;
+        }
+        if (levels_[bestAsk_].empty()) {
+            bestAsk_ = kNoLevel;
+        }
+    }
+}
@@ -0,0 +1,177 @@
+// src/OrderIndex.cpp
+#include "OrderIndex.hpp"
+#include <new>
+#include <utility>
+
+namespace {
+    // Grow once the table is 7/8 full; Robin Hood keeps probes short up to here
+    constexpr std::size_t kMaxLoadNumerator = 7;
+    constexpr std::size_t kMaxLoadDenominator = 8;
+    // Old-table slots migrated per operation while a resize is in progress.
+    // Growth doubles the capacity, leaving >= capacity/8 inserts before the
+    // next growth, which is ample time to drain the old table.
+    constexpr std::size_t kMigrationStep = 16;
+    constexpr std::size_t kMinCapacity = 16;
+}
+
+void OrderIndex::Table::allocate(std::size_t newCapacity) {
+    auto* raw = static_cast<Entry*>(std::calloc(newCapacity, sizeof(Entry)));
+    if (!raw) {
+        throw std::bad_alloc();
+    }
+    entries.reset(raw);
+    capacity = newCapacity;
+    mask = newCapacity - 1;
+    size = 0;
+}
+
+void OrderIndex::Table::release() {
+    entries.reset();
+    capacity = 0;
+    mask = 0;
+    size = 0;
+}
+
+uint32_t OrderIndex::Table::find(const ClOrdId& key, uint32_t hash) const {
+    if (!entries) {
+        return kNotFound;
+    }
+    std::size_t pos = hash & mask;
+    for (std::size_t dist = 0;; ++dist, pos = (pos + 1) & mask) {
+        const Entry& entry = entries[pos];
+        // Stop at an empty entry or one closer to home than we are
+        if (entry.valuePlusOne == 0 || distance(pos) < dist) {
+            return kNotFound;
+        }
+        if (entry.hash == hash && entry.key == key) {
+            return entry.valuePlusOne - 1;
+        }
+    }
+}
+
+void OrderIndex::Table::insert(Entry entry) {
+    std::size_t pos = entry.hash & mask;
+    for (std::size_t dist = 0;; ++dist, pos = (pos + 1) & mask) {
+        Entry& slot = entries[pos];
+        if (slot.valuePlusOne == 0) {
+            slot = entry;
+            ++size;
+            return;
+        }
+        // Robin Hood: take the slot from an entry that is closer to its home
+        std::size_t existing = distance(pos);
+        if (existing < dist) {
+            std::swap(slot, entry);
+            dist = existing;
+        }
+    }
+}
+
+bool OrderIndex::Table::erase(const ClOrdId& key, uint32_t hash) {
+    if (!entries) {
+        return false;
+    }
+    std::size_t pos = hash & mask;
+    for (std::size_t dist = 0;; ++dist, pos = (pos + 1) & mask) {
+        const Entry& entry = entries[pos];
+        if (entry.valuePlusOne == 0 || distance(pos) < dist) {
+            return false;
+        }
+        if (entry.hash == hash && entry.key == key) {
+            break;
+        }
+    }
+
+    // Backward-shift the rest of the cluster instead of leaving a tombstone
+    std::size_t next = (pos + 1) & mask;
+    while (entries[next].valuePlusOne != 0 && distance(next) != 0) {
+        entries[pos] = entries[next];
+        pos = next;
+        next = (next + 1) & mask;
+    }
+    entries[pos] = Entry{};
+    --size;
+    return true;
+}
+
+OrderIndex::OrderIndex(std::size_t expectedEntries) {
+    std::size_t capacity = kMinCapacity;
+    while (capacity * kMaxLoadNumerator / kMaxLoadDenominator < expectedEntries) {
+        capacity <<= 1;
+    }
+    current_.allocate(capacity);
+}
+
+uint32_t OrderIndex::find(const ClOrdId& key, uint64_t hash) const {
+    uint32_t value = current_.find(key, static_cast<uint32_t>(hash));
+    if (value == kNotFound && old_.entries) {
+        value = old_.find(key, static_cast<uint32_t>(hash));
+    }
+    return value;
+}
+
+bool OrderIndex::insert(const ClOrdId& key, uint64_t hash, uint32_t value) {
+    if (find(key, hash) != kNotFound) {
+        return false;
+    }
+    if (old_.entries) {
+        migrateStep();
+    }
+    if ((current_.size + 1) * kMaxLoadDenominator > current_.capacity * kMaxLoadNumerator) {
+        grow();
+    }
+    current_.insert(Entry{key, static_cast<uint32_t>(hash), value + 1});
+    ++size_;
+    return true;
+}
+
+bool OrderIndex::erase(const ClOrdId& key, uint64_t hash) {
+    bool erased = current_.erase(key, static_cast<uint32_t>(hash)) ||
+                  old_.erase(key, static_cast<uint32_t>(hash));
+    if (erased) {
+        --size_;
+    }
+    if (old_.entries) {
+        migrateStep();
+    }
+    return erased;
+}
+
+void OrderIndex::grow() {
+    // Finish any previous migration first; only reached if the step budget
+    // could not keep up, which the load factor arithmetic rules out
+    while (old_.entries) {
+        migrateStep();
+    }
+
+    old_ = std::move(current_);
+    current_.allocate(old_.capacity * 2);
+
+    // Start migrating at an empty slot so clusters are always moved whole;
+    // a partially moved cluster would break Robin Hood probing in old_
+    migrateCursor_ = 0;
+    while (old_.entries[migrateCursor_].valuePlusOne != 0) {
+        ++migrateCursor_;
+    }
+    migrateRemaining_ = old_.capacity;
+}
+
+void OrderIndex::migrateStep() {
+    std::size_t scanned = 0;
+    // Keep going past the step budget until the end of the current cluster
+    while (migrateRemaining_ > 0 &&
+           (scanned < kMigrationStep || old_.entries[migrateCursor_].valuePlusOne != 0)) {
+        Entry& entry = old_.entries[migrateCursor_];
+        if (entry.valuePlusOne != 0) {
+            current_.insert(entry);
+            entry = Entry{};
+            --old_.size;
+        }
+        migrateCursor_ = (migrateCursor_ + 1) & old_.mask;
+        --migrateRemaining_;
+        ++scanned;
+    }
+    if (migrateRemaining_ == 0) {
+        old_.release();
+    }
+}
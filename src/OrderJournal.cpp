@@ -0,0 +1,440 @@
+// src/OrderJournal.cpp
+#include "OrderJournal.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char kMagic[8] = {'G', 'W', 'J', 'R', 'N', 'L', '0', '1'};
+    constexpr uint32_t kVersion = 2;  // 2: records carry the account
+    // Records start on the second page; the first holds the header
+    constexpr std::size_t kHeaderBytes = 4096;
+
+    struct JournalHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordSize;
+        uint64_t capacity;
+    };
+
+    std::runtime_error systemError(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    std::string segmentPath(const std::string& path, std::size_t index) {
+        return index == 0 ? path : path + "." + std::to_string(index);
+    }
+
+    // Indexes of the journal's segment files, oldest first: `path` itself is
+    // 0 and `path.N` is N
+    std::vector<std::size_t> findSegments(const std::string& path) {
+        std::filesystem::path base(path);
+        std::filesystem::path directory = base.has_parent_path() ? base.parent_path() : ".";
+        std::string name = base.filename().string();
+        std::vector<std::size_t> segments;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            std::string file = entry.path().filename().string();
+            if (file == name) {
+                segments.push_back(0);
+            } else if (file.size() > name.size() + 1 && file.compare(0, name.size(), name) == 0 &&
+                       file[name.size()] == '.' &&
+                       file.find_first_not_of("0123456789", name.size() + 1) == std::string::npos) {
+                segments.push_back(std::stoull(file.substr(name.size() + 1)));
+            }
+        }
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+}
+
+JournalRecord JournalRecord::newOrder(const fix::NewOrderSingle& order) {
+    JournalRecord record;
+    record.type = JournalEventType::NEW_ORDER;
+    record.clOrdId = ClOrdId(order.clOrdId);
+    record.symbol = SymbolCode(order.symbol);
+    record.account = AccountCode(order.account);
+    record.priceMantissa = order.price.mantissa;
+    record.priceScale = order.price.scale;
+    record.orderQty = order.orderQty.value;
+    record.side = order.side;
+    record.ordType = order.ordType;
+    return record;
+}
+
+JournalRecord JournalRecord::modify(const fix::OrderCancelReplaceRequest& replace) {
+    JournalRecord record;
+    record.type = JournalEventType::MODIFY;
+    record.clOrdId = ClOrdId(replace.clOrdId);
+    record.origClOrdId = ClOrdId(replace.origClOrdId);
+    record.symbol = SymbolCode(replace.symbol);
+    record.priceMantissa = replace.price.mantissa;
+    record.priceScale = replace.price.scale;
+    record.orderQty = replace.orderQty.value;
+    record.side = replace.side;
+    record.ordType = replace.ordType;
+    return record;
+}
+
+JournalRecord JournalRecord::cancel(const fix::OrderCancelRequest& cancel) {
+    JournalRecord record;
+    record.type = JournalEventType::CANCEL;
+    record.clOrdId = ClOrdId(cancel.clOrdId);
+    record.origClOrdId = ClOrdId(cancel.origClOrdId);
+    record.symbol = SymbolCode(cancel.symbol);
+    record.orderQty = cancel.orderQty.value;
+    record.side = cancel.side;
+    return record;
+}
+
+uint32_t JournalRecord::computeChecksum() const {
+    // FNV-1a; the fields before `checksum` are packed without padding
+    const auto* bytes = reinterpret_cast<const unsigned char*>(this);
+    uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < offsetof(JournalRecord, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+OrderJournal::Segment::Segment(std::string segmentPath, std::size_t segmentCapacity)
+    : path(std::move(segmentPath))
+    , capacity(segmentCapacity) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw systemError("Cannot open order journal", path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw systemError("Cannot stat order journal", path);
+    }
+
+    if (info.st_size == 0) {
+        mappedBytes = kHeaderBytes + capacity * sizeof(JournalRecord);
+        // Reserve the blocks up front so appends never extend the file
+        int error = ::posix_fallocate(fd, 0, static_cast<off_t>(mappedBytes));
+        if (error != 0 && ::ftruncate(fd, static_cast<off_t>(mappedBytes)) != 0) {
+            ::close(fd);
+            throw systemError("Cannot size order journal", path);
+        }
+        JournalHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.recordSize = sizeof(JournalRecord);
+        header.capacity = capacity;
+        if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            ::fsync(fd) != 0) {
+            ::close(fd);
+            throw systemError("Cannot initialise order journal", path);
+        }
+    } else {
+        JournalHeader header{};
+        if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+            header.recordSize != sizeof(JournalRecord)) {
+            ::close(fd);
+            throw std::runtime_error("Not an order journal: " + path);
+        }
+        // An existing file keeps the capacity it was created with
+        capacity = header.capacity;
+        mappedBytes = kHeaderBytes + capacity * sizeof(JournalRecord);
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    // Fault the pages in now rather than on the first append to each
+    flags |= MAP_POPULATE;
+#endif
+    void* address = ::mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (address == MAP_FAILED) {
+        ::close(fd);
+        throw systemError("Cannot map order journal", path);
+    }
+    mapping = static_cast<char*>(address);
+    records = reinterpret_cast<JournalRecord*>(mapping + kHeaderBytes);
+}
+
+OrderJournal::Segment::~Segment() {
+    ::munmap(mapping, mappedBytes);
+    ::close(fd);
+}
+
+OrderJournal::OrderJournal(const JournalConfig& config)
+    : config_(config) {
+    std::vector<std::size_t> indexes = findSegments(config_.path);
+    if (indexes.empty()) {
+        indexes.push_back(0);
+    }
+    for (std::size_t index : indexes) {
+        segments_.push_back(std::make_shared<Segment>(segmentPath(config_.path, index), config_.capacity));
+    }
+    nextIndex_ = indexes.back() + 1;
+
+    recover();
+    flusher_ = std::thread([this] { flusherLoop(); });
+}
+
+OrderJournal::~OrderJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    flushRequested_.notify_one();
+    durableAdvanced_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+    syncThrough(lastSequence());
+}
+
+void OrderJournal::recover() {
+    // The journal is the longest run of valid records, continuing from one
+    // segment into the next
+    uint64_t last = 0;
+    std::size_t chained = 0;
+    for (; chained < segments_.size(); ++chained) {
+        Segment& segment = *segments_[chained];
+        const JournalRecord& head = segment.records[0];
+        if (head.sequence == 0 || head.checksum != head.computeChecksum() ||
+            (chained > 0 && head.sequence != last + 1)) {
+            break;
+        }
+        segment.first = head.sequence;
+        uint64_t valid = 1;
+        while (valid < segment.capacity && segment.records[valid].sequence == segment.first + valid &&
+               segment.records[valid].checksum == segment.records[valid].computeChecksum()) {
+            ++valid;
+        }
+        last = segment.first + valid - 1;
+    }
+
+    // Writing resumes in the last segment of the run; the segments after it
+    // hold nothing that follows on, so they go
+    std::size_t current = chained > 0 ? chained - 1 : 0;
+    for (std::size_t i = current + 1; i < segments_.size(); ++i) {
+        ::unlink(segments_[i]->path.c_str());
+    }
+    segments_.resize(current + 1);
+    Segment& segment = *segments_[current];
+    if (chained == 0) {
+        segment.first = 1;
+    }
+
+    // Clear anything after the valid prefix (a torn record and whatever an
+    // earlier run wrote beyond it) so it cannot be mistaken for new records
+    uint64_t valid = last >= segment.first ? last - segment.first + 1 : 0;
+    uint64_t end = valid;
+    while (end < segment.capacity && segment.records[end].sequence != 0) {
+        segment.records[end] = JournalRecord{};
+        ++end;
+    }
+    if (end > valid) {
+        ::msync(segment.mapping, kHeaderBytes + end * sizeof(JournalRecord), MS_SYNC);
+    }
+
+    current_ = &segment;
+    currentEnd_.store(segment.first + segment.capacity - 1, std::memory_order_release);
+    first_.store(segments_.front()->first, std::memory_order_release);
+    written_.store(last, std::memory_order_release);
+    durable_.store(last, std::memory_order_release);
+}
+
+uint64_t OrderJournal::append(JournalRecord record) {
+    uint64_t sequence = written_.load(std::memory_order_relaxed) + 1;
+    if (nextReady_.load(std::memory_order_acquire)) {
+        switchSegment(sequence);
+    }
+    Segment& segment = *current_;
+    if (sequence - segment.first >= segment.capacity) {
+        throw std::length_error("Order journal full: " + segment.path);
+    }
+    record.sequence = sequence;
+    if (record.timestampNs == 0) {
+        record.timestampNs = nowNanos();
+    }
+    record.checksum = record.computeChecksum();
+    segment.records[sequence - segment.first] = record;
+    written_.store(sequence, std::memory_order_release);
+
+    // Wake the flusher when a group starts and when it fills; appends in
+    // between never touch the lock
+    uint64_t pending = sequence - durable_.load(std::memory_order_acquire);
+    if (pending == 1 || pending == config_.groupCommitEvents) {
+        wakeFlusher();
+    }
+    return sequence;
+}
+
+void OrderJournal::switchSegment(uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(segmentsMutex_);
+    next_->first = sequence;
+    segments_.push_back(std::move(next_));
+    current_ = segments_.back().get();
+    currentEnd_.store(sequence + current_->capacity - 1);
+    nextReady_.store(false);
+}
+
+void OrderJournal::startSegment() {
+    std::size_t index;
+    {
+        std::lock_guard<std::mutex> lock(segmentsMutex_);
+        if (next_ || startingSegment_) {
+            return;
+        }
+        startingSegment_ = true;
+        index = nextIndex_++;
+    }
+    // Creating and faulting in the file happens here rather than in append()
+    std::shared_ptr<Segment> segment;
+    try {
+        segment = std::make_shared<Segment>(segmentPath(config_.path, index), config_.capacity);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(segmentsMutex_);
+        startingSegment_ = false;
+        throw;
+    }
+    std::lock_guard<std::mutex> lock(segmentsMutex_);
+    next_ = std::move(segment);
+    startingSegment_ = false;
+    nextReady_.store(true);
+}
+
+std::size_t OrderJournal::discardBefore(uint64_t sequence) {
+    std::vector<std::shared_ptr<Segment>> discarded;
+    {
+        std::lock_guard<std::mutex> lock(segmentsMutex_);
+        std::size_t count = 0;
+        // A segment's events end where the next one's begin
+        while (count + 1 < segments_.size() && segments_[count + 1]->first <= sequence) {
+            ++count;
+        }
+        discarded.assign(segments_.begin(), segments_.begin() + count);
+        segments_.erase(segments_.begin(), segments_.begin() + count);
+        first_.store(segments_.front()->first, std::memory_order_release);
+    }
+    // A reader still holding one keeps its mapping until it lets go
+    for (const auto& segment : discarded) {
+        ::unlink(segment->path.c_str());
+    }
+    return discarded.size();
+}
+
+uint64_t OrderJournal::endSequence() const {
+    uint64_t last = lastSequence();
+    // The writer moves to a waiting segment at its next append, which comes
+    // after `last`, so that much room is there at least
+    if (nextReady_.load()) {
+        return last + config_.capacity;
+    }
+    return currentEnd_.load();
+}
+
+const JournalRecord& OrderJournal::record(uint64_t sequence) const {
+    uint64_t last;
+    std::shared_ptr<const Segment> segment = segmentFor(sequence, last);
+    return segment->records[sequence - segment->first];
+}
+
+std::shared_ptr<const OrderJournal::Segment> OrderJournal::segmentFor(uint64_t sequence, uint64_t& last) const {
+    std::lock_guard<std::mutex> lock(segmentsMutex_);
+    auto after = std::upper_bound(segments_.begin(), segments_.end(), sequence,
+                                  [](uint64_t s, const auto& segment) { return s < segment->first; });
+    if (after == segments_.begin()) {
+        throw std::out_of_range("Journal sequence " + std::to_string(sequence) + " discarded");
+    }
+    last = after == segments_.end() ? UINT64_MAX : (*after)->first - 1;
+    return *std::prev(after);
+}
+
+void OrderJournal::wakeFlusher() {
+    // Taking the lock orders this wake-up after the flusher's predicate check
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    flushRequested_.notify_one();
+}
+
+void OrderJournal::waitDurable(uint64_t sequence) {
+    if (sequence > lastSequence()) {
+        throw std::invalid_argument("Journal sequence " + std::to_string(sequence) + " not appended");
+    }
+    if (durableSequence() >= sequence) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    durableAdvanced_.wait(lock, [&] { return durableSequence() >= sequence || !running_; });
+}
+
+void OrderJournal::flush() {
+    if (!syncThrough(lastSequence())) {
+        throw systemError("Cannot sync order journal", config_.path);
+    }
+}
+
+bool OrderJournal::syncThrough(uint64_t sequence) {
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    uint64_t durable = durableSequence();
+    if (sequence <= durable) {
+        return true;
+    }
+
+    if (config_.fsync) {
+        // The pending events may run into a segment started since the last sync
+        std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        for (uint64_t from = durable + 1; from <= sequence;) {
+            uint64_t last;
+            std::shared_ptr<const Segment> segment = segmentFor(from, last);
+            uint64_t through = std::min(sequence, last);
+            // msync wants a page-aligned start
+            std::size_t begin = kHeaderBytes + (from - segment->first) * sizeof(JournalRecord);
+            std::size_t end = kHeaderBytes + (through - segment->first + 1) * sizeof(JournalRecord);
+            begin &= ~(pageSize - 1);
+            if (::msync(segment->mapping + begin, end - begin, MS_SYNC) != 0) {
+                return false;
+            }
+            from = through + 1;
+        }
+    }
+
+    durable_.store(sequence, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    durableAdvanced_.notify_all();
+    return true;
+}
+
+void OrderJournal::flusherLoop() {
+    auto pending = [this] { return lastSequence() - durableSequence(); };
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        flushRequested_.wait(lock, [&] { return !running_ || pending() > 0; });
+        if (!running_) {
+            break;
+        }
+        // Let the group fill up, but no longer than the commit interval
+        flushRequested_.wait_for(lock, config_.groupCommitInterval, [&] {
+            return !running_ || pending() >= config_.groupCommitEvents;
+        });
+
+        lock.unlock();
+        if (!syncThrough(lastSequence())) {
+            // Leave the events pending and retry after another interval
+            std::this_thread::sleep_for(config_.groupCommitInterval);
+        }
+        lock.lock();
+    }
+}
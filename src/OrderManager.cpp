@@ -1,58 +1,311 @@
 // src/OrderManager.cpp
 #include "OrderManager.hpp"
 #include "FixMessageHandler.hpp"
-#include <iostream>
+#include <algorithm>
+#include <chrono>
 
-void OrderManager::createOrder(const std::string& orderId, const std::string& orderDetails) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (activeOrders_.find(orderId) != activeOrders_.end()) {
-        throw std::runtime_error("Order ID already exists: " + orderId);
+namespace {
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    constexpr uint32_t kNoSlot = ObjectPool<Order>::kInvalidIndex;
+    static_assert(kNoSlot == OrderIndex::kNotFound, "Pool and index must agree on the missing slot value");
+}
+
+OrderManager::Shard::Shard(std::size_t capacity, uint64_t shardIndex)
+    : orders(capacity)
+    , index(capacity)
+    , nextOrderId(shardIndex + 1) {
+}
+
+uint32_t OrderManager::Shard::insert(const Key& key, const Order& order) {
+    uint32_t slot = orders.allocate();
+    orders[slot] = order;
+    orders[slot].clOrdId = key.id;
+    index.insert(key.id, key.hash, slot);
+    return slot;
+}
+
+uint32_t OrderManager::Shard::insertNew(const Key& key, const fix::NewOrderSingle& decoded,
+                                        uint64_t stride, int64_t nowNs) {
+    if (findSlot(key) != kNoSlot) {
+        throw std::runtime_error("Order ID already exists: " + key.id.str());
     }
-    activeOrders_[orderId] = orderDetails;
+
+    Order order;
+    order.side = decoded.side;
+    order.ordType = decoded.ordType;
+    order.state = OrderState::NEW;
+    order.instrument = decoded.instrument;
+    // Ids interleave across shards, so they stay unique without a shared counter
+    order.orderId = nextOrderId;
+    nextOrderId += stride;
+    order.price = decoded.price;
+    order.orderQty = decoded.orderQty;
+    order.accountCode = AccountCode(decoded.account);
+    order.createdNs = nowNs;
+    order.updatedNs = nowNs;
+    return insert(key, order);
+}
+
+void OrderManager::Shard::remove(const Key& key, uint32_t slot) {
+    orders[slot].state = OrderState::CANCELLED;
+    index.erase(key.id, key.hash);
+    orders.release(slot);
 }
 
-std::optional<std::string> OrderManager::getOrder(const std::string& orderId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = activeOrders_.find(orderId);
-    if (it != activeOrders_.end()) {
-        return it->second;
+OrderManager::OrderManager(std::size_t expectedOrders, std::size_t shardCount,
+                           std::shared_ptr<InstrumentRegistry> instruments, Concurrency concurrency)
+    : instruments_(instruments ? std::move(instruments) : std::make_shared<InstrumentRegistry>())
+    , singleWriter_(concurrency == Concurrency::SINGLE_WRITER) {
+    shardCount = roundUpToPowerOfTwo(shardCount == 0 ? 1 : shardCount);
+    shardMask_ = shardCount - 1;
+    shards_.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>((expectedOrders + shardCount - 1) / shardCount, i));
     }
-    return std::nullopt;
+}
+
+OrderManager::Shard& OrderManager::shardFor(const Key& key) const {
+    return *shards_[(key.hash >> 32) & shardMask_];
+}
+
+bool OrderManager::tryMakeKey(std::string_view orderId, std::optional<Key>& key) const {
+    if (!ClOrdId::fits(orderId)) {
+        return false;
+    }
+    key.emplace(orderId);
+    return true;
+}
+
+void OrderManager::createOrder(const std::string& orderId, const std::string& orderDetails) {
+    auto decoded = fix::decode<fix::NewOrderSingle>(orderDetails, *instruments_);
+    insertOrder(orderId, decoded, nowNanos());
+}
+
+std::optional<Order> OrderManager::getOrder(std::string_view orderId) const {
+    std::optional<Key> key;
+    if (!tryMakeKey(orderId, key)) {
+        return std::nullopt;
+    }
+    Shard& shard = shardFor(*key);
+    auto lock = lockShard(shard);
+    uint32_t slot = shard.findSlot(*key);
+    if (slot == kNoSlot) {
+        return std::nullopt;
+    }
+    return shard.orders[slot];
 }
 
 void OrderManager::processOrder(const std::string& fixMessage) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    FixMessageHandler fixHandler;
-    auto fields = fixHandler.parseFixMessage(fixMessage);
-    
-    // Extract order ID (tag 11 in FIX)
-    auto orderIdIt = fields.find("11");
-    if (orderIdIt != fields.end()) {
-        activeOrders_[orderIdIt->second] = fixMessage;
-        std::cout << "Processing order: " << orderIdIt->second << std::endl;
+    // Decode before taking any shard lock
+    std::string_view msgType = fix::messageType(fixMessage);
+    if (msgType == fix::OrderCancelRequest::kMsgType) {
+        auto cancel = fix::decode<fix::OrderCancelRequest>(fixMessage);
+        removeOrder(cancel.origClOrdId);
+    } else if (msgType == fix::OrderCancelReplaceRequest::kMsgType) {
+        replaceOrder(fix::decode<fix::OrderCancelReplaceRequest>(fixMessage), nowNanos());
     } else {
-        throw std::runtime_error("Missing order ID in FIX message");
+        auto order = fix::decode<fix::NewOrderSingle>(fixMessage, *instruments_);
+        insertOrder(order.clOrdId, order, nowNanos());
     }
 }
 
-void OrderManager::cancelOrder(const std::string& orderId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (activeOrders_.erase(orderId) == 0) {
-        throw std::runtime_error("Order not found: " + orderId);
+bool OrderManager::apply(const JournalRecord& record, Order* previous) {
+    try {
+        switch (record.type) {
+            case JournalEventType::NEW_ORDER: {
+                fix::NewOrderSingle order;
+                order.clOrdId = record.clOrdId.view();
+                order.symbol = record.symbol.view();
+                if (!order.symbol.empty()) {
+                    order.instrument = instruments_->intern(order.symbol);
+                }
+                order.account = record.account.view();
+                order.side = record.side;
+                order.ordType = record.ordType;
+                order.orderQty = Qty(record.orderQty);
+                order.price = record.price();
+                insertOrder(order.clOrdId, order, record.timestampNs);
+                break;
+            }
+            case JournalEventType::MODIFY: {
+                fix::OrderCancelReplaceRequest replace;
+                replace.clOrdId = record.clOrdId.view();
+                replace.origClOrdId = record.origClOrdId.view();
+                replace.symbol = record.symbol.view();
+                replace.side = record.side;
+                replace.ordType = record.ordType;
+                replace.orderQty = Qty(record.orderQty);
+                replace.price = record.price();
+                replaceOrder(replace, record.timestampNs, previous);
+                break;
+            }
+            case JournalEventType::CANCEL:
+                removeOrder(record.origClOrdId.view(), previous);
+                break;
+            default:
+                return false;
+        }
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    return true;
+}
+
+void OrderManager::restoreOrders(const Order* orders, std::size_t count) {
+    uint64_t highestOrderId = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Key key(orders[i].clOrdId.view());
+        Shard& shard = shardFor(key);
+        auto lock = lockShard(shard);
+        if (shard.findSlot(key) != kNoSlot) {
+            throw std::runtime_error("Order ID already exists: " + key.id.str());
+        }
+        shard.insert(key, orders[i]);
+        highestOrderId = std::max(highestOrderId, orders[i].orderId);
+    }
+
+    // Move each shard's id sequence past the restored ids without leaving
+    // its residue class, so shards still never hand out the same id
+    uint64_t stride = shards_.size();
+    for (const auto& shard : shards_) {
+        auto lock = lockShard(*shard);
+        if (shard->nextOrderId <= highestOrderId) {
+            shard->nextOrderId += ((highestOrderId - shard->nextOrderId) / stride + 1) * stride;
+        }
     }
 }
 
+void OrderManager::cancelOrder(const std::string& orderId) {
+    removeOrder(orderId);
+}
+
 void OrderManager::modifyOrder(const std::string& orderId, const std::string& newDetails) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = activeOrders_.find(orderId);
-    if (it == activeOrders_.end()) {
+    FixMessageHandler fixHandler;
+    auto fields = fixHandler.parseFixMessageView(newDetails);
+    for (int tag : {fix::tag::Side, fix::tag::OrdType, fix::tag::Price, fix::tag::OrderQty}) {
+        if (fields.has(tag) && fields.get(tag).empty()) {
+            throw std::invalid_argument("Empty value for tag " + std::to_string(tag));
+        }
+    }
+
+    std::optional<Key> key;
+    if (!tryMakeKey(orderId, key)) {
         throw std::runtime_error("Order not found: " + orderId);
     }
-    it->second = newDetails;
+    Shard& shard = shardFor(*key);
+    auto lock = lockShard(shard);
+    uint32_t slot = shard.findSlot(*key);
+    if (slot == kNoSlot) {
+        throw std::runtime_error("Order not found: " + orderId);
+    }
+
+    Order& order = shard.orders[slot];
+    if (fields.has(fix::tag::Side)) {
+        order.side = fields.get(fix::tag::Side)[0];
+    }
+    if (fields.has(fix::tag::OrdType)) {
+        order.ordType = fields.get(fix::tag::OrdType)[0];
+    }
+    if (fields.has(fix::tag::Price)) {
+        order.price = Price::parse(fields.get(fix::tag::Price));
+    }
+    if (fields.has(fix::tag::OrderQty)) {
+        order.orderQty = Qty::parse(fields.get(fix::tag::OrderQty));
+    }
+    order.updatedNs = nowNanos();
 }
 
 bool OrderManager::orderExists(const std::string& orderId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return activeOrders_.find(orderId) != activeOrders_.end();
+    return getOrder(orderId).has_value();
+}
+
+std::size_t OrderManager::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) {
+        auto lock = lockShard(*shard);
+        total += shard->index.size();
+    }
+    return total;
+}
+
+void OrderManager::insertOrder(std::string_view orderId, const fix::NewOrderSingle& decoded,
+                               int64_t nowNs) {
+    Key key(orderId);
+    Shard& shard = shardFor(key);
+    auto lock = lockShard(shard);
+    shard.insertNew(key, decoded, shards_.size(), nowNs);
+}
+
+void OrderManager::removeOrder(std::string_view orderId, Order* previous) {
+    std::optional<Key> key;
+    if (!tryMakeKey(orderId, key)) {
+        throw std::runtime_error("Order not found: " + std::string(orderId));
+    }
+    Shard& shard = shardFor(*key);
+    auto lock = lockShard(shard);
+    uint32_t slot = shard.findSlot(*key);
+    if (slot == kNoSlot) {
+        throw std::runtime_error("Order not found: " + std::string(orderId));
+    }
+    if (previous) {
+        *previous = shard.orders[slot];
+    }
+    shard.remove(*key, slot);
+}
+
+void OrderManager::replaceOrder(const fix::OrderCancelReplaceRequest& replace, int64_t nowNs,
+                                Order* previous) {
+    std::optional<Key> oldKey;
+    if (!tryMakeKey(replace.origClOrdId, oldKey)) {
+        throw std::runtime_error("Order not found: " + std::string(replace.origClOrdId));
+    }
+    Key newKey(replace.clOrdId);
+
+    // The order is re-keyed under its new ClOrdID, which may live in another
+    // shard; lock both in address order so concurrent replaces cannot deadlock
+    Shard& from = shardFor(*oldKey);
+    Shard& to = shardFor(newKey);
+    std::unique_lock<std::mutex> first = lockShard(&from < &to ? from : to);
+    std::unique_lock<std::mutex> second;
+    if (&from != &to) {
+        second = lockShard(&from < &to ? to : from);
+    }
+
+    uint32_t slot = from.findSlot(*oldKey);
+    if (slot == kNoSlot) {
+        throw std::runtime_error("Order not found: " + std::string(replace.origClOrdId));
+    }
+    if (newKey.id != oldKey->id && to.findSlot(newKey) != kNoSlot) {
+        throw std::runtime_error("Order ID already exists: " + std::string(replace.clOrdId));
+    }
+
+    Order order = from.orders[slot];
+    if (previous) {
+        *previous = order;
+    }
+    from.remove(*oldKey, slot);
+
+    order.side = replace.side;
+    if (replace.ordType != 0) {
+        order.ordType = replace.ordType;
+    }
+    if (!replace.price.isZero()) {
+        order.price = replace.price;
+    }
+    order.orderQty = replace.orderQty;
+    order.state = OrderState::REPLACED;
+    order.updatedNs = nowNs;
+    to.insert(newKey, order);
 }
@@ -0,0 +1,504 @@
+// src/OrderPipeline.cpp
+#include "OrderPipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+    // Polls that spin before a publisher waiting on the ring yields its core
+    constexpr int kSpinLimit = 1024;
+
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t steadyNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void appendSide(std::string& out, char side) {
+        out += side == fix::side::Buy ? "BUY" : "SELL";
+    }
+}
+
+const char* pipelineStageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::DECODE: return "decode";
+        case PipelineStage::RISK: return "risk";
+        case PipelineStage::ORDER_STATE: return "order state";
+        case PipelineStage::JOURNAL: return "journal";
+        case PipelineStage::ENCODE: return "encode";
+    }
+    return "unknown";
+}
+
+OrderPipeline::OrderPipeline(const PipelineConfig& config, std::shared_ptr<OrderManager> orders,
+                             std::shared_ptr<OrderJournal> journal,
+                             std::shared_ptr<RiskChecker> riskChecker)
+    : config_(config)
+    , orders_(std::move(orders))
+    , journal_(std::move(journal))
+    , riskChecker_(std::move(riskChecker)) {
+    if (!orders_ || !orders_->singleWriter()) {
+        throw std::invalid_argument("OrderPipeline needs an OrderManager built for a single writer");
+    }
+    std::size_t capacity = roundUpToPowerOfTwo(config.capacity < 2 ? 2 : config.capacity);
+    mask_ = capacity - 1;
+    slots_ = std::make_unique<Slot[]>(capacity);
+    if (journal_) {
+        journalNext_ = journal_->lastSequence() + 1;
+        journalEnd_ = journal_->endSequence();
+    }
+    for (std::size_t i = 0; i < kPipelineStages; ++i) {
+        stages_[i].waiter = std::make_unique<Waiter>(config.wait[i]);
+    }
+
+    using S = PipelineStage;
+    stage(S::DECODE).thread = std::thread([this] {
+        runStage(S::DECODE, {S::RISK},
+                 [this](uint64_t next) {
+                     // Publishers may finish out of order; stop at the first gap
+                     uint64_t end = next;
+                     while (slots_[end & mask_].published.load(std::memory_order_acquire) == end + 1) {
+                         ++end;
+                     }
+                     return end;
+                 },
+                 [this](uint64_t next) {
+                     return !running_.load(std::memory_order_acquire) &&
+                            claimed_.load(std::memory_order_acquire) == next;
+                 },
+                 [this](PipelineEvent& event) { decode(event); });
+    });
+    auto after = [this](PipelineStage upstream) {
+        return [this, upstream](uint64_t) { return stage(upstream).cursor.load(std::memory_order_acquire); };
+    };
+    auto doneAfter = [this](PipelineStage upstream) {
+        return [this, upstream](uint64_t next) {
+            return stage(upstream).finished.load(std::memory_order_acquire) &&
+                   stage(upstream).cursor.load(std::memory_order_acquire) == next;
+        };
+    };
+    stage(S::RISK).thread = std::thread([this, after, doneAfter] {
+        runStage(S::RISK, {S::ORDER_STATE}, after(S::DECODE), doneAfter(S::DECODE),
+                 [this](PipelineEvent& event) { checkRisk(event); });
+    });
+    stage(S::ORDER_STATE).thread = std::thread([this, after, doneAfter] {
+        runStage(S::ORDER_STATE, {S::JOURNAL, S::ENCODE}, after(S::RISK), doneAfter(S::RISK),
+                 [this](PipelineEvent& event) { applyToOrders(event); });
+    });
+    stage(S::JOURNAL).thread = std::thread([this, after, doneAfter] {
+        runStage(S::JOURNAL, {S::ENCODE}, after(S::ORDER_STATE), doneAfter(S::ORDER_STATE),
+                 [this](PipelineEvent& event) { appendToJournal(event); });
+    });
+    stage(S::ENCODE).thread = std::thread([this] { runEncode(); });
+}
+
+OrderPipeline::~OrderPipeline() {
+    stop();
+}
+
+void OrderPipeline::stop() {
+    running_.store(false, std::memory_order_release);
+    stage(PipelineStage::DECODE).waiter->notifyAll();
+    // Upstream first, so each stage sees the one before it finish
+    for (auto& state : stages_) {
+        if (state.thread.joinable()) {
+            state.thread.join();
+        }
+    }
+}
+
+uint64_t OrderPipeline::publish(std::string_view request, PipelineContextPtr context, PipelineRequest kind) {
+    uint64_t position = claimed_.fetch_add(1, std::memory_order_relaxed);
+    const Stage& encode = stage(PipelineStage::ENCODE);
+    // Wait until ENCODE has emitted this slot's previous lap
+    for (int spins = 0; position > mask_ && encode.cursor.load(std::memory_order_acquire) < position - mask_;
+         ++spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    Slot& slot = slots_[position & mask_];
+    slot.event.request.assign(request.data(), request.size());
+    slot.event.kind = kind;
+    slot.event.context = std::move(context);
+    slot.event.publishedNs = steadyNanos();
+    slot.published.store(position + 1, std::memory_order_release);
+    stage(PipelineStage::DECODE).waiter->notify();
+    return position + 1;
+}
+
+void OrderPipeline::waitCompleted(uint64_t ticket) const {
+    for (int spins = 0; completed() < ticket; ++spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint64_t OrderPipeline::completed() const {
+    return stage(PipelineStage::ENCODE).cursor.load(std::memory_order_acquire);
+}
+
+template<typename Available, typename UpstreamDone, typename Handle>
+void OrderPipeline::runStage(PipelineStage self, std::initializer_list<PipelineStage> downstream,
+                             Available&& available, UpstreamDone&& upstreamDone, Handle&& handle) {
+    Stage& state = stage(self);
+    uint64_t next = 0;
+    while (true) {
+        uint64_t end = next;
+        bool done = false;
+        state.waiter->wait([&] {
+            end = available(next);
+            if (end > next) {
+                return true;
+            }
+            done = upstreamDone(next);
+            return done;
+        });
+        if (done) {
+            break;
+        }
+
+        int64_t start = steadyNanos();
+        for (; next < end; ++next) {
+            handle(event(next));
+        }
+        state.busyNs.fetch_add(static_cast<uint64_t>(steadyNanos() - start), std::memory_order_relaxed);
+        state.cursor.store(next, std::memory_order_release);
+        for (PipelineStage dependent : downstream) {
+            stage(dependent).waiter->notify();
+        }
+    }
+    state.finished.store(true, std::memory_order_release);
+    for (PipelineStage dependent : downstream) {
+        stage(dependent).waiter->notifyAll();
+    }
+}
+
+void OrderPipeline::runEncode() {
+    Stage& state = stage(PipelineStage::ENCODE);
+    const Stage& orderState = stage(PipelineStage::ORDER_STATE);
+    const Stage& journal = stage(PipelineStage::JOURNAL);
+    uint64_t formatted = 0;
+    uint64_t emitted = 0;
+    while (true) {
+        uint64_t settled = formatted;
+        uint64_t journaled = emitted;
+        bool done = false;
+        state.waiter->wait([&] {
+            settled = orderState.cursor.load(std::memory_order_acquire);
+            journaled = journal.cursor.load(std::memory_order_acquire);
+            if (settled > formatted || journaled > emitted) {
+                return true;
+            }
+            done = journal.finished.load(std::memory_order_acquire) &&
+                   journal.cursor.load(std::memory_order_acquire) == emitted;
+            return done;
+        });
+        if (done) {
+            break;
+        }
+
+        int64_t start = steadyNanos();
+        // Format whatever the order state has settled, journaled or not
+        for (; formatted < settled; ++formatted) {
+            encode(event(formatted));
+        }
+
+        // Emit only what the journal has also passed
+        uint64_t end = std::min(formatted, journaled);
+        if (config_.ackAfterDurable && journal_) {
+            uint64_t lastSequence = 0;
+            for (uint64_t i = emitted; i < end; ++i) {
+                lastSequence = std::max(lastSequence, event(i).journalSequence);
+            }
+            if (lastSequence != 0) {
+                journal_->waitDurable(lastSequence);
+            }
+        }
+        int64_t now = steadyNanos();
+        for (; emitted < end; ++emitted) {
+            PipelineEvent& current = event(emitted);
+            auto latency = static_cast<uint64_t>(now - current.publishedNs);
+            latencyNs_.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > maxLatencyNs_.load(std::memory_order_relaxed)) {
+                maxLatencyNs_.store(latency, std::memory_order_relaxed);
+            }
+            if (config_.onResponse) {
+                config_.onResponse(current);
+            }
+            current.context.reset();
+        }
+        state.busyNs.fetch_add(static_cast<uint64_t>(steadyNanos() - start), std::memory_order_relaxed);
+        state.cursor.store(emitted, std::memory_order_release);
+    }
+    state.finished.store(true, std::memory_order_release);
+}
+
+void OrderPipeline::reject(PipelineEvent& event, std::string_view error) {
+    event.rejected = true;
+    event.error.assign(error.data(), error.size());
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OrderPipeline::decode(PipelineEvent& event) {
+    // Everything but the request is left over from the slot's previous lap
+    event.record = JournalRecord{};
+    event.newOrder = fix::NewOrderSingle{};
+    event.account = 0;
+    event.rejected = false;
+    event.error.clear();
+    event.exposureReserved = false;
+    event.journaled = false;
+    event.journalSequence = 0;
+    event.response.clear();
+
+    if (event.kind == PipelineRequest::RESPONSE) {
+        return;
+    }
+    try {
+        std::string_view account = event.kind == PipelineRequest::BINARY ? decodeBinary(event) : decodeText(event);
+        if (riskChecker_) {
+            event.account = riskChecker_->account(account);
+        }
+    } catch (const std::exception& e) {
+        reject(event, e.what());
+    }
+}
+
+std::string_view OrderPipeline::decodeText(PipelineEvent& event) {
+    std::string_view msgType = fix::messageType(event.request);
+    if (msgType == fix::NewOrderSingle::kMsgType) {
+        event.newOrder = fix::decode<fix::NewOrderSingle>(event.request, orders_->instruments());
+        event.record = JournalRecord::newOrder(event.newOrder);
+        return event.newOrder.account;
+    }
+    if (msgType == fix::OrderCancelRequest::kMsgType) {
+        auto cancel = fix::decode<fix::OrderCancelRequest>(event.request, orders_->instruments());
+        event.record = JournalRecord::cancel(cancel);
+        return cancel.account;
+    }
+    if (msgType == fix::OrderCancelReplaceRequest::kMsgType) {
+        auto replace = fix::decode<fix::OrderCancelReplaceRequest>(event.request, orders_->instruments());
+        event.record = JournalRecord::modify(replace);
+        return replace.account;
+    }
+    throw std::invalid_argument("Unsupported MsgType: " + std::string(msgType));
+}
+
+std::string_view OrderPipeline::decodeBinary(PipelineEvent& event) {
+    // The typed messages view the slot's copy of the request, as for text
+    uint16_t templateId = binary::templateId(event.request);
+    switch (templateId) {
+        case binary::NewOrder::kTemplateId:
+            event.newOrder = binary::decode(binary::overlay<binary::NewOrder>(event.request), orders_->instruments());
+            event.record = JournalRecord::newOrder(event.newOrder);
+            return event.newOrder.account;
+        case binary::Cancel::kTemplateId: {
+            auto cancel = binary::decode(binary::overlay<binary::Cancel>(event.request), orders_->instruments());
+            event.record = JournalRecord::cancel(cancel);
+            return cancel.account;
+        }
+        case binary::Replace::kTemplateId: {
+            auto replace = binary::decode(binary::overlay<binary::Replace>(event.request), orders_->instruments());
+            event.record = JournalRecord::modify(replace);
+            return replace.account;
+        }
+    }
+    throw std::invalid_argument("Unsupported binary template: " + std::to_string(templateId));
+}
+
+void OrderPipeline::checkRisk(PipelineEvent& event) {
+    // Checks that need an existing order run in the order state stage
+    if (event.rejected || event.kind == PipelineRequest::RESPONSE || !riskChecker_ ||
+        event.record.type != JournalEventType::NEW_ORDER) {
+        return;
+    }
+    RiskCheck check = riskChecker_->checkNewOrder(event.newOrder, event.account, steadyNanos());
+    if (check != RiskCheck::PASSED) {
+        reject(event, std::string("Risk check failed: ") + riskCheckName(check));
+        return;
+    }
+    event.exposureReserved = event.newOrder.ordType != fix::ord_type::Market;
+}
+
+void OrderPipeline::applyToOrders(PipelineEvent& event) {
+    if (event.rejected || event.kind == PipelineRequest::RESPONSE) {
+        return;
+    }
+    JournalRecord& record = event.record;
+    auto releaseReserved = [&] {
+        if (event.exposureReserved) {
+            riskChecker_->release(event.account, event.newOrder.price, event.newOrder.orderQty);
+        }
+    };
+    // JOURNAL trails this stage, so the journal's room is tracked here; it
+    // only needs asking again once the known room runs out
+    if (journal_ && journalNext_ > journalEnd_ && (journalEnd_ = journal_->endSequence()) < journalNext_) {
+        releaseReserved();
+        reject(event, "Journal full");
+        return;
+    }
+
+    std::optional<Order> existing;
+    Price existingPrice;
+    Qty existingLeaves;
+    if (record.type != JournalEventType::NEW_ORDER) {
+        existing = orders_->getOrder(record.origClOrdId.view());
+        if (existing) {
+            existingPrice = existing->price;
+            existingLeaves = existing->leavesQty();
+        }
+    }
+
+    int64_t exposureDelta = 0;
+    if (riskChecker_ && existing && record.type == JournalEventType::MODIFY) {
+        fix::OrderCancelReplaceRequest replace;
+        replace.price = record.price();
+        replace.orderQty = Qty(record.orderQty);
+        RiskCheck check = riskChecker_->checkReplace(replace, event.account, *existing, steadyNanos(),
+                                                     exposureDelta);
+        if (check != RiskCheck::PASSED) {
+            reject(event, std::string("Risk check failed: ") + riskCheckName(check));
+            return;
+        }
+    }
+
+    // Stamped here, so the journal and the live state agree on the time
+    if (record.timestampNs == 0) {
+        record.timestampNs = nowNanos();
+    }
+    bool applied = orders_->apply(record);
+    // Failed attempts are journaled too: replaying one fails the same way
+    event.journaled = journal_ != nullptr;
+    if (journal_) {
+        ++journalNext_;
+    }
+
+    if (!applied) {
+        if (riskChecker_) {
+            releaseReserved();
+            riskChecker_->adjustExposure(event.account, -exposureDelta);
+        }
+        reject(event, record.type == JournalEventType::NEW_ORDER ? "Duplicate ClOrdID" : "Unknown order");
+    } else if (riskChecker_ && existing && record.type == JournalEventType::CANCEL) {
+        riskChecker_->release(event.account, existingPrice, existingLeaves);
+    }
+}
+
+void OrderPipeline::appendToJournal(PipelineEvent& event) {
+    // ORDER_STATE kept count of the room left, so this cannot run out
+    if (event.journaled) {
+        event.journalSequence = journal_->append(event.record);
+    }
+}
+
+void OrderPipeline::encode(PipelineEvent& event) {
+    std::string& out = event.response;
+    if (event.kind == PipelineRequest::RESPONSE) {
+        out.assign(event.request);
+        return;
+    }
+    if (event.kind == PipelineRequest::BINARY) {
+        encodeBinary(event);
+        return;
+    }
+    if (event.rejected) {
+        out += "NAK|Error=";
+        out += event.error;
+        return;
+    }
+    const JournalRecord& record = event.record;
+    out += "ACK|OrderID=";
+    out += record.clOrdId.view();
+    out += '|';
+    if (record.type != JournalEventType::NEW_ORDER) {
+        out += "OrigOrderID=";
+        out += record.origClOrdId.view();
+        out += '|';
+    }
+    if (record.type == JournalEventType::CANCEL) {
+        out += "Status=CANCEL_ACCEPTED|";
+    } else {
+        out += "Symbol=";
+        out += record.symbol.view();
+        out += "|Side=";
+        appendSide(out, record.side);
+        out += "|Quantity=";
+        out += std::to_string(record.orderQty);
+        out += "|Price=";
+        out += record.price().toString();
+        out += record.type == JournalEventType::NEW_ORDER ? "|Status=ACCEPTED|" : "|Status=REPLACE_ACCEPTED|";
+    }
+    out += "ProcessingTime=";
+    out += std::to_string((steadyNanos() - event.publishedNs) / 1000);
+    out += "us";
+}
+
+void OrderPipeline::encodeBinary(PipelineEvent& event) {
+    binary::ExecutionReport report{};
+    binary::initHeader(report);
+    try {
+        binary::echoRequest(event.request, report);
+    } catch (const std::invalid_argument&) {
+        // Decode turned it down for the same reason; there is nothing to echo
+    }
+    if (event.rejected) {
+        report.ordStatus = fix::status::Rejected;
+        binary::setTruncatedText(report.text, event.error);
+    } else {
+        switch (event.record.type) {
+            case JournalEventType::NEW_ORDER: report.ordStatus = fix::status::New; break;
+            case JournalEventType::MODIFY: report.ordStatus = fix::status::Replaced; break;
+            case JournalEventType::CANCEL: report.ordStatus = fix::status::Canceled; break;
+        }
+    }
+    report.execType = report.ordStatus;
+    event.response.assign(reinterpret_cast<const char*>(&report), sizeof report);
+}
+
+PipelineStats OrderPipeline::stats() const {
+    PipelineStats result;
+    uint64_t upstream = claimed_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < kPipelineStages; ++i) {
+        const Stage& state = stages_[i];
+        PipelineStageStats& out = result.stages[i];
+        out.stage = static_cast<PipelineStage>(i);
+        out.processed = state.cursor.load(std::memory_order_acquire);
+        if (out.stage == PipelineStage::ENCODE) {
+            // ENCODE waits on ORDER_STATE, not on JOURNAL just before it
+            upstream = stages_[static_cast<std::size_t>(PipelineStage::ORDER_STATE)].cursor.load(
+                std::memory_order_acquire);
+        }
+        out.backlog = upstream > out.processed ? upstream - out.processed : 0;
+        if (out.processed > 0) {
+            out.averageNs = static_cast<double>(state.busyNs.load(std::memory_order_relaxed)) /
+                            static_cast<double>(out.processed);
+        }
+        upstream = out.processed;
+    }
+    result.completed = completed();
+    result.rejected = rejected_.load(std::memory_order_relaxed);
+    if (result.completed > 0) {
+        result.averageLatencyNs = static_cast<double>(latencyNs_.load(std::memory_order_relaxed)) /
+                                  static_cast<double>(result.completed);
+    }
+    result.maxLatencyNs = maxLatencyNs_.load(std::memory_order_relaxed);
+    return result;
+}
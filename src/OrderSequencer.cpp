@@ -0,0 +1,212 @@
+// src/OrderSequencer.cpp
+#include "OrderSequencer.hpp"
+#include <chrono>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+    // Polls that spin before a publisher waiting on the ring yields its core
+    constexpr int kSpinLimit = 1024;
+
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t steadyNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::size_t roundUpToPowerOfTwo(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+OrderSequencer::OrderSequencer(const SequencerConfig& config, std::shared_ptr<OrderManager> orders,
+                               std::shared_ptr<OrderJournal> journal,
+                               std::shared_ptr<RiskChecker> riskChecker)
+    : config_(config)
+    , orders_(std::move(orders))
+    , journal_(std::move(journal))
+    , riskChecker_(std::move(riskChecker))
+    , waiter_(config.wait) {
+    if (!orders_ || !orders_->singleWriter()) {
+        throw std::invalid_argument("OrderSequencer needs an OrderManager built for a single writer");
+    }
+    std::size_t capacity = roundUpToPowerOfTwo(config.capacity < 2 ? 2 : config.capacity);
+    mask_ = capacity - 1;
+    slots_ = std::make_unique<Slot[]>(capacity);
+    // A slot is free for the producer of position p once its sequence is p
+    for (std::size_t i = 0; i < capacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    thread_ = std::thread([this] { run(); });
+    if (config.cpu >= 0) {
+        // Best effort: an unavailable core leaves the thread unpinned
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(config.cpu, &cpus);
+        pthread_setaffinity_np(thread_.native_handle(), sizeof(cpus), &cpus);
+    }
+}
+
+OrderSequencer::~OrderSequencer() {
+    stop();
+}
+
+void OrderSequencer::stop() {
+    running_.store(false, std::memory_order_release);
+    waiter_.notifyAll();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+uint64_t OrderSequencer::publish(const JournalRecord& record, AccountId account, SequencerOutcome* outcome) {
+    uint64_t position = claimed_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[position & mask_];
+    // Wait for the sequencer to finish with this slot's previous lap
+    for (int spins = 0; slot.sequence.load(std::memory_order_acquire) != position; ++spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    slot.record = record;
+    slot.account = account;
+    slot.outcome = outcome;
+    slot.sequence.store(position + 1, std::memory_order_release);
+    waiter_.notify();
+    return position + 1;
+}
+
+void OrderSequencer::waitProcessed(uint64_t ticket) const {
+    for (int spins = 0; processed() < ticket; ++spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void OrderSequencer::wait(const SequencerOutcome& outcome) {
+    for (int spins = 0; !outcome.done.load(std::memory_order_acquire); ++spins) {
+        if (spins < kSpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void OrderSequencer::waitDurable(uint64_t ticket) const {
+    waitProcessed(ticket);
+    if (journal_) {
+        // Everything journaled so far includes this event; waiting for all of
+        // it may overshoot by a few events but needs no ticket-to-sequence map
+        journal_->waitDurable(journal_->lastSequence());
+    }
+}
+
+void OrderSequencer::run() {
+    while (true) {
+        Slot& slot = slots_[next_ & mask_];
+        bool drained = false;
+        waiter_.wait([&] {
+            if (slot.sequence.load(std::memory_order_acquire) == next_ + 1) {
+                return true;
+            }
+            // Stop only once every claimed position has been published and applied
+            drained = !running_.load(std::memory_order_acquire) &&
+                      claimed_.load(std::memory_order_acquire) == next_;
+            return drained;
+        });
+        if (drained) {
+            break;
+        }
+
+        JournalRecord record = slot.record;
+        AccountId account = slot.account;
+        SequencerOutcome* outcome = slot.outcome;
+        // Hand the slot back to producers for the next lap
+        slot.sequence.store(next_ + mask_ + 1, std::memory_order_release);
+        ++next_;
+
+        RiskCheck risk = RiskCheck::PASSED;
+        bool applied = process(record, account, risk);
+        if (outcome) {
+            outcome->applied = applied;
+            outcome->risk = risk;
+            outcome->done.store(true, std::memory_order_release);
+        }
+        processed_.store(next_, std::memory_order_release);
+        if (config_.onProcessed) {
+            config_.onProcessed(next_, applied);
+        }
+    }
+}
+
+bool OrderSequencer::process(JournalRecord& record, AccountId account, RiskCheck& risk) {
+    std::optional<Order> existing;
+    Price existingPrice;
+    Qty existingLeaves;
+    if (record.type != JournalEventType::NEW_ORDER) {
+        existing = orders_->getOrder(record.origClOrdId.view());
+        if (existing) {
+            existingPrice = existing->price;
+            existingLeaves = existing->leavesQty();
+        }
+    }
+
+    int64_t exposureDelta = 0;
+    if (riskChecker_ && existing && record.type == JournalEventType::MODIFY) {
+        fix::OrderCancelReplaceRequest replace;
+        replace.price = record.price();
+        replace.orderQty = Qty(record.orderQty);
+        risk = riskChecker_->checkReplace(replace, account, *existing, steadyNanos(), exposureDelta);
+        if (risk != RiskCheck::PASSED) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // Stamped here, so the journal and the live state agree on the time
+    if (record.timestampNs == 0) {
+        record.timestampNs = nowNanos();
+    }
+    bool applied = true;
+    if (journal_) {
+        try {
+            journal_->append(record);
+        } catch (const std::length_error&) {
+            applied = false;
+        }
+    }
+    applied = applied && orders_->apply(record);
+
+    if (riskChecker_) {
+        if (!applied && record.type == JournalEventType::NEW_ORDER) {
+            // Reserved by the new-order check on the network thread
+            if (record.ordType != fix::ord_type::Market) {
+                riskChecker_->release(account, record.price(), Qty(record.orderQty));
+            }
+        } else if (!applied) {
+            riskChecker_->adjustExposure(account, -exposureDelta);
+        } else if (existing && record.type == JournalEventType::CANCEL) {
+            riskChecker_->release(account, existingPrice, existingLeaves);
+        }
+    }
+    if (!applied) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return applied;
+}
@@ -0,0 +1,408 @@
+// src/OrderSnapshot.cpp
+#include "OrderSnapshot.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char kMagic[8] = {'G', 'W', 'S', 'N', 'A', 'P', '0', '1'};
+    constexpr uint32_t kVersion = 2;  // 2: orders carry the account
+    constexpr const char* kPrefix = "orders-";
+    constexpr const char* kExtension = ".snap";
+    // Orders are copied in and out in batches of this many
+    constexpr std::size_t kBatch = 4096;
+
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t orderSize;
+        uint64_t journalSequence;
+        uint64_t orderCount;
+        uint32_t symbolCount;
+        uint32_t anchorChecksum;  // Checksum of journal event journalSequence
+        int64_t createdNs;
+        uint64_t payloadChecksum;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(SnapshotHeader) == 64, "Orders should start on a cache line");
+    static_assert(std::is_trivially_copyable<Order>::value, "Orders are written as raw bytes");
+    static_assert(sizeof(SymbolCode) % 8 == 0, "Checksum runs over whole words");
+
+    // 64-bit FNV-1a taken a word at a time; every section is a whole number
+    // of words, and word steps keep verification well below the cost of the
+    // copy it guards
+    class PayloadChecksum {
+    public:
+        void update(const void* data, std::size_t bytes) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < bytes; i += sizeof(uint64_t)) {
+                uint64_t word;
+                std::memcpy(&word, p + i, sizeof(word));
+                hash_ = (hash_ ^ word) * 1099511628211ull;
+            }
+        }
+        uint64_t value() const { return hash_; }
+
+    private:
+        uint64_t hash_{14695981039346656037ull};
+    };
+
+    std::runtime_error systemError(const std::string& what, const std::string& path) {
+        return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    class FileDescriptor {
+    public:
+        explicit FileDescriptor(int fd) : fd_(fd) {}
+        ~FileDescriptor() {
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+        }
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+        int get() const { return fd_; }
+
+    private:
+        int fd_;
+    };
+
+    void writeAll(int fd, const void* data, std::size_t bytes, const std::string& path) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t written = ::write(fd, p, bytes);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw systemError("Cannot write order snapshot", path);
+            }
+            p += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+    }
+
+    uint32_t anchorFor(const OrderJournal* journal, uint64_t sequence) {
+        return journal && sequence > 0 ? journal->record(sequence).checksum : 0;
+    }
+
+    std::string snapshotName(uint64_t journalSequence) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "%s%020" PRIu64 "%s", kPrefix, journalSequence, kExtension);
+        return name;
+    }
+
+    uint64_t sequenceFromName(const std::string& path) {
+        std::string name = std::filesystem::path(path).stem().string();
+        return std::strtoull(name.c_str() + std::strlen(kPrefix), nullptr, 10);
+    }
+
+    class Mapping {
+    public:
+        Mapping(void* address, std::size_t size) : address_(address), size_(size) {}
+        ~Mapping() { ::munmap(address_, size_); }
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+        const char* data() const { return static_cast<const char*>(address_); }
+
+    private:
+        void* address_;
+        std::size_t size_;
+    };
+}
+
+SnapshotInfo writeOrderSnapshot(const std::string& directory, const OrderManager& orders,
+                                uint64_t journalSequence, const OrderJournal* journal) {
+    std::filesystem::create_directories(directory);
+    SnapshotInfo info;
+    info.path = (std::filesystem::path(directory) / snapshotName(journalSequence)).string();
+    info.journalSequence = journalSequence;
+    std::string temporary = info.path + ".tmp";
+
+    FileDescriptor file(::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    if (file.get() < 0) {
+        throw systemError("Cannot create order snapshot", temporary);
+    }
+
+    // The header goes in last, once the counts and checksum are known
+    SnapshotHeader header{};
+    writeAll(file.get(), &header, sizeof(header), temporary);
+
+    PayloadChecksum checksum;
+    std::vector<Order> batch;
+    batch.reserve(kBatch);
+    auto writeBatch = [&] {
+        std::size_t bytes = batch.size() * sizeof(Order);
+        checksum.update(batch.data(), bytes);
+        writeAll(file.get(), batch.data(), bytes, temporary);
+        info.orders += batch.size();
+        batch.clear();
+    };
+    orders.forEachOrder([&](const Order& order) {
+        batch.push_back(order);
+        if (batch.size() == kBatch) {
+            writeBatch();
+        }
+    });
+    writeBatch();
+
+    // Taken after the orders so it covers any symbol they refer to
+    const InstrumentRegistry& instruments = orders.instruments();
+    std::size_t symbolCount = instruments.size();
+    std::vector<SymbolCode> symbols(symbolCount);
+    for (std::size_t id = 0; id < symbolCount; ++id) {
+        symbols[id] = instruments.instrument(static_cast<InstrumentId>(id)).symbol;
+    }
+    checksum.update(symbols.data(), symbols.size() * sizeof(SymbolCode));
+    writeAll(file.get(), symbols.data(), symbols.size() * sizeof(SymbolCode), temporary);
+
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.orderSize = sizeof(Order);
+    header.journalSequence = journalSequence;
+    header.orderCount = info.orders;
+    header.symbolCount = static_cast<uint32_t>(symbolCount);
+    header.anchorChecksum = anchorFor(journal, journalSequence);
+    header.createdNs = nowNanos();
+    header.payloadChecksum = checksum.value();
+    if (::pwrite(file.get(), &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        ::fsync(file.get()) != 0) {
+        throw systemError("Cannot write order snapshot", temporary);
+    }
+
+    if (::rename(temporary.c_str(), info.path.c_str()) != 0) {
+        throw systemError("Cannot rename order snapshot", temporary);
+    }
+    // Make the rename itself durable
+    FileDescriptor dir(::open(directory.c_str(), O_RDONLY | O_DIRECTORY));
+    if (dir.get() >= 0) {
+        ::fsync(dir.get());
+    }
+    return info;
+}
+
+SnapshotInfo loadOrderSnapshot(const std::string& path, OrderManager& orders,
+                               const OrderJournal* journal) {
+    FileDescriptor file(::open(path.c_str(), O_RDONLY));
+    if (file.get() < 0) {
+        throw systemError("Cannot open order snapshot", path);
+    }
+    struct stat status;
+    if (::fstat(file.get(), &status) != 0) {
+        throw systemError("Cannot stat order snapshot", path);
+    }
+    std::size_t size = static_cast<std::size_t>(status.st_size);
+    if (size < sizeof(SnapshotHeader)) {
+        throw std::runtime_error("Truncated order snapshot: " + path);
+    }
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    void* mapping = ::mmap(nullptr, size, PROT_READ, flags, file.get(), 0);
+    if (mapping == MAP_FAILED) {
+        throw systemError("Cannot map order snapshot", path);
+    }
+    Mapping guard(mapping, size);
+    const char* base = guard.data();
+
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.orderSize != sizeof(Order)) {
+        throw std::runtime_error("Not an order snapshot: " + path);
+    }
+    std::size_t orderBytes = header.orderCount * sizeof(Order);
+    std::size_t symbolBytes = std::size_t{header.symbolCount} * sizeof(SymbolCode);
+    if (size != sizeof(SnapshotHeader) + orderBytes + symbolBytes) {
+        throw std::runtime_error("Truncated order snapshot: " + path);
+    }
+    PayloadChecksum checksum;
+    checksum.update(base + sizeof(SnapshotHeader), orderBytes + symbolBytes);
+    if (checksum.value() != header.payloadChecksum) {
+        throw std::runtime_error("Corrupt order snapshot: " + path);
+    }
+    // The anchor event must still be in the journal to vouch for the snapshot
+    if (journal && (header.journalSequence > journal->lastSequence() ||
+                    (header.journalSequence == 0 ? journal->firstSequence() > 1
+                                                 : header.journalSequence < journal->firstSequence()) ||
+                    header.anchorChecksum != anchorFor(journal, header.journalSequence))) {
+        throw std::runtime_error("Order snapshot does not match the journal: " + path);
+    }
+
+    std::vector<InstrumentId> instrumentMap(header.symbolCount);
+    for (uint32_t id = 0; id < header.symbolCount; ++id) {
+        SymbolCode symbol;
+        std::memcpy(&symbol, base + sizeof(SnapshotHeader) + orderBytes + id * sizeof(SymbolCode),
+                    sizeof(symbol));
+        instrumentMap[id] = orders.instruments().intern(symbol.view());
+    }
+
+    // Records are copied out rather than used in place: the mapping only
+    // guarantees page alignment for the file start, and ids need remapping
+    const char* records = base + sizeof(SnapshotHeader);
+    std::vector<Order> batch(kBatch);
+    for (std::size_t first = 0; first < header.orderCount; first += kBatch) {
+        std::size_t count = std::min<std::size_t>(kBatch, header.orderCount - first);
+        std::memcpy(static_cast<void*>(batch.data()), records + first * sizeof(Order), count * sizeof(Order));
+        for (std::size_t i = 0; i < count; ++i) {
+            InstrumentId& instrument = batch[i].instrument;
+            instrument = instrument < instrumentMap.size() ? instrumentMap[instrument] : kUnknownInstrument;
+        }
+        orders.restoreOrders(batch.data(), count);
+    }
+
+    SnapshotInfo info;
+    info.path = path;
+    info.journalSequence = header.journalSequence;
+    info.orders = header.orderCount;
+    return info;
+}
+
+std::vector<std::string> listOrderSnapshots(const std::string& directory) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file(error) && name.rfind(kPrefix, 0) == 0 &&
+            entry.path().extension() == kExtension) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    // Sequence numbers are zero-padded, so name order is sequence order
+    std::sort(paths.rbegin(), paths.rend());
+    return paths;
+}
+
+RecoveryResult recoverOrders(const std::string& snapshotDirectory, const OrderJournal& journal,
+                             OrderManager& orders, uint64_t throughSequence) {
+    auto start = std::chrono::steady_clock::now();
+    RecoveryResult result;
+
+    if (!snapshotDirectory.empty()) {
+        for (const std::string& path : listOrderSnapshots(snapshotDirectory)) {
+            if (sequenceFromName(path) > throughSequence) {
+                continue;
+            }
+            try {
+                result.snapshot = loadOrderSnapshot(path, orders, &journal);
+                break;
+            } catch (const std::runtime_error&) {
+                ++result.skippedSnapshots;
+            }
+        }
+    }
+
+    if (result.snapshot.journalSequence + 1 < journal.firstSequence()) {
+        throw std::runtime_error("Order journal starts at event " + std::to_string(journal.firstSequence()) +
+                                 ", after the newest usable snapshot");
+    }
+    uint64_t last = std::min(throughSequence, journal.lastSequence());
+    journal.replay([&](const JournalRecord& record) { orders.apply(record); },
+                   result.snapshot.journalSequence + 1, last);
+    result.replayedEvents = last > result.snapshot.journalSequence ? last - result.snapshot.journalSequence : 0;
+    result.journalSequence = std::max(last, result.snapshot.journalSequence);
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    return result;
+}
+
+OrderSnapshotter::OrderSnapshotter(const SnapshotConfig& config, std::shared_ptr<OrderJournal> journal)
+    : config_(config)
+    , journal_(std::move(journal))
+    , replica_(config.expectedOrders) {
+    if (!journal_) {
+        throw std::invalid_argument("OrderSnapshotter needs a journal");
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+OrderSnapshotter::~OrderSnapshotter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wakeup_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+uint64_t OrderSnapshotter::snapshotNow() {
+    std::lock_guard<std::mutex> lock(workMutex_);
+    catchUp();
+    return writeIfChanged();
+}
+
+void OrderSnapshotter::catchUp() {
+    uint64_t durable = journal_->durableSequence();
+    if (!recovered_) {
+        RecoveryResult recovery = recoverOrders(config_.directory, *journal_, replica_, durable);
+        appliedSequence_ = recovery.journalSequence;
+        lastSnapshot_.store(recovery.snapshot.journalSequence, std::memory_order_release);
+        recovered_ = true;
+        return;
+    }
+    journal_->replay([&](const JournalRecord& record) { replica_.apply(record); },
+                     appliedSequence_ + 1, durable);
+    appliedSequence_ = std::max(appliedSequence_, durable);
+}
+
+uint64_t OrderSnapshotter::writeIfChanged() {
+    if (appliedSequence_ == lastSnapshot_.load(std::memory_order_relaxed)) {
+        return appliedSequence_;
+    }
+    writeOrderSnapshot(config_.directory, replica_, appliedSequence_, journal_.get());
+    lastSnapshot_.store(appliedSequence_, std::memory_order_release);
+    // Later events go to a new segment, so older segments fall wholly behind
+    // the snapshots as they are taken
+    journal_->startSegment();
+
+    std::vector<std::string> snapshots = listOrderSnapshots(config_.directory);
+    std::size_t retained = std::min(std::max<std::size_t>(config_.retain, 1), snapshots.size());
+    for (std::size_t i = retained; i < snapshots.size(); ++i) {
+        std::remove(snapshots[i].c_str());
+    }
+    // Recovery from any retained snapshot replays from just after it and
+    // checks the event it was taken at
+    journal_->discardBefore(sequenceFromName(snapshots[retained - 1]));
+    return appliedSequence_;
+}
+
+void OrderSnapshotter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Rebuild the replica straight away rather than at the first interval
+    bool first = true;
+    while (running_) {
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> work(workMutex_);
+            try {
+                catchUp();
+                if (!first) {
+                    writeIfChanged();
+                }
+            } catch (const std::exception&) {
+                // A failed write (disk full, say) is retried next interval
+            }
+        }
+        first = false;
+        lock.lock();
+        wakeup_.wait_for(lock, config_.interval, [this] { return !running_; });
+    }
+}
@@ -0,0 +1,202 @@
+// src/RiskChecker.cpp
+#include "RiskChecker.hpp"
+#include <limits>
+#include "MatchingEngine.hpp"
+
+namespace {
+    constexpr int64_t kWindowNs = 1'000'000'000;
+
+    int64_t clampToInt64(fixed::Wide value) {
+        constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+        return value > kMax ? kMax : static_cast<int64_t>(value);
+    }
+}
+
+const char* riskCheckName(RiskCheck check) {
+    switch (check) {
+        case RiskCheck::PASSED: return "PASSED";
+        case RiskCheck::ORDER_QTY: return "ORDER_QTY";
+        case RiskCheck::ORDER_NOTIONAL: return "ORDER_NOTIONAL";
+        case RiskCheck::PRICE_BAND: return "PRICE_BAND";
+        case RiskCheck::OPEN_EXPOSURE: return "OPEN_EXPOSURE";
+        case RiskCheck::ORDER_RATE: return "ORDER_RATE";
+    }
+    return "UNKNOWN";
+}
+
+RiskChecker::RiskChecker(std::shared_ptr<InstrumentRegistry> instruments, const RiskLimits& limits,
+                         std::size_t maxAccounts)
+    : instruments_(std::move(instruments))
+    , limits_(limits)
+    , maxOrderNotional_(notional(limits.maxOrderNotional, Qty(1)))
+    , accountIds_(maxAccounts)
+    , accounts_(std::make_unique<AccountState[]>(maxAccounts))
+    , lastTrades_(std::make_unique<std::atomic<int64_t>[]>(instruments_->capacity())) {
+    int64_t maxOpen = notional(limits.maxOpenNotional, Qty(1));
+    for (std::size_t i = 0; i < maxAccounts; ++i) {
+        accounts_[i].maxOpenNotional.store(maxOpen, std::memory_order_relaxed);
+        accounts_[i].maxOrdersPerSecond.store(limits.maxOrdersPerSecond, std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < instruments_->capacity(); ++i) {
+        lastTrades_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+AccountId RiskChecker::account(std::string_view account) {
+    return accountIds_.intern(account);
+}
+
+void RiskChecker::setAccountLimits(AccountId account, Price maxOpenNotional, uint32_t maxOrdersPerSecond) {
+    accounts_[account].maxOpenNotional.store(notional(maxOpenNotional, Qty(1)), std::memory_order_relaxed);
+    accounts_[account].maxOrdersPerSecond.store(maxOrdersPerSecond, std::memory_order_relaxed);
+}
+
+int64_t RiskChecker::notional(const Price& price, Qty quantity) {
+    fixed::Wide value = static_cast<fixed::Wide>(price.mantissa < 0 ? -price.mantissa : price.mantissa) *
+                        quantity.value;
+    if (price.scale > kNotionalScale) {
+        int64_t divisor = fixed::kPow10[price.scale - kNotionalScale];
+        value = (value + divisor - 1) / divisor;
+    } else {
+        value *= fixed::kPow10[kNotionalScale - price.scale];
+    }
+    return clampToInt64(value);
+}
+
+Price RiskChecker::lastTrade(InstrumentId instrument) const {
+    if (instrument >= instruments_->capacity()) {
+        return Price();
+    }
+    return Price(lastTrades_[instrument].load(std::memory_order_relaxed), kTradeScale);
+}
+
+void RiskChecker::onTrade(InstrumentId instrument, const Price& price) {
+    Price scaled;
+    if (instrument < instruments_->capacity() && price.tryRescale(kTradeScale, scaled)) {
+        lastTrades_[instrument].store(scaled.mantissa, std::memory_order_relaxed);
+    }
+}
+
+void RiskChecker::onExecution(const Execution& execution) {
+    if (!execution.lastQty.isZero()) {
+        onTrade(execution.instrument, execution.lastPx);
+    }
+    // Market orders carry no price and reserved nothing
+    if (execution.price.isZero()) {
+        return;
+    }
+    if (!execution.lastQty.isZero()) {
+        release(execution.account, execution.price, execution.lastQty);
+    } else if (execution.execType == fix::status::Canceled) {
+        release(execution.account, execution.price, execution.orderQty - execution.cumQty);
+    }
+}
+
+void RiskChecker::restoreOrder(const Order& order) {
+    if (order.ordType == fix::ord_type::Market) {
+        return;
+    }
+    adjustExposure(account(order.accountCode.view()), notional(order.price, order.leavesQty()));
+}
+
+RiskCheck RiskChecker::checkOrderLimits(const Price& price, Qty quantity) const {
+    if (quantity > limits_.maxOrderQty) {
+        return RiskCheck::ORDER_QTY;
+    }
+    if (notional(price, quantity) > maxOrderNotional_) {
+        return RiskCheck::ORDER_NOTIONAL;
+    }
+    return RiskCheck::PASSED;
+}
+
+RiskCheck RiskChecker::checkPriceBand(InstrumentId instrument, const Price& price) const {
+    if (limits_.priceBandBps == 0 || instrument >= instruments_->capacity()) {
+        return RiskCheck::PASSED;
+    }
+    int64_t last = lastTrades_[instrument].load(std::memory_order_relaxed);
+    if (last == 0) {
+        return RiskCheck::PASSED;
+    }
+    Price scaled;
+    if (!price.tryRescale(kTradeScale, scaled)) {
+        return RiskCheck::PRICE_BAND;
+    }
+    fixed::Wide diff = static_cast<fixed::Wide>(scaled.mantissa) - last;
+    if (diff < 0) {
+        diff = -diff;
+    }
+    fixed::Wide reference = last < 0 ? -static_cast<fixed::Wide>(last) : static_cast<fixed::Wide>(last);
+    return diff * 10'000 > reference * limits_.priceBandBps ? RiskCheck::PRICE_BAND : RiskCheck::PASSED;
+}
+
+RiskCheck RiskChecker::checkOrderRate(AccountId account, int64_t nowNs) {
+    AccountState& state = accounts_[account];
+    int64_t windowStart = state.windowStartNs.load(std::memory_order_relaxed);
+    if (nowNs - windowStart >= kWindowNs &&
+        state.windowStartNs.compare_exchange_strong(windowStart, nowNs, std::memory_order_relaxed)) {
+        // Whoever moves the window resets its count; racing callers may land
+        // in either window, which only blurs the edge by a few orders
+        state.ordersInWindow.store(0, std::memory_order_relaxed);
+    }
+    uint32_t count = state.ordersInWindow.fetch_add(1, std::memory_order_relaxed) + 1;
+    return count > state.maxOrdersPerSecond.load(std::memory_order_relaxed) ? RiskCheck::ORDER_RATE
+                                                                            : RiskCheck::PASSED;
+}
+
+RiskCheck RiskChecker::reserveExposure(AccountId account, int64_t amount) {
+    AccountState& state = accounts_[account];
+    int64_t after = state.openNotional.fetch_add(amount, std::memory_order_relaxed) + amount;
+    if (amount > 0 && after > state.maxOpenNotional.load(std::memory_order_relaxed)) {
+        state.openNotional.fetch_sub(amount, std::memory_order_relaxed);
+        return RiskCheck::OPEN_EXPOSURE;
+    }
+    return RiskCheck::PASSED;
+}
+
+RiskCheck RiskChecker::checkNewOrder(const fix::NewOrderSingle& order, AccountId account, int64_t nowNs) {
+    bool isMarket = order.ordType == fix::ord_type::Market;
+    // A market order is sized against the last trade, if there has been one
+    Price reference = isMarket ? lastTrade(order.instrument) : order.price;
+
+    RiskCheck result = checkOrderLimits(reference, order.orderQty);
+    if (result == RiskCheck::PASSED && !isMarket) {
+        result = checkPriceBand(order.instrument, order.price);
+    }
+    if (result == RiskCheck::PASSED) {
+        result = checkOrderRate(account, nowNs);
+    }
+    if (result == RiskCheck::PASSED && !isMarket) {
+        result = reserveExposure(account, notional(order.price, order.orderQty));
+    }
+    return result;
+}
+
+int64_t RiskChecker::replaceDelta(const Order& existing, const Price& newPrice, Qty newQty) {
+    Price price = newPrice.isZero() ? existing.price : newPrice;
+    Qty newLeaves = newQty > existing.cumQty ? newQty - existing.cumQty : Qty();
+    return notional(price, newLeaves) - notional(existing.price, existing.leavesQty());
+}
+
+RiskCheck RiskChecker::checkReplace(const fix::OrderCancelReplaceRequest& replace, AccountId account,
+                                    const Order& existing, int64_t nowNs, int64_t& exposureDelta) {
+    exposureDelta = 0;
+    Price newPrice = replace.price.isZero() ? existing.price : replace.price;
+
+    RiskCheck result = checkOrderLimits(newPrice, replace.orderQty);
+    if (result == RiskCheck::PASSED) {
+        result = checkPriceBand(existing.instrument, newPrice);
+    }
+    if (result == RiskCheck::PASSED) {
+        result = checkOrderRate(account, nowNs);
+    }
+    if (result != RiskCheck::PASSED) {
+        return result;
+    }
+
+    int64_t delta = replaceDelta(existing, newPrice, replace.orderQty);
+    result = reserveExposure(account, delta);
+    if (result == RiskCheck::PASSED) {
+        exposureDelta = delta;
+    }
+    return result;
+}
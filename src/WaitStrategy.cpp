@@ -0,0 +1,42 @@
+// src/WaitStrategy.cpp
+#include "WaitStrategy.hpp"
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "The futex word must be a plain 32-bit int");
+
+const char* waitStrategyName(WaitStrategy strategy) {
+    switch (strategy) {
+        case WaitStrategy::BUSY_SPIN: return "busy-spin";
+        case WaitStrategy::SPIN_YIELD: return "spin-yield";
+        case WaitStrategy::SPIN_PARK: return "spin-park";
+        case WaitStrategy::BLOCKING: return "blocking";
+    }
+    return "unknown";
+}
+
+void Waiter::futexWait(uint32_t epoch, Clock::time_point deadline) {
+    timespec timeout{};
+    timespec* timeoutPtr = nullptr;
+    if (deadline != Clock::time_point::max()) {
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now());
+        if (remaining.count() <= 0) {
+            return;
+        }
+        timeout.tv_sec = static_cast<time_t>(remaining.count() / 1'000'000'000);
+        timeout.tv_nsec = static_cast<long>(remaining.count() % 1'000'000'000);
+        timeoutPtr = &timeout;
+    }
+    // Returns at once if a producer has bumped the epoch since we read it;
+    // spurious returns are fine, the caller re-checks
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, epoch, timeoutPtr,
+            nullptr, 0);
+}
+
+void Waiter::futexWake(bool all) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, all ? INT_MAX : 1,
+            nullptr, nullptr, 0);
+}
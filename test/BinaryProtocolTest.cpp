@@ -0,0 +1,111 @@
+// test/BinaryProtocolTest.cpp
+#include <gtest/gtest.h>
+#include "BinaryProtocol.hpp"
+#include <string>
+
+TEST(BinaryProtocolTest, NewOrderRoundTripsFromFixText) {
+    std::string wire;
+    binary::appendFromFix("35=D|49=SENDER|56=TARGET|1=ACC1|11=ORDER1|55=AAPL|54=2|44=150.25|38=300|40=2|", wire);
+    ASSERT_EQ(wire.size(), sizeof(binary::NewOrder));
+    EXPECT_EQ(binary::templateId(wire), binary::NewOrder::kTemplateId);
+
+    const auto& message = binary::overlay<binary::NewOrder>(wire);
+    EXPECT_EQ(message.header.length, sizeof(binary::NewOrder));
+    EXPECT_EQ(message.price, 15025);
+    EXPECT_EQ(message.priceScale, 2);
+
+    InstrumentRegistry instruments;
+    fix::NewOrderSingle order = binary::decode(message, instruments);
+    EXPECT_EQ(order.clOrdId, "ORDER1");
+    EXPECT_EQ(order.account, "ACC1");
+    EXPECT_EQ(order.symbol, "AAPL");
+    EXPECT_EQ(order.instrument, instruments.find("AAPL"));
+    EXPECT_EQ(order.side, fix::side::Sell);
+    EXPECT_EQ(order.ordType, fix::ord_type::Limit);
+    EXPECT_EQ(order.orderQty, Qty(300));
+    EXPECT_EQ(order.price, Price::parse("150.25"));
+    // Decoded in place: the views point into the message
+    EXPECT_EQ(order.clOrdId.data(), message.clOrdId);
+}
+
+TEST(BinaryProtocolTest, CancelAndReplaceRoundTrip) {
+    std::string wire;
+    binary::appendFromFix("35=F|11=C1|41=ORDER1|55=AAPL|54=1|38=100|", wire);
+    binary::appendFromFix("35=G|11=R1|41=ORDER1|55=MSFT|54=1|44=99.5|38=50|40=2|", wire);
+    ASSERT_EQ(wire.size(), sizeof(binary::Cancel) + sizeof(binary::Replace));
+
+    InstrumentRegistry instruments;
+    std::string_view cancelBytes(wire.data(), sizeof(binary::Cancel));
+    ASSERT_EQ(binary::templateId(cancelBytes), binary::Cancel::kTemplateId);
+    fix::OrderCancelRequest cancel = binary::decode(binary::overlay<binary::Cancel>(cancelBytes), instruments);
+    EXPECT_EQ(cancel.clOrdId, "C1");
+    EXPECT_EQ(cancel.origClOrdId, "ORDER1");
+    EXPECT_EQ(cancel.orderQty, Qty(100));
+
+    std::string_view replaceBytes = std::string_view(wire).substr(sizeof(binary::Cancel));
+    ASSERT_EQ(binary::templateId(replaceBytes), binary::Replace::kTemplateId);
+    fix::OrderCancelReplaceRequest replace = binary::decode(binary::overlay<binary::Replace>(replaceBytes), instruments);
+    EXPECT_EQ(replace.clOrdId, "R1");
+    EXPECT_EQ(replace.origClOrdId, "ORDER1");
+    EXPECT_EQ(replace.symbol, "MSFT");
+    EXPECT_EQ(replace.price, Price::parse("99.5"));
+    EXPECT_EQ(replace.orderQty, Qty(50));
+}
+
+TEST(BinaryProtocolTest, RejectsWhatItCannotEncodeOrRead) {
+    std::string wire;
+    // Longer than the fixed ClOrdID field
+    EXPECT_THROW(binary::appendFromFix("35=D|11=ABCDEFGHIJKLMNOPQRSTU|55=AAPL|54=1|38=1|", wire),
+                 std::invalid_argument);
+    EXPECT_THROW(binary::appendFromFix("35=8|37=X|17=E|150=0|39=0|55=AAPL|54=1|151=0|14=0|", wire),
+                 std::invalid_argument);
+    EXPECT_TRUE(wire.empty());
+
+    binary::appendFromFix("35=D|11=A|55=AAPL|54=1|38=1|", wire);
+    EXPECT_THROW(binary::overlay<binary::NewOrder>(std::string_view(wire).substr(0, 40)), std::invalid_argument);
+    EXPECT_THROW(binary::templateId(std::string_view(wire).substr(0, 4)), std::invalid_argument);
+    auto& header = *reinterpret_cast<binary::MessageHeader*>(wire.data());
+    header.version = binary::kVersion + 1;
+    EXPECT_THROW(binary::templateId(wire), std::invalid_argument);
+
+    binary::NewOrder missingSymbol{};
+    binary::initHeader(missingSymbol);
+    binary::setText(missingSymbol.clOrdId, "A", "ClOrdID");
+    missingSymbol.side = fix::side::Buy;
+    InstrumentRegistry instruments;
+    EXPECT_THROW(binary::decode(missingSymbol, instruments), std::invalid_argument);
+}
+
+TEST(BinaryProtocolTest, RejectsPriceScalesPriceCannotHold) {
+    std::string wire;
+    binary::appendFromFix("35=D|11=A|55=AAPL|54=1|44=1.5|38=1|", wire);
+    binary::appendFromFix("35=G|11=R|41=A|55=AAPL|54=1|44=1.5|38=1|40=2|", wire);
+    auto& order = *reinterpret_cast<binary::NewOrder*>(wire.data());
+    auto& replace = *reinterpret_cast<binary::Replace*>(wire.data() + sizeof(binary::NewOrder));
+
+    InstrumentRegistry instruments;
+    order.priceScale = Price::kMaxScale;
+    EXPECT_EQ(binary::decode(order, instruments).price, Price(15, Price::kMaxScale));
+    order.priceScale = Price::kMaxScale + 1;
+    EXPECT_THROW(binary::decode(order, instruments), std::invalid_argument);
+    replace.priceScale = 200;
+    EXPECT_THROW(binary::decode(replace, instruments), std::invalid_argument);
+}
+
+TEST(BinaryProtocolTest, DescribesReportsAsTextResponses) {
+    binary::ExecutionReport report{};
+    binary::initHeader(report);
+    binary::setText(report.clOrdId, "ORDER1", "ClOrdID");
+    binary::setText(report.symbol, "AAPL", "Symbol");
+    report.side = fix::side::Buy;
+    report.price = 15050;
+    report.priceScale = 2;
+    report.orderQty = 100;
+    report.execType = report.ordStatus = fix::status::New;
+    EXPECT_EQ(binary::describe(report),
+              "ACK|OrderID=ORDER1|Symbol=AAPL|Side=BUY|Quantity=100|Price=150.50|Status=ACCEPTED|FilledQty=0|");
+
+    report.execType = report.ordStatus = fix::status::Rejected;
+    binary::setTruncatedText(report.text, std::string(100, 'x'));
+    EXPECT_EQ(binary::describe(report), "NAK|OrderID=ORDER1|Error=" + std::string(binary::kTextSize, 'x'));
+}
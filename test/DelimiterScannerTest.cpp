@@ -0,0 +1,64 @@
+// test/DelimiterScannerTest.cpp
+#include <gtest/gtest.h>
+#include "DelimiterScanner.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+    std::vector<std::size_t> collect(std::string_view data, char a, char b, simd::Isa isa) {
+        std::vector<std::size_t> positions;
+        DelimiterScanner scanner(data, a, b, isa);
+        for (std::size_t pos = scanner.next(); pos != DelimiterScanner::npos; pos = scanner.next()) {
+            positions.push_back(pos);
+        }
+        return positions;
+    }
+
+    std::vector<std::size_t> reference(std::string_view data, char a, char b) {
+        std::vector<std::size_t> positions;
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == a || data[i] == b) {
+                positions.push_back(i);
+            }
+        }
+        return positions;
+    }
+}
+
+TEST(DelimiterScannerTest, FindsDelimitersAcrossBlockBoundaries) {
+    std::string data(200, 'x');
+    data[0] = '|';
+    data[63] = '=';
+    data[64] = '|';
+    data[127] = '|';
+    data[199] = '=';
+
+    auto positions = collect(data, '=', '|', simd::activeIsa());
+    EXPECT_EQ(positions, (std::vector<std::size_t>{0, 63, 64, 127, 199}));
+}
+
+TEST(DelimiterScannerTest, EmptyAndDelimiterFreeInput) {
+    EXPECT_TRUE(collect("", '|', '|', simd::activeIsa()).empty());
+    EXPECT_TRUE(collect("no delimiters here", '|', '=', simd::activeIsa()).empty());
+}
+
+TEST(DelimiterScannerTest, AllIsaPathsMatchReference) {
+    std::mt19937 rng(42);
+    const char alphabet[] = "ab=|,0123456789";
+
+    for (std::size_t length : {1, 15, 16, 31, 63, 64, 65, 100, 128, 1000}) {
+        std::string data(length, ' ');
+        for (auto& c : data) {
+            c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+
+        auto expected = reference(data, '=', '|');
+        for (auto isa : {simd::Isa::SCALAR, simd::Isa::SSE2, simd::Isa::AVX2}) {
+            if (!simd::isaSupported(isa)) {
+                continue;
+            }
+            EXPECT_EQ(collect(data, '=', '|', isa), expected)
+                << "isa=" << simd::isaName(isa) << " length=" << length;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// test/FixEncoderTest.cpp
+#include <gtest/gtest.h>
+#include "FixEncoder.hpp"
+#include "FixSchema.hpp"
+#include <climits>
+#include <cstdio>
+#include <string>
+
+namespace {
+    unsigned checksumOf(std::string_view bytes) {
+        unsigned sum = 0;
+        for (char c : bytes) {
+            sum += static_cast<unsigned char>(c);
+        }
+        return sum % 256;
+    }
+}
+
+TEST(FixEncoderTest, BodyLengthAndCheckSum) {
+    char buffer[256];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    encoder.begin("D").field(fix::tag::ClOrdID, "ORDER123").field(fix::tag::Symbol, "AAPL");
+    std::string_view message = encoder.finish();
+
+    const std::string body = "35=D|11=ORDER123|55=AAPL|";
+    const std::string head = "8=FIX.4.2|9=" + std::to_string(body.size()) + "|";
+    ASSERT_EQ(message.substr(0, head.size() + body.size()), head + body);
+
+    char expected[4];
+    std::snprintf(expected, sizeof(expected), "%03u", checksumOf(head + body));
+    EXPECT_EQ(message.substr(head.size() + body.size()), "10=" + std::string(expected) + "|");
+}
+
+TEST(FixEncoderTest, ReusesBufferAcrossMessages) {
+    char buffer[256];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    encoder.begin("D").field(fix::tag::ClOrdID, "A-LONG-ORDER-ID-1234567890");
+    encoder.finish();
+
+    std::string_view second = encoder.begin("F").field(fix::tag::ClOrdID, "B").finish();
+    EXPECT_EQ(second.substr(0, 25), "8=FIX.4.2|9=10|35=F|11=B|");
+}
+
+TEST(FixEncoderTest, FormatIntegerAndDecimal) {
+    char out[64];
+    EXPECT_EQ(std::string(out, FixEncoder::formatInteger(out, 0)), "0");
+    EXPECT_EQ(std::string(out, FixEncoder::formatInteger(out, -42)), "-42");
+    EXPECT_EQ(std::string(out, FixEncoder::formatInteger(out, 1234567890123LL)), "1234567890123");
+    EXPECT_EQ(std::string(out, FixEncoder::formatInteger(out, LLONG_MIN)), "-9223372036854775808");
+
+    EXPECT_EQ(std::string(out, FixEncoder::formatDecimal(out, 15050, 2)), "150.50");
+    EXPECT_EQ(std::string(out, FixEncoder::formatDecimal(out, 5, 2)), "0.05");
+    EXPECT_EQ(std::string(out, FixEncoder::formatDecimal(out, -5, 3)), "-0.005");
+    EXPECT_EQ(std::string(out, FixEncoder::formatDecimal(out, 275000, 0)), "275000");
+}
+
+TEST(FixEncoderTest, RejectsOverflow) {
+    char buffer[40];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    encoder.begin("8");
+    EXPECT_THROW(encoder.field(fix::tag::Text, std::string(64, 'x')), std::length_error);
+}
+
+TEST(FixEncoderTest, ExecutionReportRoundTrip) {
+    fix::ExecutionReport report;
+    report.orderId = "1";
+    report.clOrdId = "ORDER123";
+    report.execId = "E1";
+    report.execType = 'F';
+    report.ordStatus = '2';
+    report.symbol = "AAPL";
+    report.side = '1';
+    report.orderQty = Qty(100);
+    report.lastQty = Qty(100);
+    report.lastPx = Price::parse("150.50");
+    report.leavesQty = Qty(0);
+    report.cumQty = Qty(100);
+
+    char buffer[512];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    std::string_view message = fix::encode(report, encoder);
+
+    // Schema order, optional empty fields skipped, required zero values kept
+    EXPECT_NE(message.find("|35=8|37=1|11=ORDER123|17=E1|150=F|39=2|55=AAPL|54=1|38=100|"),
+              std::string_view::npos);
+    EXPECT_NE(message.find("|151=0|14=100|10="), std::string_view::npos);
+
+    auto decoded = fix::decode<fix::ExecutionReport>(message);
+    EXPECT_EQ(decoded.clOrdId, "ORDER123");
+    EXPECT_EQ(decoded.lastPx.toString(), "150.50");
+    EXPECT_EQ(decoded.cumQty, Qty(100));
+}
@@ -28,3 +28,68 @@ TEST(FixMessageHandlerTest, BuildFixMessage) {
     EXPECT_EQ(fixMessage, "35=D|49=Sender|56=Target|");
 }
 
+
+TEST(FixMessageHandlerTest, ParseFixMessageView) {
+    FixMessageHandler handler;
+
+    std::string fixMessage = "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    auto view = handler.parseFixMessageView(fixMessage);
+
+    ASSERT_EQ(view.size(), 9);
+    EXPECT_EQ(view[0].tag, 35);
+    EXPECT_EQ(view.get(11), "ORDER123");
+    EXPECT_EQ(view.get(55), "AAPL");
+    EXPECT_EQ(view.get(44), "150.50");
+    EXPECT_FALSE(view.has(99));
+    EXPECT_TRUE(view.get(99).empty());
+
+    // Values are views into the original buffer, not copies
+    EXPECT_EQ(view.get(55).data(), fixMessage.data() + fixMessage.find("AAPL"));
+}
+
+TEST(FixMessageHandlerTest, ParseFixMessageViewHighTagsAndDuplicates) {
+    FixMessageHandler handler;
+
+    auto view = handler.parseFixMessageView("35=D|9999=custom|55=AAPL|55=MSFT");
+
+    ASSERT_EQ(view.size(), 4);
+    EXPECT_EQ(view.get(9999), "custom");
+    EXPECT_EQ(view.get(55), "MSFT");
+}
+
+TEST(FixMessageHandlerTest, ParseFixMessageViewRejectsMalformedFields) {
+    FixMessageHandler handler;
+
+    EXPECT_THROW(handler.parseFixMessageView("35=D|49Sender|"), std::invalid_argument);
+    EXPECT_THROW(handler.parseFixMessageView("35=D||"), std::invalid_argument);
+    EXPECT_THROW(handler.parseFixMessageView("3x=D|"), std::invalid_argument);
+    EXPECT_THROW(handler.parseFixMessageView("=D|"), std::invalid_argument);
+}
+
+TEST(FixMessageHandlerTest, ParseFixMessageViewLongMessageWithEqualsInValue) {
+    FixMessageHandler handler;
+
+    std::string fixMessage = "35=D|58=a=b=c|";
+    for (int tag = 5000; tag < 5035; ++tag) {
+        fixMessage += std::to_string(tag) + "=V" + std::to_string(tag) + "|";
+    }
+    auto view = handler.parseFixMessageView(fixMessage);
+
+    ASSERT_EQ(view.size(), 37);
+    EXPECT_EQ(view.get(58), "a=b=c");
+    EXPECT_EQ(view.get(5034), "V5034");
+}
+
+TEST(FixMessageHandlerTest, BuildFixMessageOrdersKeys) {
+    FixMessageHandler handler;
+
+    std::unordered_map<std::string, std::string> fields = {
+        {"55", "AAPL"},
+        {"11", "ORDER123"},
+        {"35", "D"},
+        {"38", "100"}
+    };
+
+    EXPECT_EQ(handler.buildFixMessage(fields), "11=ORDER123|35=D|38=100|55=AAPL|");
+    EXPECT_EQ(handler.buildFixMessage({}), "");
+}
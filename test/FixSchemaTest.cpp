@@ -0,0 +1,64 @@
+// test/FixSchemaTest.cpp
+#include <gtest/gtest.h>
+#include "FixSchema.hpp"
+
+TEST(FixSchemaTest, DecodeNewOrderSingle) {
+    std::string fixMessage = "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    auto order = fix::decode<fix::NewOrderSingle>(fixMessage);
+
+    EXPECT_EQ(order.senderCompId, "SENDER");
+    EXPECT_EQ(order.targetCompId, "TARGET");
+    EXPECT_EQ(order.clOrdId, "ORDER123");
+    EXPECT_EQ(order.symbol, "AAPL");
+    EXPECT_EQ(order.side, '1');
+    EXPECT_EQ(order.ordType, '2');
+    EXPECT_EQ(order.orderQty, Qty(100));
+    EXPECT_EQ(order.price.mantissa, 15050);
+    EXPECT_EQ(order.price.scale, 2);
+    EXPECT_TRUE(order.account.empty());
+}
+
+TEST(FixSchemaTest, DecodeCancelAndReplace) {
+    auto cancel = fix::decode<fix::OrderCancelRequest>("35=F|11=C1|41=ORDER123|55=AAPL|54=1|");
+    EXPECT_EQ(cancel.clOrdId, "C1");
+    EXPECT_EQ(cancel.origClOrdId, "ORDER123");
+
+    auto replace = fix::decode<fix::OrderCancelReplaceRequest>(
+        "35=G|11=R1|41=ORDER123|55=AAPL|54=2|38=250|44=151.00|");
+    EXPECT_EQ(replace.origClOrdId, "ORDER123");
+    EXPECT_EQ(replace.side, '2');
+    EXPECT_EQ(replace.orderQty, Qty(250));
+    EXPECT_EQ(replace.price, Price(151, 0));
+}
+
+TEST(FixSchemaTest, DecodeExecutionReport) {
+    auto report = fix::decode<fix::ExecutionReport>(
+        "35=8|37=1|11=ORDER123|17=E1|150=F|39=2|55=AAPL|54=1|32=100|31=150.50|151=0|14=100|");
+    EXPECT_EQ(report.execType, 'F');
+    EXPECT_EQ(report.ordStatus, '2');
+    EXPECT_EQ(report.lastQty, Qty(100));
+    EXPECT_EQ(report.lastPx, Price::parse("150.5"));
+    EXPECT_EQ(report.leavesQty, Qty(0));
+    EXPECT_EQ(report.cumQty, Qty(100));
+}
+
+TEST(FixSchemaTest, RejectsMissingRequiredTags) {
+    // No Symbol (55)
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("35=D|11=ORDER123|54=1|38=100|"), std::invalid_argument);
+    // No MsgType (35)
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("11=ORDER123|55=AAPL|54=1|38=100|"), std::invalid_argument);
+}
+
+TEST(FixSchemaTest, RejectsWrongMsgTypeAndBadValues) {
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("35=F|11=ORDER123|55=AAPL|54=1|38=100|"), std::invalid_argument);
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("35=D|11=ORDER123|55=AAPL|54=1|38=1x0|"), std::invalid_argument);
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("35=D|11=ORDER123|55=AAPL|54=12|38=100|"), std::invalid_argument);
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>("35=D|11=ORDER123|55=AAPL|54=1|38=100|44=1.2.3|"), std::invalid_argument);
+}
+
+TEST(FixSchemaTest, MessageType) {
+    EXPECT_EQ(fix::messageType("35=D|11=A|"), "D");
+    EXPECT_EQ(fix::messageType("49=S|35=G|11=A|"), "G");
+    EXPECT_EQ(fix::messageType("49=S|35=8"), "8");
+    EXPECT_TRUE(fix::messageType("49=S|11=A|").empty());
+}
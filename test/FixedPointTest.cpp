@@ -0,0 +1,57 @@
+// test/FixedPointTest.cpp
+#include <gtest/gtest.h>
+#include "FixedPoint.hpp"
+
+TEST(FixedPointTest, ParsePriceNaturalScale) {
+    Price price = Price::parse("150.50");
+    EXPECT_EQ(price.mantissa, 15050);
+    EXPECT_EQ(price.scale, 2);
+
+    EXPECT_EQ(Price::parse("2750").mantissa, 2750);
+    EXPECT_EQ(Price::parse("2750").scale, 0);
+    EXPECT_EQ(Price::parse("-0.005").mantissa, -5);
+    EXPECT_EQ(Price::parse(".5").mantissa, 5);
+}
+
+TEST(FixedPointTest, ParsePriceAtInstrumentScale) {
+    EXPECT_EQ(Price::parse("150.5", 4).mantissa, 1505000);
+    EXPECT_EQ(Price::parse("150.5000", 2).mantissa, 15050);
+    // Would drop a non-zero digit
+    EXPECT_THROW(Price::parse("150.505", 2), std::invalid_argument);
+}
+
+TEST(FixedPointTest, RejectsMalformedPrices) {
+    Price price;
+    EXPECT_FALSE(Price::tryParse("", price));
+    EXPECT_FALSE(Price::tryParse("-", price));
+    EXPECT_FALSE(Price::tryParse(".", price));
+    EXPECT_FALSE(Price::tryParse("1.2.3", price));
+    EXPECT_FALSE(Price::tryParse("15O.50", price));
+    EXPECT_FALSE(Price::tryParse("1e5", price));
+    EXPECT_FALSE(Price::tryParse("1234567890123456789", price));
+}
+
+TEST(FixedPointTest, FormatAndCompareAcrossScales) {
+    EXPECT_EQ(Price::parse("150.50").toString(), "150.50");
+    EXPECT_EQ(Price(5, 3).toString(), "0.005");
+    EXPECT_EQ(Price(-15050, 2).toString(), "-150.50");
+
+    EXPECT_EQ(Price::parse("150.5"), Price::parse("150.500"));
+    EXPECT_LT(Price::parse("150.49"), Price::parse("150.5"));
+    EXPECT_GT(Price::parse("151"), Price::parse("150.9999"));
+
+    EXPECT_EQ(Price::parse("150.50").rescale(4).mantissa, 1505000);
+    EXPECT_EQ(Price::parse("150.5000").rescale(1).mantissa, 1505);
+    EXPECT_THROW(Price::parse("150.55").rescale(1), std::invalid_argument);
+}
+
+TEST(FixedPointTest, ParseAndFormatQty) {
+    EXPECT_EQ(Qty::parse("100"), Qty(100));
+    EXPECT_EQ(Qty(275000).toString(), "275000");
+    EXPECT_EQ(Qty(100) - Qty(40), Qty(60));
+
+    Qty qty;
+    EXPECT_FALSE(Qty::tryParse("", qty));
+    EXPECT_FALSE(Qty::tryParse("-5", qty));
+    EXPECT_FALSE(Qty::tryParse("10.5", qty));
+}
@@ -0,0 +1,172 @@
+// test/HandlerAllocatorTest.cpp
+#include <gtest/gtest.h>
+#include "HandlerAllocator.hpp"
+#include "NetworkServer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <thread>
+
+// Every heap allocation in the test binary goes through these; the count
+// only moves while a test has switched counting on
+namespace {
+    std::atomic<bool> countingAllocations{false};
+    std::atomic<size_t> allocationCount{0};
+
+    void* countedAllocate(std::size_t size, std::size_t alignment) {
+        if (countingAllocations.load(std::memory_order_relaxed)) {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        size = size == 0 ? 1 : size;
+        void* memory = alignment <= alignof(std::max_align_t)
+            ? std::malloc(size)
+            : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace {
+    size_t allocationsDuring(const std::function<void()>& work) {
+        allocationCount = 0;
+        countingAllocations = true;
+        work();
+        countingAllocations = false;
+        return allocationCount;
+    }
+}
+
+TEST(HandlerAllocatorTest, ReusesTheBlockOnceItIsFreed) {
+    HandlerMemory memory;
+    HandlerAllocator<char> allocator(memory);
+    char* first = allocator.allocate(HandlerMemory::kSize);
+    allocator.deallocate(first, HandlerMemory::kSize);
+
+    char* second = nullptr;
+    EXPECT_EQ(allocationsDuring([&] { second = allocator.allocate(64); }), 0u);
+    EXPECT_EQ(second, first);
+    allocator.deallocate(second, 64);
+}
+
+TEST(HandlerAllocatorTest, FallsBackToTheHeapWhenTakenOrTooLarge) {
+    // On the heap, as in a connection; GCC cannot tell which branch of
+    // deallocate() a stack block takes and warns about freeing it
+    auto owner = std::make_unique<HandlerMemory>();
+    HandlerMemory& memory = *owner;
+    HandlerAllocator<char> allocator(memory);
+    char* held = allocator.allocate(16);
+
+    char* overlapping = nullptr;
+    char* oversized = nullptr;
+    EXPECT_EQ(allocationsDuring([&] {
+        overlapping = allocator.allocate(16);
+        oversized = HandlerAllocator<char>(memory).allocate(HandlerMemory::kSize + 1);
+    }), 2u);
+    EXPECT_NE(overlapping, held);
+    allocator.deallocate(overlapping, 16);
+    allocator.deallocate(oversized, HandlerMemory::kSize + 1);
+    allocator.deallocate(held, 16);
+
+    // Rebound copies share the memory
+    HandlerAllocator<int> rebound(allocator);
+    EXPECT_TRUE(HandlerAllocator<char>(rebound) == allocator);
+}
+
+TEST(HandlerAllocatorTest, SteadyStateOrderPathDoesNotAllocate) {
+    auto logger = std::make_shared<Logger>();
+    logger->setLevel(Logger::Level::WARNING);
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    network::ServerConfig config;
+    config.port = 0;
+    config.thread_pool_size = 1;
+    config.bounded_ingress_queue = true;
+    // Checked, but never against limits the test could reach
+    RiskLimits limits;
+    limits.maxOpenNotional = Price(1'000'000'000'000, 2);
+    limits.maxOrdersPerSecond = 1'000'000;
+    NetworkServer server(config, std::make_shared<OrderManager>(OrderManager::kDefaultCapacity, 4, instruments),
+                         logger, nullptr, std::make_shared<RiskChecker>(instruments, limits));
+    std::thread serverThread([&] { server.start(); });
+
+    // Several connections, so more operations are outstanding at once than
+    // asio's per-thread cache of freed operations can hold
+    constexpr int kConnections = 4;
+    boost::asio::io_context io;
+    std::vector<boost::asio::ip::tcp::socket> sockets;
+    for (int i = 0; i < kConnections; ++i) {
+        sockets.emplace_back(io);
+        sockets.back().connect({boost::asio::ip::address_v4::loopback(), server.port()});
+        sockets.back().set_option(boost::asio::ip::tcp::no_delay(true));
+    }
+
+    // Every burst is encoded before counting starts
+    constexpr int kBursts = 20;
+    constexpr int kOrdersPerBurst = 100;
+    std::vector<std::string> bursts(kBursts * kConnections);
+    for (size_t burst = 0; burst < bursts.size(); ++burst) {
+        for (int i = 0; i < kOrdersPerBurst; ++i) {
+            bursts[burst] += "35=D|49=SENDER|56=TARGET|11=Z" + std::to_string(burst * kOrdersPerBurst + i) +
+                             "|55=AAPL|54=1|44=150.50|38=100|40=2|\n";
+        }
+    }
+    std::vector<char> replies(64 * 1024);
+    size_t nakCount = 0;
+    // Sends a burst on every connection before reading any of the answers
+    auto exchange = [&](int round) {
+        for (int i = 0; i < kConnections; ++i) {
+            boost::asio::write(sockets[i], boost::asio::buffer(bursts[round * kConnections + i]));
+        }
+        for (auto& socket : sockets) {
+            for (int answered = 0; answered < kOrdersPerBurst;) {
+                size_t bytes = socket.read_some(boost::asio::buffer(replies));
+                for (const char* at = replies.data(); at != replies.data() + bytes; ++at) {
+                    if (*at == '\n') {
+                        ++answered;
+                    } else if (*at == 'N' && (at == replies.data() || at[-1] == '\n')) {
+                        ++nakCount;
+                    }
+                }
+            }
+        }
+    };
+
+    // The first rounds size the connections' buffers and intern the symbol
+    exchange(0);
+    exchange(1);
+    size_t allocations = allocationsDuring([&] {
+        for (int round = 2; round < kBursts; ++round) {
+            exchange(round);
+        }
+        // Lets the worker apply the last of them while still counting
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    for (auto& socket : sockets) {
+        socket.close();
+    }
+    server.stop();
+    serverThread.join();
+
+    EXPECT_EQ(nakCount, 0u);
+    EXPECT_EQ(server.getStatistics().messages_processed, static_cast<size_t>(kBursts * kConnections * kOrdersPerBurst));
+    EXPECT_EQ(allocations, 0u);
+}
@@ -0,0 +1,105 @@
+// test/InstrumentRegistryTest.cpp
+#include <gtest/gtest.h>
+#include "FixSchema.hpp"
+#include "InstrumentRegistry.hpp"
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(InstrumentRegistryTest, InternsDenseIds) {
+    InstrumentRegistry registry;
+    EXPECT_EQ(registry.find("AAPL"), kUnknownInstrument);
+
+    EXPECT_EQ(registry.intern("AAPL"), 0u);
+    EXPECT_EQ(registry.intern("MSFT"), 1u);
+    EXPECT_EQ(registry.intern("AAPL"), 0u);
+    EXPECT_EQ(registry.find("MSFT"), 1u);
+    EXPECT_EQ(registry.symbol(1), "MSFT");
+    EXPECT_EQ(registry.size(), 2u);
+
+    EXPECT_THROW(registry.intern("SYMBOL-LONGER-THAN-16"), std::length_error);
+    EXPECT_EQ(registry.find("SYMBOL-LONGER-THAN-16"), kUnknownInstrument);
+}
+
+TEST(InstrumentRegistryTest, ThrowsWhenFull) {
+    InstrumentRegistry registry(2);
+    registry.intern("A");
+    registry.intern("B");
+    EXPECT_THROW(registry.intern("C"), std::length_error);
+    EXPECT_EQ(registry.intern("A"), 0u);
+}
+
+TEST(InstrumentRegistryTest, LoadsReferenceData) {
+    std::istringstream data(
+        "# symbol,tick,min,max\n"
+        "AAPL,0.01,1.00,1000.00\n"
+        "\n"
+        "BOND1\r\n");
+    InstrumentRegistry registry;
+    EXPECT_EQ(registry.loadReferenceData(data), 2u);
+
+    const Instrument& aapl = registry.instrument(registry.find("AAPL"));
+    EXPECT_TRUE(aapl.hasPriceBand());
+    EXPECT_EQ(aapl.tickSize, Price::parse("0.01"));
+    EXPECT_EQ(aapl.maxPrice, Price::parse("1000.00"));
+    EXPECT_FALSE(registry.instrument(registry.find("BOND1")).hasPriceBand());
+
+    std::istringstream duplicate("AAPL\n");
+    EXPECT_THROW(registry.loadReferenceData(duplicate), std::invalid_argument);
+    std::istringstream malformed("MSFT,0.01\n");
+    EXPECT_THROW(registry.loadReferenceData(malformed), std::invalid_argument);
+    std::istringstream trailing("MSFT,0.01,1,1000,junk\n");
+    EXPECT_THROW(registry.loadReferenceData(trailing), std::invalid_argument);
+    EXPECT_EQ(registry.find("MSFT"), kUnknownInstrument);
+}
+
+TEST(InstrumentRegistryTest, ResolvesOnlyReferenceDataOnceLoaded) {
+    InstrumentRegistry registry;
+    EXPECT_EQ(registry.resolve("ANY"), 0u);
+
+    std::istringstream data("AAPL,0.01,1.00,1000.00\n");
+    registry.loadReferenceData(data);
+    EXPECT_EQ(registry.resolve("AAPL"), registry.find("AAPL"));
+    EXPECT_THROW(registry.resolve("ZZZ"), std::invalid_argument);
+    EXPECT_THROW(fix::decode<fix::NewOrderSingle>(
+                     "35=D|11=ORDER1|55=ZZZ|54=1|44=1.50|38=100|40=2|", registry),
+                 std::invalid_argument);
+    EXPECT_EQ(registry.size(), 2u);
+}
+
+TEST(InstrumentRegistryTest, DecodeResolvesInstrument) {
+    InstrumentRegistry registry;
+    InstrumentId aapl = registry.intern("AAPL");
+    auto order = fix::decode<fix::NewOrderSingle>(
+        "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|", registry);
+    EXPECT_EQ(order.instrument, aapl);
+}
+
+TEST(InstrumentRegistryTest, ConcurrentReadersSeeConsistentIds) {
+    InstrumentRegistry registry(1024);
+    std::atomic<bool> done{false};
+    std::atomic<int> mismatches{0};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            for (int i = 0; i < 1000; ++i) {
+                std::string symbol = "S" + std::to_string(i);
+                InstrumentId id = registry.find(symbol);
+                if (id != kUnknownInstrument && registry.symbol(id) != symbol) {
+                    ++mismatches;
+                }
+            }
+        }
+    });
+
+    for (int i = 0; i < 1000; ++i) {
+        registry.intern("S" + std::to_string(i));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(registry.size(), 1000u);
+}
@@ -16,3 +16,21 @@ TEST(LoggerTest, LogLevels_Test) {
     logger.log(Logger::Level::ERROR, "Error message");
     logger.log(Logger::Level::FATAL, "Fatal message");
 }
+
+TEST(LoggerTest, MessagesBelowTheLevelAreDropped_Test) {
+    Logger logger;
+    EXPECT_TRUE(logger.enabled(Logger::Level::DEBUG));
+
+    logger.setLevel(Logger::Level::WARNING);
+    EXPECT_FALSE(logger.enabled(Logger::Level::DEBUG));
+    EXPECT_FALSE(logger.enabled(Logger::Level::INFO));
+    EXPECT_TRUE(logger.enabled(Logger::Level::WARNING));
+    EXPECT_TRUE(logger.enabled(Logger::Level::FATAL));
+
+    testing::internal::CaptureStdout();
+    logger.log(Logger::Level::INFO, "Dropped message");
+    logger.log(Logger::Level::ERROR, "Kept message");
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(output.find("Dropped message"), std::string::npos);
+    EXPECT_NE(output.find("Kept message"), std::string::npos);
+}
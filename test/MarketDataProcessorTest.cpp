@@ -1,5 +1,6 @@
 #include "MarketDataProcessor.hpp"
 #include <gtest/gtest.h>
+#include <sstream>
 
 TEST(MarketDataProcessorTest, ProcessMarketData) {
     MarketDataProcessor processor;
@@ -20,3 +21,55 @@ TEST(MarketDataProcessorTest, ProcessMarketData) {
     EXPECT_EQ(processedData[5], "3450.10");
 }
 
+
+TEST(MarketDataProcessorTest, ProcessEmptyFieldsAndLongFeeds) {
+    MarketDataProcessor processor;
+
+    auto processedData = processor.process(",AAPL,,150.25,");
+    ASSERT_EQ(processedData.size(), 4);
+    EXPECT_EQ(processedData[0], "");
+    EXPECT_EQ(processedData[1], "AAPL");
+    EXPECT_EQ(processedData[2], "");
+    EXPECT_EQ(processedData[3], "150.25");
+
+    // Longer than one 64-byte scan block
+    std::string rawMarketData;
+    for (int i = 0; i < 40; ++i) {
+        rawMarketData += "SYM" + std::to_string(i) + ",";
+    }
+    processedData = processor.process(rawMarketData);
+    ASSERT_EQ(processedData.size(), 40);
+    EXPECT_EQ(processedData[39], "SYM39");
+}
+
+TEST(MarketDataProcessorTest, ProcessUpdatesByInstrumentId) {
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    InstrumentId aapl = instruments->intern("AAPL");
+    MarketDataProcessor processor(instruments);
+
+    std::vector<MarketDataUpdate> updates;
+    EXPECT_EQ(processor.processUpdates("AAPL,150.25,GOOG,2800.50,AAPL,150.30", updates), 3u);
+    ASSERT_EQ(updates.size(), 3u);
+    EXPECT_EQ(updates[0].instrument, aapl);
+    EXPECT_EQ(updates[1].instrument, instruments->find("GOOG"));
+    EXPECT_EQ(updates[1].price, Price::parse("2800.50"));
+    EXPECT_EQ(processor.lastPrice(aapl), Price::parse("150.30"));
+
+    EXPECT_THROW(processor.processUpdates("AAPL,abc", updates), std::invalid_argument);
+    EXPECT_EQ(updates.size(), 3u);  // Nothing appended for the bad price
+    EXPECT_THROW(processor.processUpdates("AAPL,150.25,MSFT", updates), std::invalid_argument);
+}
+
+TEST(MarketDataProcessorTest, SkipsSymbolsOutsideReferenceData) {
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    std::istringstream data("AAPL,0.01,1.00,1000.00\n");
+    instruments->loadReferenceData(data);
+    MarketDataProcessor processor(instruments);
+
+    std::vector<MarketDataUpdate> updates;
+    EXPECT_EQ(processor.processUpdates("GOOG,2800.50,AAPL,150.25", updates), 1u);
+    ASSERT_EQ(updates.size(), 1u);
+    EXPECT_EQ(updates[0].instrument, instruments->find("AAPL"));
+    EXPECT_EQ(instruments->find("GOOG"), kUnknownInstrument);
+    EXPECT_THROW(processor.processUpdates("GOOG,abc", updates), std::invalid_argument);
+}
@@ -0,0 +1,178 @@
+// test/MatchingEngineTest.cpp
+#include <gtest/gtest.h>
+#include "MatchingEngine.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+    fix::NewOrderSingle limitOrder(std::string_view clOrdId, char side, const char* price, int64_t qty) {
+        fix::NewOrderSingle order;
+        order.clOrdId = clOrdId;
+        order.symbol = "AAPL";
+        order.side = side;
+        order.ordType = fix::ord_type::Limit;
+        order.price = Price::parse(price);
+        order.orderQty = Qty(qty);
+        return order;
+    }
+
+    class MatchingEngineTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            engine.addSymbol("AAPL", BookConfig{Price::parse("100.00"), Price::parse("200.00"), Price::parse("0.01")});
+        }
+
+        MatchingEngine engine{1024};
+        std::vector<Execution> reports;
+    };
+}
+
+TEST_F(MatchingEngineTest, RestsNonCrossingOrders) {
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 100), reports);
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.05", 100), reports);
+
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[0].execType, fix::status::New);
+    EXPECT_EQ(reports[0].leavesQty, Qty(100));
+    EXPECT_EQ(engine.restingOrders(), 2u);
+
+    const OrderBook* book = engine.book("AAPL");
+    EXPECT_EQ(book->priceAt(book->bestBid()), Price::parse("150.00"));
+    EXPECT_EQ(book->priceAt(book->bestAsk()), Price::parse("150.05"));
+    EXPECT_EQ(book->level(book->bestBid()).quantity, Qty(100));
+}
+
+TEST_F(MatchingEngineTest, FillsInPriceThenTimePriority) {
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.02", 50), reports);
+    engine.submit(limitOrder("S2", fix::side::Sell, "150.01", 30), reports);
+    engine.submit(limitOrder("S3", fix::side::Sell, "150.01", 40), reports);
+    reports.clear();
+
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.02", 100), reports);
+
+    // New, then maker/taker pairs: S2 and S3 at 150.01 first, then S1 at 150.02
+    ASSERT_EQ(reports.size(), 7u);
+    EXPECT_EQ(reports[1].clOrdId.view(), "S2");
+    EXPECT_EQ(reports[1].execType, fix::status::Filled);
+    EXPECT_EQ(reports[1].lastPx, Price::parse("150.01"));
+    EXPECT_EQ(reports[3].clOrdId.view(), "S3");
+    EXPECT_EQ(reports[5].clOrdId.view(), "S1");
+    EXPECT_EQ(reports[5].execType, fix::status::PartiallyFilled);
+    EXPECT_EQ(reports[5].lastQty, Qty(30));
+    EXPECT_EQ(reports[5].leavesQty, Qty(20));
+    EXPECT_EQ(reports[6].clOrdId.view(), "B1");
+    EXPECT_EQ(reports[6].ordStatus, fix::status::Filled);
+    EXPECT_EQ(reports[6].cumQty, Qty(100));
+
+    EXPECT_EQ(engine.findOrder("B1"), nullptr);
+    EXPECT_EQ(engine.findOrder("S2"), nullptr);
+    ASSERT_NE(engine.findOrder("S1"), nullptr);
+    EXPECT_EQ(engine.findOrder("S1")->leavesQty(), Qty(20));
+}
+
+TEST_F(MatchingEngineTest, RestsRemainderOfPartiallyFilledLimitOrder) {
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.00", 40), reports);
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.10", 100), reports);
+
+    const OrderBook* book = engine.book("AAPL");
+    EXPECT_EQ(book->bestAsk(), OrderBook::kNoLevel);
+    EXPECT_EQ(book->priceAt(book->bestBid()), Price::parse("150.10"));
+    EXPECT_EQ(engine.findOrder("B1")->state, OrderState::PARTIALLY_FILLED);
+    EXPECT_EQ(engine.findOrder("B1")->leavesQty(), Qty(60));
+}
+
+TEST_F(MatchingEngineTest, MarketOrderCancelsUnfilledRemainder) {
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.00", 40), reports);
+    reports.clear();
+
+    auto market = limitOrder("B1", fix::side::Buy, "0", 100);
+    market.ordType = fix::ord_type::Market;
+    engine.submit(market, reports);
+
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_EQ(reports.back().execType, fix::status::Canceled);
+    EXPECT_EQ(reports.back().cumQty, Qty(40));
+    EXPECT_EQ(reports.back().leavesQty, Qty(0));
+    EXPECT_EQ(engine.restingOrders(), 0u);
+}
+
+TEST_F(MatchingEngineTest, CancelRemovesOrderFromLevel) {
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 10), reports);
+    engine.submit(limitOrder("B2", fix::side::Buy, "150.00", 20), reports);
+    engine.submit(limitOrder("B3", fix::side::Buy, "149.00", 30), reports);
+
+    fix::OrderCancelRequest cancel;
+    cancel.clOrdId = "C1";
+    cancel.origClOrdId = "B2";
+    engine.cancel(cancel, reports);
+
+    EXPECT_EQ(reports.back().execType, fix::status::Canceled);
+    EXPECT_EQ(reports.back().clOrdId.view(), "C1");
+    EXPECT_EQ(reports.back().origClOrdId.view(), "B2");
+    const OrderBook* book = engine.book("AAPL");
+    EXPECT_EQ(book->level(book->bestBid()).quantity, Qty(10));
+    EXPECT_EQ(book->level(book->bestBid()).orders, 1u);
+
+    cancel.origClOrdId = "B1";
+    engine.cancel(cancel, reports);
+    EXPECT_EQ(book->priceAt(book->bestBid()), Price::parse("149.00"));
+    EXPECT_THROW(engine.cancel(cancel, reports), std::runtime_error);
+}
+
+TEST_F(MatchingEngineTest, ReplaceKeepsPriorityOnlyWhenReducingQuantity) {
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.00", 50), reports);
+    engine.submit(limitOrder("S2", fix::side::Sell, "150.00", 50), reports);
+
+    fix::OrderCancelReplaceRequest replace;
+    replace.clOrdId = "S1R";
+    replace.origClOrdId = "S1";
+    replace.side = fix::side::Sell;
+    replace.orderQty = Qty(30);
+    engine.replace(replace, reports);
+    EXPECT_EQ(reports.back().execType, fix::status::Replaced);
+    EXPECT_EQ(reports.back().origClOrdId.view(), "S1");
+    EXPECT_EQ(engine.book("AAPL")->level(engine.book("AAPL")->bestAsk()).quantity, Qty(80));
+
+    // Increasing S2 sends it behind S1R, which then fills first
+    replace.clOrdId = "S2R";
+    replace.origClOrdId = "S2";
+    replace.orderQty = Qty(60);
+    engine.replace(replace, reports);
+    reports.clear();
+
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 30), reports);
+    ASSERT_EQ(reports.size(), 3u);
+    EXPECT_EQ(reports[1].clOrdId.view(), "S1R");
+    EXPECT_EQ(engine.findOrder("S2R")->leavesQty(), Qty(60));
+}
+
+TEST_F(MatchingEngineTest, RejectsInvalidOrders) {
+    EXPECT_THROW(engine.submit(limitOrder("X1", fix::side::Buy, "150.005", 10), reports), std::invalid_argument);
+    EXPECT_THROW(engine.submit(limitOrder("X2", fix::side::Buy, "250.00", 10), reports), std::invalid_argument);
+    EXPECT_THROW(engine.submit(limitOrder("X3", fix::side::Buy, "150.00", 0), reports), std::invalid_argument);
+
+    auto unknown = limitOrder("X4", fix::side::Buy, "150.00", 10);
+    unknown.symbol = "MSFT";
+    EXPECT_THROW(engine.submit(unknown, reports), std::invalid_argument);
+
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 10), reports);
+    EXPECT_THROW(engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 10), reports), std::runtime_error);
+    EXPECT_EQ(engine.restingOrders(), 1u);
+}
+
+TEST_F(MatchingEngineTest, EncodesExecutionReport) {
+    engine.submit(limitOrder("S1", fix::side::Sell, "150.00", 40), reports);
+    engine.submit(limitOrder("B1", fix::side::Buy, "150.00", 40), reports);
+
+    char buffer[512];
+    FixEncoder encoder(buffer, sizeof(buffer));
+    std::string_view message = encodeExecutionReport(reports.back(), engine.instruments(), encoder);
+
+    auto decoded = fix::decode<fix::ExecutionReport>(message);
+    EXPECT_EQ(decoded.clOrdId, "B1");
+    EXPECT_EQ(decoded.symbol, "AAPL");
+    EXPECT_EQ(decoded.execType, fix::status::Filled);
+    EXPECT_EQ(decoded.lastQty, Qty(40));
+    EXPECT_EQ(decoded.lastPx, Price::parse("150.00"));
+    EXPECT_EQ(decoded.cumQty, Qty(40));
+}
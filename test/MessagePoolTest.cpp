@@ -0,0 +1,80 @@
+// test/MessagePoolTest.cpp
+#include <gtest/gtest.h>
+#include "MessagePool.hpp"
+#include "OrderJournal.hpp"
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(MessagePoolTest, LendsEveryMessageOnce) {
+    MessagePool<int> pool(3);
+    EXPECT_EQ(pool.capacity(), 3u);
+    EXPECT_EQ(pool.available(), 3u);
+
+    std::set<uint32_t> handles;
+    for (int i = 0; i < 3; ++i) {
+        auto handle = pool.tryAcquire();
+        ASSERT_TRUE(handle.has_value());
+        EXPECT_LT(*handle, 3u);
+        handles.insert(*handle);
+        pool[*handle] = i;
+    }
+    EXPECT_EQ(handles.size(), 3u);
+    EXPECT_FALSE(pool.tryAcquire().has_value());
+    EXPECT_EQ(pool.available(), 0u);
+
+    uint32_t returned = *handles.begin();
+    int contents = pool[returned];
+    pool.release(returned);
+    EXPECT_EQ(pool.acquire(), returned);
+    EXPECT_EQ(pool[returned], contents);
+}
+
+TEST(MessagePoolTest, AcquireWaitsForARelease) {
+    MessagePool<JournalRecord> pool(1);
+    uint32_t handle = pool.acquire();
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        pool.release(handle);
+    });
+    EXPECT_EQ(pool.acquire(), handle);
+    releaser.join();
+}
+
+TEST(MessagePoolTest, HandsOffAcrossThreads) {
+    // One thread decodes into pooled records, others read them by handle, as
+    // NetworkServer's reader and workers do
+    MessagePool<JournalRecord> pool(16);
+    MpmcQueue<uint32_t> queue(16);
+    constexpr int kConsumers = 3;
+    constexpr uint64_t kMessages = 5000;
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> received{0};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c) {
+        consumers.emplace_back([&] {
+            while (auto handle = queue.pop(std::chrono::milliseconds(100))) {
+                sum.fetch_add(pool[*handle].orderQty, std::memory_order_relaxed);
+                pool.release(*handle);
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (uint64_t i = 1; i <= kMessages; ++i) {
+        uint32_t handle = pool.acquire();
+        pool[handle].orderQty = i;
+        queue.push(handle);
+    }
+    while (received.load() < kMessages) {
+        std::this_thread::yield();
+    }
+    queue.stop();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    EXPECT_EQ(sum.load(), kMessages * (kMessages + 1) / 2);
+    EXPECT_EQ(pool.available(), pool.capacity());
+}
@@ -0,0 +1,144 @@
+// test/MpmcQueueTest.cpp
+#include <gtest/gtest.h>
+#include "MpmcQueue.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(MpmcQueueTest, BoundedAndFifo) {
+    MpmcQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4u);
+
+    // Wrapping around reuses the slots freed on the previous lap
+    for (int lap = 0; lap < 3; ++lap) {
+        EXPECT_EQ(queue.try_pop(), lap);
+        EXPECT_TRUE(queue.try_push(lap + 4));
+    }
+    for (int i = 3; i < 7; ++i) {
+        EXPECT_EQ(queue.try_pop(), i);
+    }
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, PushIntoAFullRingKeepsTheItem) {
+    MpmcQueue<std::string> queue(2);
+    ASSERT_EQ(queue.capacity(), 2u);
+    queue.push(std::string(64, 'a'));
+    queue.push(std::string(64, 'b'));
+
+    std::string rejected(64, 'x');
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, std::string(64, 'x'));
+
+    // Both producers wait on the full ring until slots free up
+    std::thread first([&] { queue.push(std::string(64, 'c')); });
+    std::thread second([&] { queue.push(std::string(64, 'c')); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(queue.try_pop(), std::string(64, 'a'));
+    EXPECT_EQ(queue.pop(std::chrono::seconds(30)), std::string(64, 'b'));
+    first.join();
+    second.join();
+    EXPECT_EQ(queue.try_pop(), std::string(64, 'c'));
+    EXPECT_EQ(queue.try_pop(), std::string(64, 'c'));
+}
+
+TEST(MpmcQueueTest, PopNTakesConsecutiveItems) {
+    MpmcQueue<std::string> queue(8);
+    for (int i = 0; i < 6; ++i) {
+        queue.push("m" + std::to_string(i));
+    }
+    std::vector<std::string> batch;
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 4), 4u);
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 4), 2u);
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 4, std::chrono::milliseconds(1)), 0u);
+    EXPECT_EQ(batch, (std::vector<std::string>{"m0", "m1", "m2", "m3", "m4", "m5"}));
+}
+
+TEST(MpmcQueueTest, StopReleasesWaitingConsumers) {
+    MpmcQueue<int> queue(2);
+    std::vector<int> batch;
+    std::thread consumer([&] {
+        EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 4, std::chrono::seconds(30)), 0u);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.stop();
+    consumer.join();
+    EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST(MpmcQueueTest, StopReleasesProducersWaitingOnAFullQueue) {
+    MpmcQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+    std::thread producer([&] { queue.push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.stop();
+    producer.join();
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(MpmcQueueTest, DestroysItemsLeftInTheQueue) {
+    auto tracked = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue(4);
+        queue.push(tracked);
+        queue.push(tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, EveryItemIsDeliveredExactlyOnce) {
+    constexpr int kProducers = 3;
+    constexpr int kConsumers = 3;
+    constexpr int kPerProducer = 50'000;
+    MpmcQueue<int> queue(128);
+    std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                queue.push(p * kPerProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&, c] {
+            std::vector<int> batch;
+            // Mix single and batched pops across consumers
+            while (received.load() < kProducers * kPerProducer) {
+                batch.clear();
+                if (c == 0) {
+                    if (auto value = queue.try_pop()) {
+                        batch.push_back(*value);
+                    }
+                } else {
+                    queue.pop_n(std::back_inserter(batch), 8);
+                }
+                for (int value : batch) {
+                    seen[value].fetch_add(1);
+                }
+                received.fetch_add(static_cast<int>(batch.size()));
+                if (batch.empty()) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& count : seen) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
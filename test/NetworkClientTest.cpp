@@ -0,0 +1,244 @@
+// test/NetworkClientTest.cpp
+#include <gtest/gtest.h>
+#include "BinaryProtocol.hpp"
+#include "NetworkClient.hpp"
+#include "NetworkServer.hpp"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::string newOrder(const std::string& clOrdId) {
+        return "35=D|49=SENDER|56=TARGET|11=" + clOrdId + "|55=AAPL|54=1|44=150.50|38=100|40=2|";
+    }
+
+    // NAKed by the server without naming the order
+    std::string unsupported(const std::string& clOrdId) {
+        return "35=Z|49=SENDER|56=TARGET|11=" + clOrdId + "|";
+    }
+
+    // In-process server on an ephemeral port
+    class NetworkClientTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            network::ServerConfig config;
+            config.port = 0;
+            config.thread_pool_size = 1;
+            server_ = std::make_unique<NetworkServer>(config, std::make_shared<OrderManager>(), logger_);
+            serverThread_ = std::thread([this] { server_->start(); });
+        }
+
+        void TearDown() override {
+            server_->stop();
+            serverThread_.join();
+        }
+
+        network::ClientConfig clientConfig(size_t window,
+                                           network::Encoding encoding = network::Encoding::TEXT) const {
+            network::ClientConfig config;
+            config.port = server_->port();
+            config.pipeline_window = window;
+            config.encoding = encoding;
+            return config;
+        }
+
+        std::shared_ptr<Logger> logger_ = std::make_shared<Logger>();
+        std::unique_ptr<NetworkServer> server_;
+        std::thread serverThread_;
+    };
+}
+
+TEST_F(NetworkClientTest, PipelinedResponsesFindTheirRequests) {
+    NetworkClient client(clientConfig(8), logger_);
+    ASSERT_TRUE(client.connect());
+
+    constexpr int kOrders = 200;
+    std::mutex mutex;
+    std::vector<std::string> responses(kOrders + 1);
+    std::vector<int> accepted(kOrders + 1, -1);
+    std::thread::id ioThread;
+    for (int i = 0; i <= kOrders; ++i) {
+        // The one past the end is NAKed
+        std::string clOrdId = "P" + std::to_string(i);
+        std::string request = i == kOrders ? unsupported(clOrdId) : newOrder(clOrdId);
+        ASSERT_TRUE(client.sendPipelined(network::Message(network::Message::Type::FIX, request),
+            [&, i](bool ok, const std::string& response) {
+                std::lock_guard<std::mutex> lock(mutex);
+                accepted[i] = ok;
+                responses[i] = response;
+                ioThread = std::this_thread::get_id();
+            }));
+        EXPECT_LE(client.inFlight(), 8u);
+    }
+    client.flush();
+    EXPECT_EQ(client.inFlight(), 0u);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < kOrders; ++i) {
+        EXPECT_EQ(accepted[i], 1) << responses[i];
+        EXPECT_EQ(responses[i].rfind("ACK|OrderID=P" + std::to_string(i) + "|", 0), 0u) << responses[i];
+    }
+    EXPECT_EQ(accepted[kOrders], 0);
+    EXPECT_EQ(responses[kOrders].rfind("NAK|", 0), 0u) << responses[kOrders];
+    EXPECT_NE(ioThread, std::this_thread::get_id());
+}
+
+TEST_F(NetworkClientTest, SendAndSendAsyncShareTheWindow) {
+    NetworkClient client(clientConfig(16), logger_);
+    ASSERT_TRUE(client.connect());
+
+    std::vector<std::future<bool>> results;
+    for (int i = 0; i < 50; ++i) {
+        results.push_back(client.sendAsync(network::Message(network::Message::Type::FIX, newOrder("A" + std::to_string(i)))));
+    }
+    EXPECT_TRUE(client.send(network::Message(network::Message::Type::FIX, newOrder("S1"))));
+    EXPECT_FALSE(client.send(network::Message(network::Message::Type::FIX, unsupported("S2"))));
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get());
+    }
+}
+
+TEST_F(NetworkClientTest, DisconnectFailsNothingAnsweredAndReconnects) {
+    NetworkClient client(clientConfig(4), logger_);
+    ASSERT_TRUE(client.connect());
+    EXPECT_TRUE(client.send(network::Message(network::Message::Type::FIX, newOrder("D1"))));
+    client.disconnect();
+    EXPECT_FALSE(client.isConnected());
+    EXPECT_EQ(client.inFlight(), 0u);
+
+    // The next send reconnects and starts the I/O thread again
+    EXPECT_TRUE(client.send(network::Message(network::Message::Type::FIX, newOrder("D2"))));
+    EXPECT_TRUE(client.isConnected());
+}
+
+TEST_F(NetworkClientTest, BinaryClientGetsTheSameAnswers) {
+    NetworkClient client(clientConfig(8, network::Encoding::BINARY), logger_);
+    ASSERT_TRUE(client.connect());
+
+    constexpr int kOrders = 100;
+    std::mutex mutex;
+    std::vector<std::string> responses(kOrders + 2);
+    for (int i = 0; i < kOrders; ++i) {
+        ASSERT_TRUE(client.sendPipelined(network::Message(network::Message::Type::FIX, newOrder("B" + std::to_string(i))),
+            [&, i](bool ok, const std::string& response) {
+                std::lock_guard<std::mutex> lock(mutex);
+                responses[i] = ok ? response : "failed: " + response;
+            }));
+    }
+    client.flush();
+    for (int i = 0; i < kOrders; ++i) {
+        EXPECT_EQ(responses[i].rfind("ACK|OrderID=B" + std::to_string(i) + "|Symbol=AAPL|Side=BUY|Quantity=100|"
+                                     "Price=150.50|Status=ACCEPTED|", 0), 0u) << responses[i];
+    }
+
+    EXPECT_TRUE(client.send(network::Message(network::Message::Type::FIX,
+        "35=G|49=SENDER|56=TARGET|11=B0R|41=B0|55=AAPL|54=1|44=151|38=50|40=2|")));
+    EXPECT_TRUE(client.send(network::Message(network::Message::Type::FIX, "35=F|11=B1C|41=B1|55=AAPL|54=1|")));
+    // No binary form: refused before it is sent, and the connection stays up
+    EXPECT_FALSE(client.send(network::Message(network::Message::Type::FIX, unsupported("B2"))));
+    EXPECT_TRUE(client.isConnected());
+}
+
+TEST_F(NetworkClientTest, ServerSwitchesToBinaryAtLogon) {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket(io);
+    socket.connect({boost::asio::ip::address_v4::loopback(), server_->port()});
+
+    // The Logon and the first binary messages arrive together
+    std::string request = "35=A|49=SENDER|56=TARGET|5000=BINARY|\n";
+    binary::appendFromFix(newOrder("L1"), request);
+    binary::NewOrder unknown{};
+    binary::initHeader(unknown);
+    unknown.header.templateId = 99;
+    binary::append(request, unknown);
+    boost::asio::write(socket, boost::asio::buffer(request));
+
+    // Exactly the text ACK, which the reports follow
+    const std::string expectedLogon = "ACK|Status=LOGGED_ON|Encoding=BINARY|\n";
+    std::string logon(expectedLogon.size(), '\0');
+    boost::asio::read(socket, boost::asio::buffer(logon));
+    EXPECT_EQ(logon, expectedLogon);
+
+    binary::ExecutionReport reports[2];
+    boost::asio::read(socket, boost::asio::buffer(reports, sizeof reports));
+    EXPECT_EQ(reports[0].header.templateId, binary::ExecutionReport::kTemplateId);
+    EXPECT_EQ(binary::text(reports[0].clOrdId), "L1");
+    EXPECT_EQ(reports[0].ordStatus, fix::status::New);
+    EXPECT_EQ(reports[0].orderQty, 100);
+    EXPECT_EQ(reports[1].ordStatus, fix::status::Rejected);
+    EXPECT_EQ(binary::text(reports[1].text), "Unsupported binary template: 99");
+}
+
+TEST_F(NetworkClientTest, FillsOfRestingOrdersAreNotTakenForAnswers) {
+    // A server of its own, crossing orders
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    auto engine = std::make_shared<MatchingEngine>(1024, instruments);
+    engine->addSymbol("AAPL", BookConfig{Price::parse("1"), Price::parse("1000"), Price::parse("0.01")});
+    network::ServerConfig serverConfig;
+    serverConfig.port = 0;
+    serverConfig.thread_pool_size = 1;
+    NetworkServer matching(serverConfig, std::make_shared<OrderManager>(1024, 4, instruments), logger_, engine);
+    std::thread matchingThread([&] { matching.start(); });
+
+    for (auto encoding : {network::Encoding::TEXT, network::Encoding::BINARY}) {
+        std::string prefix = encoding == network::Encoding::TEXT ? "T" : "B";
+        network::ClientConfig config = clientConfig(8, encoding);
+        config.port = matching.port();
+        NetworkClient seller(config, logger_);
+        std::mutex mutex;
+        std::vector<std::string> reports;
+        seller.setUnsolicitedReportHandler([&](const std::string& report) {
+            std::lock_guard<std::mutex> lock(mutex);
+            reports.push_back(report);
+        });
+        ASSERT_TRUE(seller.connect());
+        std::string resting = prefix + "S0";
+        ASSERT_TRUE(seller.send(network::Message(network::Message::Type::FIX,
+            "35=D|11=" + resting + "|55=AAPL|54=2|44=150.50|38=100|40=2|")));
+
+        // The fill may arrive while any of these is in flight
+        constexpr int kOrders = 20;
+        std::vector<std::string> responses(kOrders);
+        for (int i = 1; i < kOrders; ++i) {
+            std::string clOrdId = prefix + "S" + std::to_string(i);
+            ASSERT_TRUE(seller.sendPipelined(network::Message(network::Message::Type::FIX,
+                "35=D|11=" + clOrdId + "|55=AAPL|54=2|44=160|38=10|40=2|"),
+                [&, i](bool ok, const std::string& response) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    responses[i] = ok ? response : "failed: " + response;
+                }));
+            if (i == kOrders / 2) {
+                network::ClientConfig buyerConfig = clientConfig(0);
+                buyerConfig.port = matching.port();
+                NetworkClient crossing(buyerConfig, logger_);
+                ASSERT_TRUE(crossing.connect());
+                EXPECT_TRUE(crossing.send(network::Message(network::Message::Type::FIX,
+                    "35=D|11=" + prefix + "X|55=AAPL|54=1|44=150.50|38=100|40=2|")));
+            }
+        }
+        seller.flush();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!reports.empty()) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 1; i < kOrders; ++i) {
+            EXPECT_EQ(responses[i].rfind("ACK|OrderID=" + prefix + "S" + std::to_string(i) + "|", 0), 0u)
+                << responses[i];
+        }
+        ASSERT_EQ(reports.size(), 1u);
+        EXPECT_NE(reports[0].find(resting), std::string::npos) << reports[0];
+        EXPECT_NE(reports[0].find(encoding == network::Encoding::TEXT ? "|39=2|" : "Status=FILLED"),
+                  std::string::npos) << reports[0];
+    }
+    matching.stop();
+    matchingThread.join();
+}
@@ -0,0 +1,356 @@
+// test/NetworkServerTest.cpp
+#include <gtest/gtest.h>
+#include "BinaryProtocol.hpp"
+#include "NetworkServer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using boost::asio::ip::tcp;
+
+    std::string newOrder(const std::string& clOrdId, const std::string& price, int quantity) {
+        return "35=D|1=ACC|11=" + clOrdId + "|55=AAPL|54=1|44=" + price + "|38=" + std::to_string(quantity) +
+               "|40=2|";
+    }
+
+    std::string cancel(const std::string& clOrdId, const std::string& origClOrdId) {
+        return "35=F|1=ACC|11=" + clOrdId + "|41=" + origClOrdId + "|55=AAPL|54=1|";
+    }
+
+    std::string replace(const std::string& clOrdId, const std::string& origClOrdId, const std::string& price,
+                        int quantity) {
+        return "35=G|1=ACC|11=" + clOrdId + "|41=" + origClOrdId + "|55=AAPL|54=1|44=" + price + "|38=" +
+               std::to_string(quantity) + "|40=2|";
+    }
+
+    // BodyLength (9) and CheckSum (10) agree with the message's bytes
+    void expectWellFramed(const std::string& message) {
+        std::size_t bodyStart = message.find('|', message.find("|9=") + 1) + 1;
+        std::size_t trailer = message.rfind("10=");
+        ASSERT_NE(trailer, std::string::npos) << message;
+        EXPECT_EQ(std::stoul(message.substr(message.find("|9=") + 3)), trailer - bodyStart) << message;
+        unsigned sum = 0;
+        for (std::size_t i = 0; i < trailer; ++i) {
+            sum += static_cast<unsigned char>(message[i]);
+        }
+        EXPECT_EQ(std::stoul(message.substr(trailer + 3)), sum % 256) << message;
+    }
+
+    // Polls until the worker side has caught up, or gives up after a few seconds
+    bool eventually(const std::function<bool()>& condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    // In-process server on an ephemeral port with a risk checker, talked to
+    // over a raw socket
+    class NetworkServerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            logger_->setLevel(Logger::Level::WARNING);
+        }
+
+        void start(network::ServerConfig config = network::ServerConfig()) {
+            config.port = 0;
+            config.thread_pool_size = 1;
+            if (config.single_writer_sequencer || config.order_pipeline) {
+                orders_ = std::make_shared<OrderManager>(OrderManager::kDefaultCapacity, 4, instruments_,
+                                                         OrderManager::Concurrency::SINGLE_WRITER);
+            }
+            server_ = std::make_unique<NetworkServer>(config, orders_, logger_, engine_, risk_, journal_);
+            serverThread_ = std::thread([this] { server_->start(); });
+            socket_.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), server_->port()));
+        }
+
+        void TearDown() override {
+            if (server_) {
+                socket_.close();
+                server_->stop();
+                serverThread_.join();
+            }
+            if (journal_) {
+                server_.reset();
+                journal_.reset();
+                std::remove(journalPath_.c_str());
+            }
+        }
+
+        // Sends the requests in one write and returns their responses
+        std::vector<std::string> exchange(const std::vector<std::string>& requests) {
+            std::string batch;
+            for (const auto& request : requests) {
+                batch += request + "\n";
+            }
+            boost::asio::write(socket_, boost::asio::buffer(batch));
+            std::vector<std::string> responses;
+            for (size_t i = 0; i < requests.size(); ++i) {
+                std::size_t length = boost::asio::read_until(socket_, received_, '\n');
+                responses.emplace_back(boost::asio::buffers_begin(received_.data()),
+                                       boost::asio::buffers_begin(received_.data()) + length - 1);
+                received_.consume(length);
+            }
+            return responses;
+        }
+
+        int64_t openNotional() { return risk_->openNotional(risk_->account("ACC")); }
+        size_t errors() { return server_->getStatistics().errors_encountered; }
+
+        std::shared_ptr<InstrumentRegistry> instruments_ = std::make_shared<InstrumentRegistry>();
+        std::shared_ptr<OrderManager> orders_ =
+            std::make_shared<OrderManager>(OrderManager::kDefaultCapacity, 4, instruments_);
+        std::shared_ptr<RiskChecker> risk_ = std::make_shared<RiskChecker>(instruments_);
+        std::shared_ptr<Logger> logger_ = std::make_shared<Logger>();
+        std::shared_ptr<MatchingEngine> engine_;
+        std::shared_ptr<OrderJournal> journal_;
+        std::string journalPath_;
+        std::unique_ptr<NetworkServer> server_;
+        std::thread serverThread_;
+        boost::asio::io_context io_;
+        tcp::socket socket_{io_};
+        boost::asio::streambuf received_;
+    };
+}
+
+TEST_F(NetworkServerTest, RepeatedCancelReleasesExposureOnce) {
+    start();
+    ASSERT_EQ(exchange({newOrder("A1", "10", 100)})[0].rfind("ACK|", 0), 0u);
+    ASSERT_TRUE(eventually([&] { return orders_->size() == 1; }));
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("10"), Qty(100)));
+
+    // Both are ACKed before either is applied; only the one that removes the order releases it
+    exchange({cancel("C1", "A1"), cancel("C2", "A1")});
+    ASSERT_TRUE(eventually([&] { return errors() == 1; }));
+    EXPECT_EQ(orders_->size(), 0u);
+    EXPECT_EQ(openNotional(), 0);
+}
+
+TEST_F(NetworkServerTest, RejectedNewOrderReleasesItsReservation) {
+    start();
+    auto responses = exchange({newOrder("A1", "10", 100), newOrder("A1", "10", 100)});
+    EXPECT_EQ(responses[1].rfind("ACK|", 0), 0u);
+
+    // The duplicate fails on the worker
+    ASSERT_TRUE(eventually([&] { return errors() == 1; }));
+    EXPECT_EQ(orders_->size(), 1u);
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("10"), Qty(100)));
+}
+
+TEST_F(NetworkServerTest, ReplaceSettlesExposureAgainstTheOrderItChanged) {
+    start();
+    exchange({newOrder("A1", "10", 100)});
+    ASSERT_TRUE(eventually([&] { return orders_->size() == 1; }));
+    exchange({replace("R1", "A1", "10", 50)});
+    ASSERT_TRUE(eventually([&] { return orders_->getOrder("R1").has_value(); }));
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("10"), Qty(50)));
+
+    // Whether or not the io thread saw B1 before checking its replace, the
+    // worker leaves exactly the replaced order's notional open
+    exchange({newOrder("B1", "20", 10), replace("R2", "B1", "20", 30)});
+    ASSERT_TRUE(eventually([&] { return orders_->getOrder("R2").has_value(); }));
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("10"), Qty(50)) +
+                              RiskChecker::notional(Price::parse("20"), Qty(30)));
+
+    // A replace the worker rejects gives back what its check reserved
+    exchange({replace("R3", "R1", "10", 80), replace("R4", "R1", "10", 90)});
+    ASSERT_TRUE(eventually([&] { return errors() == 1; }));
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("10"), Qty(80)) +
+                              RiskChecker::notional(Price::parse("20"), Qty(30)));
+}
+
+TEST_F(NetworkServerTest, SequencerNaksAReplaceItRejects) {
+    network::ServerConfig config;
+    config.single_writer_sequencer = true;
+    risk_->setAccountLimits(risk_->account("ACC"), Price::parse("10000"), 1000);
+    start(config);
+    exchange({newOrder("A1", "50", 100)});
+
+    // Checked on the sequencer against the order it owns
+    auto responses = exchange({replace("R1", "A1", "50", 300), replace("R2", "MISSING", "50", 10),
+                               replace("R3", "A1", "50", 150)});
+    EXPECT_EQ(responses[0], "NAK|Error=Risk check failed: OPEN_EXPOSURE");
+    EXPECT_EQ(responses[1].rfind("NAK|", 0), 0u) << responses[1];
+    EXPECT_EQ(responses[2].rfind("ACK|OrderID=R3|", 0), 0u) << responses[2];
+    EXPECT_EQ(openNotional(), RiskChecker::notional(Price::parse("50"), Qty(150)));
+}
+
+TEST_F(NetworkServerTest, JournalsOnlyWhatTheEngineAccepts) {
+    engine_ = std::make_shared<MatchingEngine>(1024, instruments_);
+    engine_->addSymbol("AAPL", BookConfig{Price::parse("1"), Price::parse("100"), Price::parse("0.01")});
+    JournalConfig journalConfig;
+    journalConfig.path = journalPath_ = ::testing::TempDir() + "network_server_test_journal.bin";
+    std::remove(journalConfig.path.c_str());
+    journalConfig.capacity = 64;
+    journal_ = std::make_shared<OrderJournal>(journalConfig);
+    start();
+
+    // Off the book's price band, then a replace and a cancel of an order the book never had
+    auto responses = exchange({newOrder("A1", "500", 10), replace("R1", "A1", "10", 10), cancel("C1", "A1")});
+    for (const auto& response : responses) {
+        EXPECT_EQ(response.rfind("NAK|", 0), 0u) << response;
+    }
+    EXPECT_EQ(journal_->lastSequence(), 0u);
+    EXPECT_EQ(openNotional(), 0);
+
+    ASSERT_EQ(exchange({newOrder("A2", "10", 10)})[0].rfind("ACK|", 0), 0u);
+    ASSERT_EQ(journal_->lastSequence(), 1u);
+    EXPECT_EQ(journal_->record(1).clOrdId.view(), "A2");
+    EXPECT_EQ(journal_->record(1).account.view(), "ACC");
+}
+
+TEST_F(NetworkServerTest, WorkerPoolRefusesAJournal) {
+    JournalConfig journalConfig;
+    journalConfig.path = journalPath_ = ::testing::TempDir() + "network_server_test_journal.bin";
+    std::remove(journalConfig.path.c_str());
+    journalConfig.capacity = 64;
+    journal_ = std::make_shared<OrderJournal>(journalConfig);
+
+    network::ServerConfig config;
+    config.port = 0;
+    EXPECT_THROW(NetworkServer(config, orders_, logger_, nullptr, risk_, journal_), std::invalid_argument);
+
+    config.single_writer_sequencer = true;
+    auto orders = std::make_shared<OrderManager>(OrderManager::kDefaultCapacity, 4, instruments_,
+                                                 OrderManager::Concurrency::SINGLE_WRITER);
+    EXPECT_NO_THROW(NetworkServer(config, orders, logger_, nullptr, risk_, journal_));
+}
+
+TEST_F(NetworkServerTest, PipelineRefusesTheMatchingEngine) {
+    network::ServerConfig config;
+    config.port = 0;
+    config.order_pipeline = true;
+    auto orders = std::make_shared<OrderManager>(OrderManager::kDefaultCapacity, 4, instruments_,
+                                                 OrderManager::Concurrency::SINGLE_WRITER);
+    auto engine = std::make_shared<MatchingEngine>(1024, instruments_);
+    EXPECT_THROW(NetworkServer(config, orders, logger_, engine, risk_), std::invalid_argument);
+    EXPECT_NO_THROW(NetworkServer(config, orders, logger_, nullptr, risk_));
+}
+
+TEST_F(NetworkServerTest, PipelineAnswersInRequestOrder) {
+    network::ServerConfig config;
+    config.order_pipeline = true;
+    config.pipeline_order_state_wait = WaitStrategy::SPIN_YIELD;
+    start(config);
+
+    auto responses = exchange({newOrder("A1", "10", 10), newOrder("A2", "10", 10), cancel("C1", "A1"),
+                               replace("R2", "A2", "11", 20), cancel("C9", "MISSING")});
+    EXPECT_EQ(responses[0].rfind("ACK|OrderID=A1|", 0), 0u) << responses[0];
+    EXPECT_EQ(responses[1].rfind("ACK|OrderID=A2|", 0), 0u) << responses[1];
+    EXPECT_EQ(responses[2].rfind("ACK|OrderID=C1|", 0), 0u) << responses[2];
+    EXPECT_EQ(responses[3].rfind("ACK|OrderID=R2|", 0), 0u) << responses[3];
+    EXPECT_EQ(responses[4].rfind("NAK|", 0), 0u) << responses[4];
+    EXPECT_TRUE(eventually([&] { return server_->getStatistics().messages_processed == 4; }));
+}
+
+TEST_F(NetworkServerTest, PipelineSwitchesToBinaryAtLogon) {
+    network::ServerConfig config;
+    config.order_pipeline = true;
+    start(config);
+
+    // A text order, the Logon and binary messages all arrive together
+    std::string request = newOrder("T1", "10", 10) + "\n35=A|49=SENDER|56=TARGET|5000=BINARY|\n";
+    binary::appendFromFix(newOrder("B1", "10", 20), request);
+    binary::appendFromFix(cancel("B2", "T1"), request);
+    binary::NewOrder unknown{};
+    binary::initHeader(unknown);
+    unknown.header.templateId = 99;
+    binary::append(request, unknown);
+    boost::asio::write(socket_, boost::asio::buffer(request));
+
+    // The Logon's ACK waits its turn behind the order's
+    std::vector<std::string> lines;
+    for (int i = 0; i < 2; ++i) {
+        std::size_t length = boost::asio::read_until(socket_, received_, '\n');
+        lines.emplace_back(boost::asio::buffers_begin(received_.data()),
+                           boost::asio::buffers_begin(received_.data()) + length - 1);
+        received_.consume(length);
+    }
+    EXPECT_EQ(lines[0].rfind("ACK|OrderID=T1|", 0), 0u) << lines[0];
+    EXPECT_EQ(lines[1], "ACK|Status=LOGGED_ON|Encoding=BINARY|");
+
+    binary::ExecutionReport reports[3];
+    if (received_.size() < sizeof reports) {
+        boost::asio::read(socket_, received_, boost::asio::transfer_exactly(sizeof reports - received_.size()));
+    }
+    ASSERT_EQ(received_.size(), sizeof reports);
+    boost::asio::buffer_copy(boost::asio::buffer(reports, sizeof reports), received_.data());
+    EXPECT_EQ(reports[0].header.templateId, binary::ExecutionReport::kTemplateId);
+    EXPECT_EQ(binary::text(reports[0].clOrdId), "B1");
+    EXPECT_EQ(reports[0].ordStatus, fix::status::New);
+    EXPECT_EQ(reports[0].orderQty, 20);
+    EXPECT_EQ(binary::text(reports[1].clOrdId), "B2");
+    EXPECT_EQ(binary::text(reports[1].origClOrdId), "T1");
+    EXPECT_EQ(reports[1].ordStatus, fix::status::Canceled);
+    EXPECT_EQ(reports[2].ordStatus, fix::status::Rejected);
+    EXPECT_EQ(binary::text(reports[2].text), "Unsupported binary template: 99");
+
+    EXPECT_TRUE(eventually([&] { return server_->getStatistics().messages_processed == 3; }));
+    EXPECT_TRUE(orders_->getOrder("B1").has_value());
+    EXPECT_FALSE(orders_->getOrder("T1").has_value());
+}
+
+TEST_F(NetworkServerTest, MarketDataRecordsLastPrices) {
+    std::istringstream referenceData("AAPL,0.01,1.00,1000.00\n");
+    instruments_->loadReferenceData(referenceData);
+    start();
+
+    server_->processMarketData("AAPL,150.25,IBM,99,AAPL,150.50");
+    EXPECT_EQ(server_->lastPrice(instruments_->find("AAPL")), Price::parse("150.50"));
+    // Neither the feed nor a client adds symbols the reference data lacks
+    EXPECT_EQ(instruments_->find("IBM"), kUnknownInstrument);
+    auto responses = exchange({"35=D|1=ACC|11=A1|55=IBM|54=1|44=10|38=1|40=2|"});
+    EXPECT_EQ(responses[0].rfind("NAK|Error=Unknown symbol: IBM", 0), 0u) << responses[0];
+    EXPECT_EQ(instruments_->size(), 1u);
+}
+
+TEST_F(NetworkServerTest, MarketDataBandsOrdersWithoutTheEngine) {
+    start();
+    // No trade seen yet, so nothing to band around
+    ASSERT_EQ(exchange({newOrder("A1", "200", 1)})[0].rfind("ACK|", 0), 0u);
+
+    server_->processMarketData("AAPL,100");
+    auto responses = exchange({newOrder("A2", "200", 1), newOrder("A3", "101", 1)});
+    EXPECT_EQ(responses[0], "NAK|Error=Risk check failed: PRICE_BAND");
+    EXPECT_EQ(responses[1].rfind("ACK|OrderID=A3|", 0), 0u) << responses[1];
+}
+
+TEST_F(NetworkServerTest, EngineFillsReachTheRestingOrdersConnection) {
+    engine_ = std::make_shared<MatchingEngine>(1024, instruments_);
+    engine_->addSymbol("AAPL", BookConfig{Price::parse("1"), Price::parse("100"), Price::parse("0.01")});
+    start();
+    ASSERT_EQ(exchange({"35=D|1=ACC|11=S1|55=AAPL|54=2|44=10|38=100|40=2|"})[0].rfind("ACK|", 0), 0u);
+
+    // The buyer's ACK covers its own order; the seller hears of the fill separately
+    tcp::socket buyer(io_);
+    buyer.connect(tcp::endpoint(boost::asio::ip::address_v4::loopback(), server_->port()));
+    boost::asio::write(buyer, boost::asio::buffer(newOrder("B1", "10", 40) + "\n"));
+    boost::asio::streambuf buyerReceived;
+    std::size_t length = boost::asio::read_until(buyer, buyerReceived, '\n');
+    std::string ack(boost::asio::buffers_begin(buyerReceived.data()),
+                    boost::asio::buffers_begin(buyerReceived.data()) + length);
+    EXPECT_NE(ack.find("Status=FILLED|FilledQty=40|"), std::string::npos) << ack;
+
+    length = boost::asio::read_until(socket_, received_, '\n');
+    std::string report(boost::asio::buffers_begin(received_.data()),
+                       boost::asio::buffers_begin(received_.data()) + length - 1);
+    auto fill = fix::decode<fix::ExecutionReport>(report);
+    expectWellFramed(report);
+    EXPECT_EQ(fill.clOrdId, "S1");
+    EXPECT_EQ(fill.ordStatus, fix::status::PartiallyFilled);
+    EXPECT_EQ(fill.lastQty, Qty(40));
+    EXPECT_EQ(fill.leavesQty, Qty(60));
+
+    // The engine's book is the order state
+    EXPECT_EQ(engine_->restingOrders(), 1u);
+    EXPECT_EQ(orders_->size(), 0u);
+}
@@ -0,0 +1,33 @@
+// test/ObjectPoolTest.cpp
+#include <gtest/gtest.h>
+#include "ObjectPool.hpp"
+#include "Order.hpp"
+
+TEST(ObjectPoolTest, AllocateReleaseReuse) {
+    ObjectPool<Order, 64> pool(64);
+    EXPECT_EQ(pool.capacity(), 64u);
+
+    uint32_t first = pool.allocate();
+    pool[first].orderQty = Qty(10);
+    EXPECT_EQ(pool.size(), 1u);
+
+    pool.release(first);
+    uint32_t second = pool.allocate();
+    EXPECT_EQ(second, first);
+    // Recycled slots come back value-initialised
+    EXPECT_EQ(pool[second].orderQty, Qty(0));
+}
+
+TEST(ObjectPoolTest, GrowsBySlabWithStableAddresses) {
+    ObjectPool<Order, 64> pool(64);
+    uint32_t first = pool.allocate();
+    Order* address = &pool[first];
+
+    for (int i = 0; i < 100; ++i) {
+        pool.allocate();
+    }
+
+    EXPECT_EQ(pool.capacity(), 128u);
+    EXPECT_EQ(&pool[first], address);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(address) % 64, 0u);
+}
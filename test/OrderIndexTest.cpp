@@ -0,0 +1,90 @@
+// test/OrderIndexTest.cpp
+#include <gtest/gtest.h>
+#include "OrderIndex.hpp"
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace {
+    ClOrdId key(const std::string& text) { return ClOrdId(text); }
+}
+
+TEST(OrderIndexTest, InsertFindErase) {
+    OrderIndex index;
+    EXPECT_TRUE(index.insert(key("ORDER1"), 7));
+    EXPECT_FALSE(index.insert(key("ORDER1"), 8));
+    EXPECT_EQ(index.find(key("ORDER1")), 7u);
+    EXPECT_EQ(index.find(key("ORDER2")), OrderIndex::kNotFound);
+    EXPECT_EQ(index.size(), 1u);
+
+    EXPECT_TRUE(index.erase(key("ORDER1")));
+    EXPECT_FALSE(index.erase(key("ORDER1")));
+    EXPECT_EQ(index.find(key("ORDER1")), OrderIndex::kNotFound);
+    EXPECT_EQ(index.size(), 0u);
+}
+
+TEST(OrderIndexTest, BackwardShiftKeepsCollidingKeysReachable) {
+    OrderIndex index(8);
+    // Force every key into the same home bucket with a shared hash
+    constexpr uint64_t kHash = 3;
+    for (uint32_t i = 0; i < 6; ++i) {
+        ASSERT_TRUE(index.insert(key("C" + std::to_string(i)), kHash, i));
+    }
+
+    EXPECT_TRUE(index.erase(key("C1"), kHash));
+    EXPECT_TRUE(index.erase(key("C4"), kHash));
+    for (uint32_t i = 0; i < 6; ++i) {
+        uint32_t expected = (i == 1 || i == 4) ? OrderIndex::kNotFound : i;
+        EXPECT_EQ(index.find(key("C" + std::to_string(i)), kHash), expected) << i;
+    }
+}
+
+TEST(OrderIndexTest, GrowsIncrementallyWithoutLosingEntries) {
+    OrderIndex index(16);
+    std::size_t initialCapacity = index.capacity();
+    bool sawMigration = false;
+
+    for (uint32_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(index.insert(key("G" + std::to_string(i)), i));
+        sawMigration |= index.migrating();
+        // Every entry stays visible while it is split across old and new tables
+        if (index.migrating()) {
+            for (uint32_t j = 0; j <= i; j += 97) {
+                ASSERT_EQ(index.find(key("G" + std::to_string(j))), j);
+            }
+        }
+    }
+
+    EXPECT_TRUE(sawMigration);
+    EXPECT_GT(index.capacity(), initialCapacity);
+    EXPECT_EQ(index.size(), 5000u);
+    for (uint32_t i = 0; i < 5000; ++i) {
+        EXPECT_EQ(index.find(key("G" + std::to_string(i))), i);
+    }
+}
+
+TEST(OrderIndexTest, MatchesUnorderedMapUnderRandomOperations) {
+    OrderIndex index(4);
+    std::unordered_map<std::string, uint32_t> reference;
+    std::mt19937 rng(42);
+
+    for (uint32_t op = 0; op < 200000; ++op) {
+        std::string id = "R" + std::to_string(rng() % 4000);
+        switch (rng() % 3) {
+        case 0: {
+            bool inserted = reference.emplace(id, op).second;
+            ASSERT_EQ(index.insert(key(id), op), inserted);
+            break;
+        }
+        case 1:
+            ASSERT_EQ(index.erase(key(id)), reference.erase(id) == 1);
+            break;
+        default: {
+            auto it = reference.find(id);
+            ASSERT_EQ(index.find(key(id)), it == reference.end() ? OrderIndex::kNotFound : it->second);
+            break;
+        }
+        }
+        ASSERT_EQ(index.size(), reference.size());
+    }
+}
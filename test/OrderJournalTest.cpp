@@ -0,0 +1,207 @@
+// test/OrderJournalTest.cpp
+#include <gtest/gtest.h>
+#include "OrderJournal.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+    class OrderJournalTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            config.path = ::testing::TempDir() + "order_journal_test_" +
+                          ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+            removeSegments();
+            config.capacity = 256;
+            config.groupCommitEvents = 8;
+            config.groupCommitInterval = std::chrono::microseconds(100);
+        }
+
+        void TearDown() override {
+            removeSegments();
+        }
+
+        void removeSegments() {
+            std::remove(config.path.c_str());
+            for (int i = 1; i < 8; ++i) {
+                std::remove((config.path + "." + std::to_string(i)).c_str());
+            }
+        }
+
+        bool exists(const std::string& path) {
+            return std::ifstream(path).good();
+        }
+
+        static fix::NewOrderSingle order(const char* clOrdId) {
+            fix::NewOrderSingle o;
+            o.clOrdId = clOrdId;
+            o.account = "ACC1";
+            o.symbol = "AAPL";
+            o.side = fix::side::Buy;
+            o.ordType = fix::ord_type::Limit;
+            o.price = Price::parse("150.25");
+            o.orderQty = Qty(100);
+            return o;
+        }
+
+        JournalConfig config;
+    };
+}
+
+TEST_F(OrderJournalTest, AppendsAndReplaysEvents) {
+    OrderJournal journal(config);
+    EXPECT_EQ(journal.append(JournalRecord::newOrder(order("A1"))), 1u);
+
+    fix::OrderCancelRequest cancel;
+    cancel.clOrdId = "C1";
+    cancel.origClOrdId = "A1";
+    cancel.symbol = "AAPL";
+    EXPECT_EQ(journal.append(JournalRecord::cancel(cancel)), 2u);
+
+    std::vector<JournalRecord> records;
+    journal.replay([&](const JournalRecord& record) { records.push_back(record); });
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].type, JournalEventType::NEW_ORDER);
+    EXPECT_EQ(records[0].clOrdId.view(), "A1");
+    EXPECT_EQ(records[0].symbol.view(), "AAPL");
+    EXPECT_EQ(records[0].account.view(), "ACC1");
+    EXPECT_EQ(records[0].price(), Price::parse("150.25"));
+    EXPECT_EQ(records[0].orderQty, 100);
+    EXPECT_GT(records[0].timestampNs, 0);
+    EXPECT_EQ(records[1].type, JournalEventType::CANCEL);
+    EXPECT_EQ(records[1].origClOrdId.view(), "A1");
+}
+
+TEST_F(OrderJournalTest, GroupCommitMakesEventsDurable) {
+    OrderJournal journal(config);
+    uint64_t last = 0;
+    for (int i = 0; i < 20; ++i) {
+        last = journal.append(JournalRecord::newOrder(order("A1")));
+    }
+    journal.waitDurable(last);
+    EXPECT_GE(journal.durableSequence(), last);
+
+    // A lone event is flushed by the interval rather than the group size
+    last = journal.append(JournalRecord::newOrder(order("A2")));
+    journal.waitDurable(last);
+    EXPECT_EQ(journal.durableSequence(), last);
+
+    EXPECT_THROW(journal.waitDurable(last + 1), std::invalid_argument);
+}
+
+TEST_F(OrderJournalTest, ResumesAfterReopen) {
+    {
+        OrderJournal journal(config);
+        journal.append(JournalRecord::newOrder(order("A1")));
+        journal.append(JournalRecord::newOrder(order("A2")));
+    }
+
+    OrderJournal reopened(config);
+    EXPECT_EQ(reopened.lastSequence(), 2u);
+    EXPECT_EQ(reopened.durableSequence(), 2u);
+    EXPECT_EQ(reopened.append(JournalRecord::newOrder(order("A3"))), 3u);
+
+    std::vector<std::string> ids;
+    reopened.replay([&](const JournalRecord& record) { ids.push_back(record.clOrdId.str()); });
+    EXPECT_EQ(ids, (std::vector<std::string>{"A1", "A2", "A3"}));
+}
+
+TEST_F(OrderJournalTest, StopsAtTornRecord) {
+    {
+        OrderJournal journal(config);
+        for (const char* id : {"A1", "A2", "A3"}) {
+            journal.append(JournalRecord::newOrder(order(id)));
+        }
+    }
+
+    // Corrupt the second record's quantity, as a torn write would
+    {
+        std::fstream file(config.path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(4096 + sizeof(JournalRecord) + offsetof(JournalRecord, orderQty));
+        file.put('\x7f');
+    }
+
+    OrderJournal reopened(config);
+    EXPECT_EQ(reopened.lastSequence(), 1u);
+    // The records after the tear were cleared, so new appends cannot be
+    // confused with them
+    EXPECT_EQ(reopened.append(JournalRecord::newOrder(order("B2"))), 2u);
+    uint64_t count = 0;
+    reopened.replay([&](const JournalRecord&) { ++count; });
+    EXPECT_EQ(count, 2u);
+}
+
+TEST_F(OrderJournalTest, ThrowsWhenFull) {
+    config.capacity = 4;
+    OrderJournal journal(config);
+    for (int i = 0; i < 4; ++i) {
+        journal.append(JournalRecord::newOrder(order("A1")));
+    }
+    EXPECT_THROW(journal.append(JournalRecord::newOrder(order("A1"))), std::length_error);
+}
+
+TEST_F(OrderJournalTest, ContinuesIntoNewSegments) {
+    config.capacity = 4;
+    {
+        OrderJournal journal(config);
+        for (const char* id : {"A1", "A2", "A3"}) {
+            journal.append(JournalRecord::newOrder(order(id)));
+        }
+        EXPECT_EQ(journal.endSequence(), 4u);
+
+        // The next append moves to the new segment, which has room of its own
+        journal.startSegment();
+        EXPECT_GE(journal.endSequence(), 7u);
+        for (const char* id : {"B1", "B2", "B3", "B4"}) {
+            journal.append(JournalRecord::newOrder(order(id)));
+        }
+        EXPECT_TRUE(exists(config.path + ".1"));
+        EXPECT_EQ(journal.record(4).clOrdId.view(), "B1");
+        EXPECT_THROW(journal.append(JournalRecord::newOrder(order("B5"))), std::length_error);
+
+        std::vector<std::string> ids;
+        journal.replay([&](const JournalRecord& record) { ids.push_back(record.clOrdId.str()); }, 2, 5);
+        EXPECT_EQ(ids, (std::vector<std::string>{"A2", "A3", "B1", "B2"}));
+
+        // The first segment ends at 3, so only a caller past it may drop it
+        EXPECT_EQ(journal.discardBefore(3), 0u);
+        EXPECT_EQ(journal.discardBefore(4), 1u);
+        EXPECT_EQ(journal.firstSequence(), 4u);
+        EXPECT_FALSE(exists(config.path));
+        EXPECT_THROW(journal.record(3), std::out_of_range);
+    }
+
+    OrderJournal reopened(config);
+    EXPECT_EQ(reopened.firstSequence(), 4u);
+    EXPECT_EQ(reopened.lastSequence(), 7u);
+    std::vector<std::string> ids;
+    reopened.replay([&](const JournalRecord& record) { ids.push_back(record.clOrdId.str()); });
+    EXPECT_EQ(ids, (std::vector<std::string>{"B1", "B2", "B3", "B4"}));
+}
+
+TEST_F(OrderJournalTest, DropsSegmentsThatDoNotFollowOn) {
+    config.capacity = 4;
+    {
+        OrderJournal journal(config);
+        journal.append(JournalRecord::newOrder(order("A1")));
+        journal.append(JournalRecord::newOrder(order("A2")));
+        journal.startSegment();
+        journal.append(JournalRecord::newOrder(order("B1")));
+        // Started but never written to
+        journal.startSegment();
+    }
+
+    // Tear the second event: the segment after it no longer follows on
+    {
+        std::fstream file(config.path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(4096 + sizeof(JournalRecord) + offsetof(JournalRecord, orderQty));
+        file.put('\x7f');
+    }
+
+    OrderJournal reopened(config);
+    EXPECT_EQ(reopened.lastSequence(), 1u);
+    EXPECT_FALSE(exists(config.path + ".1"));
+    EXPECT_FALSE(exists(config.path + ".2"));
+    EXPECT_EQ(reopened.append(JournalRecord::newOrder(order("C2"))), 2u);
+    EXPECT_EQ(reopened.record(2).clOrdId.view(), "C2");
+}
@@ -1,6 +1,8 @@
 // test/OrderManagerTest.cpp
 #include <gtest/gtest.h>
 #include "OrderManager.hpp"
+#include <thread>
+#include <vector>
 
 class OrderManagerTest : public ::testing::Test {
 protected:
@@ -12,10 +14,16 @@ TEST_F(OrderManagerTest, CreateAndRetrieveOrder_Test) {
     std::string orderDetails = "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|";
     
     manager.createOrder(orderId, orderDetails);
-    auto retrievedOrder = manager.getOrder(orderId);
+    std::optional<Order> retrievedOrder = manager.getOrder(orderId);
     
     ASSERT_TRUE(retrievedOrder.has_value());
-    EXPECT_EQ(retrievedOrder.value(), orderDetails);
+    EXPECT_EQ(retrievedOrder->clOrdId.view(), orderId);
+    EXPECT_EQ(manager.instruments().symbol(retrievedOrder->instrument), "AAPL");
+    EXPECT_EQ(retrievedOrder->side, '1');
+    EXPECT_EQ(retrievedOrder->price, Price::parse("150.50"));
+    EXPECT_EQ(retrievedOrder->orderQty, Qty(100));
+    EXPECT_EQ(retrievedOrder->state, OrderState::NEW);
+    EXPECT_GT(retrievedOrder->orderId, 0u);
 }
 
 TEST_F(OrderManagerTest, CancelOrder_Test) {
@@ -28,8 +36,7 @@ TEST_F(OrderManagerTest, CancelOrder_Test) {
     manager.cancelOrder(orderId);
     EXPECT_FALSE(manager.orderExists(orderId));
     
-    auto retrievedOrder = manager.getOrder(orderId);
-    EXPECT_FALSE(retrievedOrder.has_value());
+    EXPECT_FALSE(manager.getOrder(orderId).has_value());
 }
 
 TEST_F(OrderManagerTest, ModifyOrder_Test) {
@@ -40,9 +47,35 @@ TEST_F(OrderManagerTest, ModifyOrder_Test) {
     manager.createOrder(orderId, orderDetails);
     manager.modifyOrder(orderId, newDetails);
     
-    auto retrievedOrder = manager.getOrder(orderId);
+    std::optional<Order> retrievedOrder = manager.getOrder(orderId);
     ASSERT_TRUE(retrievedOrder.has_value());
-    EXPECT_EQ(retrievedOrder.value(), newDetails);
+    EXPECT_EQ(retrievedOrder->price, Price::parse("160.50"));
+    EXPECT_EQ(retrievedOrder->orderQty, Qty(200));
+}
+
+TEST_F(OrderManagerTest, ModifyRejectsEmptyValues_Test) {
+    std::string orderId = "ORDER123";
+    manager.createOrder(orderId, "35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|");
+
+    EXPECT_THROW(manager.modifyOrder(orderId, "35=G|54=|38=200|"), std::invalid_argument);
+    EXPECT_THROW(manager.modifyOrder(orderId, "35=G|40=|"), std::invalid_argument);
+    // Rejected before any field changed
+    std::optional<Order> unchanged = manager.getOrder(orderId);
+    ASSERT_TRUE(unchanged.has_value());
+    EXPECT_EQ(unchanged->side, '1');
+    EXPECT_EQ(unchanged->orderQty, Qty(100));
+}
+
+TEST_F(OrderManagerTest, SnapshotOutlivesTheOrder_Test) {
+    manager.createOrder("ORDER123", "35=D|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|");
+    std::optional<Order> snapshot = manager.getOrder("ORDER123");
+    manager.cancelOrder("ORDER123");
+    // Reuses the cancelled order's slot
+    manager.createOrder("ORDER456", "35=D|11=ORDER456|55=MSFT|54=2|44=10|38=5|40=2|");
+
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->clOrdId.view(), "ORDER123");
+    EXPECT_EQ(snapshot->orderQty, Qty(100));
 }
 
 TEST_F(OrderManagerTest, DuplicateOrder_Test) {
@@ -71,3 +104,82 @@ TEST_F(OrderManagerTest, ProcessFixMessage_Test) {
     EXPECT_NO_THROW(manager.processOrder(fixMessage));
     EXPECT_TRUE(manager.orderExists("ORDER123"));
 }
+
+TEST_F(OrderManagerTest, ProcessCancelAndReplace_Test) {
+    manager.processOrder("35=D|49=SENDER|56=TARGET|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|40=2|");
+    manager.processOrder("35=G|11=ORDER124|41=ORDER123|55=AAPL|54=1|44=151.00|38=300|");
+
+    EXPECT_FALSE(manager.orderExists("ORDER123"));
+    std::optional<Order> replaced = manager.getOrder("ORDER124");
+    ASSERT_TRUE(replaced.has_value());
+    EXPECT_EQ(replaced->price, Price::parse("151"));
+    EXPECT_EQ(replaced->orderQty, Qty(300));
+    EXPECT_EQ(replaced->state, OrderState::REPLACED);
+
+    manager.processOrder("35=F|11=ORDER125|41=ORDER124|55=AAPL|54=1|");
+    EXPECT_FALSE(manager.orderExists("ORDER124"));
+    EXPECT_EQ(manager.size(), 0u);
+}
+
+TEST_F(OrderManagerTest, ReusesPooledSlots_Test) {
+    std::string orderDetails = "35=D|11=ORDER123|55=AAPL|54=1|44=150.50|38=100|";
+    for (int i = 0; i < 1000; ++i) {
+        std::string orderId = "ORDER" + std::to_string(i);
+        manager.createOrder(orderId, orderDetails);
+        manager.cancelOrder(orderId);
+    }
+    manager.createOrder("LAST", orderDetails);
+
+    EXPECT_EQ(manager.size(), 1u);
+    EXPECT_EQ(manager.getOrder("LAST")->clOrdId.view(), "LAST");
+}
+
+TEST_F(OrderManagerTest, RejectsOversizedClOrdId_Test) {
+    std::string orderId(ClOrdId::kCapacity + 1, 'X');
+    EXPECT_THROW(manager.createOrder(orderId, "35=D|55=AAPL|54=1|38=100|11=" + orderId + "|"),
+                 std::length_error);
+    EXPECT_FALSE(manager.orderExists(orderId));
+}
+
+TEST(ShardedOrderManagerTest, ReplaceMovesOrderAcrossShards_Test) {
+    OrderManager manager(1024, 8);
+    EXPECT_EQ(manager.shardCount(), 8u);
+
+    // Enough replaces that some new ClOrdIDs land in a different shard
+    for (int i = 0; i < 64; ++i) {
+        std::string id = "ORDER" + std::to_string(i);
+        manager.processOrder("35=D|11=" + id + "|55=AAPL|54=1|44=150.50|38=100|");
+        manager.processOrder("35=G|11=NEW" + id + "|41=" + id + "|55=AAPL|54=1|44=151|38=200|");
+    }
+
+    EXPECT_EQ(manager.size(), 64u);
+    for (int i = 0; i < 64; ++i) {
+        std::string id = "ORDER" + std::to_string(i);
+        EXPECT_FALSE(manager.orderExists(id));
+        std::optional<Order> order = manager.getOrder("NEW" + id);
+        ASSERT_TRUE(order.has_value());
+        EXPECT_EQ(order->orderQty, Qty(200));
+    }
+}
+
+TEST(ShardedOrderManagerTest, ConcurrentWorkers_Test) {
+    OrderManager manager(4096, 4);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&manager, t] {
+            for (int i = 0; i < 500; ++i) {
+                std::string id = "T" + std::to_string(t) + "-" + std::to_string(i);
+                manager.processOrder("35=D|11=" + id + "|55=AAPL|54=1|44=150.50|38=100|");
+                if (i % 2 == 0) {
+                    manager.cancelOrder(id);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(manager.size(), 4u * 250u);
+}
@@ -0,0 +1,156 @@
+// test/OrderPipelineTest.cpp
+#include <gtest/gtest.h>
+#include "OrderPipeline.hpp"
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::string newOrder(const std::string& clOrdId, const std::string& qty = "100") {
+        return "35=D|49=SENDER|56=TARGET|1=ACC|11=" + clOrdId + "|55=AAPL|54=1|44=100|38=" + qty + "|40=2|";
+    }
+
+    std::string replace(const std::string& clOrdId, const std::string& origClOrdId, const std::string& qty) {
+        return "35=G|49=SENDER|56=TARGET|1=ACC|11=" + clOrdId + "|41=" + origClOrdId +
+               "|55=AAPL|54=1|44=100|38=" + qty + "|40=2|";
+    }
+
+    std::string cancel(const std::string& clOrdId, const std::string& origClOrdId) {
+        return "35=F|49=SENDER|56=TARGET|1=ACC|11=" + clOrdId + "|41=" + origClOrdId + "|55=AAPL|54=1|";
+    }
+
+    std::shared_ptr<OrderManager> singleWriterOrders(std::shared_ptr<InstrumentRegistry> instruments = nullptr) {
+        return std::make_shared<OrderManager>(1024, 4, std::move(instruments),
+                                              OrderManager::Concurrency::SINGLE_WRITER);
+    }
+}
+
+TEST(OrderPipelineTest, RequiresSingleWriterOrderManager) {
+    EXPECT_THROW(OrderPipeline(PipelineConfig{}, std::make_shared<OrderManager>()), std::invalid_argument);
+}
+
+TEST(OrderPipelineTest, AnswersEveryRequestInPublishOrder) {
+    auto orders = singleWriterOrders();
+    std::vector<std::string> responses;
+    PipelineConfig config;
+    config.capacity = 4;  // Smaller than the burst, so publishers wait on the ring
+    config.onResponse = [&](const PipelineEvent& event) { responses.push_back(event.response); };
+    OrderPipeline pipeline(config, orders);
+
+    pipeline.publish(newOrder("A1"));
+    pipeline.publish(newOrder("A1"));                 // Duplicate
+    pipeline.publish(replace("A2", "A1", "200"));
+    pipeline.publish(cancel("C1", "A1"));             // A1 is gone after the replace
+    pipeline.publish("35=Z|49=SENDER|56=TARGET|");    // Unsupported
+    pipeline.publish(newOrder("B1"));
+    uint64_t last = pipeline.publish(cancel("C2", "B1"));
+    pipeline.waitCompleted(last);
+
+    ASSERT_EQ(responses.size(), 7u);
+    EXPECT_EQ(responses[0].rfind("ACK|OrderID=A1|Symbol=AAPL|Side=BUY|Quantity=100|Price=100|Status=ACCEPTED|", 0), 0u);
+    EXPECT_EQ(responses[1], "NAK|Error=Duplicate ClOrdID");
+    EXPECT_EQ(responses[2].rfind("ACK|OrderID=A2|OrigOrderID=A1|", 0), 0u);
+    EXPECT_NE(responses[2].find("Quantity=200|"), std::string::npos);
+    EXPECT_EQ(responses[3], "NAK|Error=Unknown order");
+    EXPECT_EQ(responses[4].rfind("NAK|Error=Unsupported MsgType: Z", 0), 0u);
+    EXPECT_EQ(responses[6].rfind("ACK|OrderID=C2|OrigOrderID=B1|Status=CANCEL_ACCEPTED|", 0), 0u);
+
+    EXPECT_EQ(orders->size(), 1u);
+    EXPECT_EQ(orders->getOrder("A2")->orderQty, Qty(200));
+
+    PipelineStats stats = pipeline.stats();
+    EXPECT_EQ(stats.completed, 7u);
+    EXPECT_EQ(stats.rejected, 3u);
+    for (const auto& stage : stats.stages) {
+        EXPECT_EQ(stage.processed, 7u) << pipelineStageName(stage.stage);
+        EXPECT_EQ(stage.backlog, 0u) << pipelineStageName(stage.stage);
+    }
+    EXPECT_GT(stats.maxLatencyNs, 0u);
+}
+
+TEST(OrderPipelineTest, ConcurrentPublishersLoseNothing) {
+    auto orders = singleWriterOrders();
+    std::mutex mutex;
+    std::size_t acks = 0;
+    PipelineConfig config;
+    config.capacity = 64;
+    // Each stage waits its own way
+    config.wait = {WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD, WaitStrategy::SPIN_PARK,
+                   WaitStrategy::BLOCKING, WaitStrategy::SPIN_YIELD};
+    config.onResponse = [&](const PipelineEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        acks += event.rejected ? 0 : 1;
+    };
+    auto pipeline = std::make_unique<OrderPipeline>(config, orders);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < kThreads; ++t) {
+        publishers.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                std::string id = "T" + std::to_string(t) + "-" + std::to_string(i);
+                pipeline->publish(newOrder(id));
+                if (i % 2 == 1) {
+                    pipeline->publish(cancel("X" + id, "T" + std::to_string(t) + "-" + std::to_string(i - 1)));
+                }
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    pipeline.reset();  // Drains the ring
+
+    EXPECT_EQ(orders->size(), static_cast<std::size_t>(kThreads * kPerThread / 2));
+    EXPECT_EQ(acks, static_cast<std::size_t>(kThreads * kPerThread * 3 / 2));
+}
+
+TEST(OrderPipelineTest, JournalsOnlyWhatReachedOrderState) {
+    std::string path = ::testing::TempDir() + "order_pipeline_journal.bin";
+    std::remove(path.c_str());
+    JournalConfig journalConfig;
+    journalConfig.path = path;
+    journalConfig.capacity = 256;
+    journalConfig.groupCommitInterval = std::chrono::microseconds(50);
+    auto journal = std::make_shared<OrderJournal>(journalConfig);
+
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    auto orders = singleWriterOrders(instruments);
+    auto risk = std::make_shared<RiskChecker>(instruments);
+    risk->setAccountLimits(risk->account("ACC"), Price::parse("50000"), 1000);
+
+    std::vector<uint64_t> sequences;
+    int64_t openAfterFirst = 0;
+    PipelineConfig config;
+    config.ackAfterDurable = true;
+    config.onResponse = [&](const PipelineEvent& event) {
+        // Durable before it is answered
+        EXPECT_GE(journal->durableSequence(), event.journalSequence);
+        sequences.push_back(event.journalSequence);
+    };
+    {
+        OrderPipeline pipeline(config, orders, journal, risk);
+        pipeline.waitCompleted(pipeline.publish(newOrder("A1")));
+        openAfterFirst = risk->openNotional(risk->account("ACC"));
+        pipeline.publish(newOrder("A2", "1000"));        // Notional over the limit: risk stage
+        pipeline.publish(replace("A3", "A1", "1000"));   // Growing A1 past it: order state stage
+        pipeline.publish(cancel("C1", "MISSING"));       // Attempted, fails, still journaled
+        pipeline.waitCompleted(pipeline.publish(replace("A4", "A1", "50")));
+        EXPECT_EQ(pipeline.stats().rejected, 3u);
+    }
+    EXPECT_EQ(sequences, (std::vector<uint64_t>{1, 0, 0, 2, 3}));
+    EXPECT_EQ(journal->lastSequence(), 3u);
+    // A1 for 100 was replaced by A4 for 50
+    EXPECT_GT(openAfterFirst, 0);
+    EXPECT_EQ(risk->openNotional(risk->account("ACC")), openAfterFirst / 2);
+
+    OrderManager replayed(1024, 4);
+    journal->replay([&](const JournalRecord& record) { replayed.apply(record); });
+    ASSERT_EQ(replayed.size(), 1u);
+    EXPECT_EQ(replayed.getOrder("A4")->orderQty, Qty(50));
+    EXPECT_EQ(replayed.getOrder("A4")->updatedNs, orders->getOrder("A4")->updatedNs);
+    journal.reset();
+    std::remove(path.c_str());
+}
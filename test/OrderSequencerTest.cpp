@@ -0,0 +1,181 @@
+// test/OrderSequencerTest.cpp
+#include <gtest/gtest.h>
+#include "OrderSequencer.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+namespace {
+    JournalRecord newOrder(const std::string& clOrdId, const char* price = "100", int64_t qty = 10) {
+        fix::NewOrderSingle order;
+        order.clOrdId = clOrdId;
+        order.symbol = "AAPL";
+        order.side = fix::side::Buy;
+        order.ordType = fix::ord_type::Limit;
+        order.price = Price::parse(price);
+        order.orderQty = Qty(qty);
+        return JournalRecord::newOrder(order);
+    }
+
+    JournalRecord cancel(const std::string& clOrdId, const std::string& origClOrdId) {
+        fix::OrderCancelRequest request;
+        request.clOrdId = clOrdId;
+        request.origClOrdId = origClOrdId;
+        return JournalRecord::cancel(request);
+    }
+
+    JournalRecord replace(const std::string& clOrdId, const std::string& origClOrdId, int64_t qty) {
+        fix::OrderCancelReplaceRequest request;
+        request.clOrdId = clOrdId;
+        request.origClOrdId = origClOrdId;
+        request.side = fix::side::Buy;
+        request.orderQty = Qty(qty);
+        return JournalRecord::modify(request);
+    }
+
+    std::shared_ptr<OrderManager> singleWriterOrders() {
+        return std::make_shared<OrderManager>(1024, 4, nullptr, OrderManager::Concurrency::SINGLE_WRITER);
+    }
+}
+
+TEST(OrderSequencerTest, RequiresSingleWriterOrderManager) {
+    EXPECT_THROW(OrderSequencer(SequencerConfig{}, std::make_shared<OrderManager>()), std::invalid_argument);
+}
+
+TEST(OrderSequencerTest, AppliesEventsInPublishOrder) {
+    auto orders = singleWriterOrders();
+    std::vector<std::pair<uint64_t, bool>> outcomes;
+    SequencerConfig config;
+    config.capacity = 4;  // Smaller than the burst, so publishers wait on the ring
+    config.onProcessed = [&](uint64_t ticket, bool applied) { outcomes.emplace_back(ticket, applied); };
+    OrderSequencer sequencer(config, orders);
+
+    EXPECT_EQ(sequencer.publish(newOrder("A1")), 1u);
+    EXPECT_EQ(sequencer.publish(replace("A2", "A1", 20)), 2u);
+    EXPECT_EQ(sequencer.publish(cancel("C1", "A1")), 3u);  // A1 is gone after the replace
+    EXPECT_EQ(sequencer.publish(newOrder("B1")), 4u);
+    EXPECT_EQ(sequencer.publish(cancel("C2", "B1")), 5u);
+    uint64_t last = sequencer.publish(newOrder("B2"));
+    sequencer.waitProcessed(last);
+
+    EXPECT_EQ(sequencer.processed(), 6u);
+    EXPECT_EQ(sequencer.rejected(), 1u);
+    ASSERT_EQ(outcomes.size(), 6u);
+    EXPECT_FALSE(outcomes[2].second);
+    EXPECT_EQ(orders->size(), 2u);
+    EXPECT_EQ(orders->getOrder("A2")->orderQty, Qty(20));
+    EXPECT_FALSE(orders->getOrder("B1").has_value());
+}
+
+TEST(OrderSequencerTest, ConcurrentPublishersLoseNothing) {
+    auto orders = singleWriterOrders();
+    SequencerConfig config;
+    config.capacity = 64;
+    auto sequencer = std::make_unique<OrderSequencer>(config, orders);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < kThreads; ++t) {
+        publishers.emplace_back([&, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                std::string id = "T" + std::to_string(t) + "-" + std::to_string(i);
+                sequencer->publish(newOrder(id));
+                // Each thread cancels its own previous order; arrival order
+                // per thread is kept, so every cancel finds its order
+                if (i % 2 == 1) {
+                    sequencer->publish(cancel("X" + id, "T" + std::to_string(t) + "-" + std::to_string(i - 1)));
+                }
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    sequencer.reset();  // Drains the ring
+
+    EXPECT_EQ(orders->size(), static_cast<std::size_t>(kThreads * kPerThread / 2));
+}
+
+TEST(OrderSequencerTest, JournalReplayReproducesState) {
+    std::string path = ::testing::TempDir() + "order_sequencer_journal.bin";
+    std::remove(path.c_str());
+    JournalConfig journalConfig;
+    journalConfig.path = path;
+    journalConfig.capacity = 256;
+    journalConfig.groupCommitInterval = std::chrono::microseconds(50);
+    auto journal = std::make_shared<OrderJournal>(journalConfig);
+
+    auto orders = singleWriterOrders();
+    {
+        OrderSequencer sequencer(SequencerConfig{}, orders, journal);
+        sequencer.publish(newOrder("A1", "10.5"));
+        sequencer.publish(newOrder("A2", "11"));
+        sequencer.publish(replace("A3", "A1", 30));
+        sequencer.publish(cancel("C1", "MISSING"));
+        uint64_t ticket = sequencer.publish(newOrder("A4", "12"));
+        sequencer.waitDurable(ticket);
+        EXPECT_GE(journal->durableSequence(), 5u);
+    }
+    // Every event is journaled, rejected ones included, in application order
+    EXPECT_EQ(journal->lastSequence(), 5u);
+
+    OrderManager replayed(1024, 4);
+    journal->replay([&](const JournalRecord& record) { replayed.apply(record); });
+    EXPECT_EQ(replayed.size(), orders->size());
+    orders->forEachOrder([&](const Order& order) {
+        std::optional<Order> copy = replayed.getOrder(order.clOrdId.view());
+        ASSERT_TRUE(copy.has_value());
+        EXPECT_EQ(copy->orderId, order.orderId);
+        EXPECT_EQ(copy->orderQty, order.orderQty);
+        EXPECT_EQ(copy->price, order.price);
+        EXPECT_EQ(copy->createdNs, order.createdNs);
+        EXPECT_EQ(copy->updatedNs, order.updatedNs);
+    });
+    journal.reset();
+    std::remove(path.c_str());
+}
+
+TEST(OrderSequencerTest, RunsExistingOrderRiskChecks) {
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    auto orders = std::make_shared<OrderManager>(1024, 4, instruments, OrderManager::Concurrency::SINGLE_WRITER);
+    auto risk = std::make_shared<RiskChecker>(instruments);
+    AccountId account = risk->account("ACC");
+    risk->setAccountLimits(account, Price::parse("10000"), 1000);
+
+    // Exposure is reserved by the new-order check on the network thread
+    fix::NewOrderSingle order;
+    order.clOrdId = "A1";
+    order.symbol = "AAPL";
+    order.side = fix::side::Buy;
+    order.ordType = fix::ord_type::Limit;
+    order.price = Price::parse("100");
+    order.orderQty = Qty(50);
+    ASSERT_EQ(risk->checkNewOrder(order, account, 0), RiskCheck::PASSED);
+
+    OrderSequencer sequencer(SequencerConfig{}, orders, nullptr, risk);
+    sequencer.publish(JournalRecord::newOrder(order), account);
+    // Growing the order to 200 would take open notional past the limit
+    SequencerOutcome outcome;
+    sequencer.publish(replace("A2", "A1", 200), account, &outcome);
+    OrderSequencer::wait(outcome);
+    EXPECT_FALSE(outcome.applied);
+    EXPECT_EQ(outcome.risk, RiskCheck::OPEN_EXPOSURE);
+    EXPECT_EQ(sequencer.rejected(), 1u);
+    EXPECT_TRUE(orders->getOrder("A1").has_value());
+
+    // A duplicate is reserved for on the network thread, then rejected here
+    ASSERT_EQ(risk->checkNewOrder(order, account, 0), RiskCheck::PASSED);
+    SequencerOutcome duplicate;
+    sequencer.publish(JournalRecord::newOrder(order), account, &duplicate);
+    OrderSequencer::wait(duplicate);
+    EXPECT_FALSE(duplicate.applied);
+    EXPECT_EQ(risk->openNotional(account), RiskChecker::notional(order.price, order.orderQty));
+    uint64_t ticket = 0;
+
+    ticket = sequencer.publish(cancel("C1", "A1"), account);
+    sequencer.waitProcessed(ticket);
+    EXPECT_EQ(orders->size(), 0u);
+    EXPECT_EQ(risk->openNotional(account), 0);
+}
@@ -0,0 +1,249 @@
+// test/OrderSnapshotTest.cpp
+#include <gtest/gtest.h>
+#include "OrderSnapshot.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+    class OrderSnapshotTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            directory = ::testing::TempDir() + "order_snapshot_test_" +
+                        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+            journalConfig.path = directory + "/journal.bin";
+            journalConfig.capacity = 1024;
+            journalConfig.fsync = false;
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        static JournalRecord newOrder(const char* clOrdId, const char* symbol, const char* price, int64_t qty) {
+            fix::NewOrderSingle order;
+            order.clOrdId = clOrdId;
+            order.account = "ACC1";
+            order.symbol = symbol;
+            order.side = fix::side::Buy;
+            order.ordType = fix::ord_type::Limit;
+            order.price = Price::parse(price);
+            order.orderQty = Qty(qty);
+            return JournalRecord::newOrder(order);
+        }
+
+        static JournalRecord cancel(const char* clOrdId, const char* origClOrdId) {
+            fix::OrderCancelRequest request;
+            request.clOrdId = clOrdId;
+            request.origClOrdId = origClOrdId;
+            return JournalRecord::cancel(request);
+        }
+
+        static JournalRecord replace(const char* clOrdId, const char* origClOrdId, int64_t qty) {
+            fix::OrderCancelReplaceRequest request;
+            request.clOrdId = clOrdId;
+            request.origClOrdId = origClOrdId;
+            request.side = fix::side::Buy;
+            request.orderQty = Qty(qty);
+            return JournalRecord::modify(request);
+        }
+
+        // Same live orders with the same fields, regardless of order ids
+        static void expectSameOrders(const OrderManager& expected, const OrderManager& actual) {
+            EXPECT_EQ(actual.size(), expected.size());
+            expected.forEachOrder([&](const Order& order) {
+                std::optional<Order> restored = actual.getOrder(order.clOrdId.view());
+                ASSERT_TRUE(restored.has_value()) << order.clOrdId.str();
+                EXPECT_EQ(actual.instruments().symbol(restored->instrument),
+                          expected.instruments().symbol(order.instrument));
+                EXPECT_EQ(restored->price, order.price);
+                EXPECT_EQ(restored->orderQty, order.orderQty);
+                EXPECT_EQ(restored->state, order.state);
+                EXPECT_EQ(restored->createdNs, order.createdNs);
+                EXPECT_EQ(restored->accountCode, order.accountCode);
+            });
+        }
+
+        std::string directory;
+        JournalConfig journalConfig;
+    };
+}
+
+TEST_F(OrderSnapshotTest, RoundTripRemapsInstruments) {
+    OrderManager original(64, 4);
+    ASSERT_TRUE(original.apply(newOrder("A1", "AAPL", "150.25", 100)));
+    ASSERT_TRUE(original.apply(newOrder("M1", "MSFT", "310.5", 50)));
+    ASSERT_TRUE(original.apply(replace("M2", "M1", 75)));
+
+    SnapshotInfo written = writeOrderSnapshot(directory, original, 3);
+    EXPECT_EQ(written.orders, 2u);
+    EXPECT_EQ(listOrderSnapshots(directory), std::vector<std::string>{written.path});
+
+    // Symbols interned in another order get other ids in the new registry
+    auto instruments = std::make_shared<InstrumentRegistry>();
+    instruments->intern("MSFT");
+    OrderManager restored(64, 8, instruments);
+    SnapshotInfo loaded = loadOrderSnapshot(written.path, restored);
+    EXPECT_EQ(loaded.journalSequence, 3u);
+    expectSameOrders(original, restored);
+    EXPECT_EQ(restored.getOrder("M2")->state, OrderState::REPLACED);
+    EXPECT_EQ(restored.getOrder("M2")->accountCode.view(), "ACC1");
+
+    // Order ids handed out after the restore do not collide with restored ones
+    ASSERT_TRUE(restored.apply(newOrder("B1", "AAPL", "1", 1)));
+    uint64_t newId = restored.getOrder("B1")->orderId;
+    EXPECT_NE(newId, restored.getOrder("A1")->orderId);
+    EXPECT_NE(newId, restored.getOrder("M2")->orderId);
+}
+
+TEST_F(OrderSnapshotTest, RecoveryReplaysOnlyTheJournalTail) {
+    OrderJournal journal(journalConfig);
+    OrderManager live(64, 4);
+    auto record = [&](const JournalRecord& event) {
+        live.apply(journal.record(journal.append(event)));
+    };
+
+    record(newOrder("A1", "AAPL", "150.25", 100));
+    record(newOrder("A2", "AAPL", "150.50", 200));
+    record(newOrder("A3", "IBM", "99", 10));
+    writeOrderSnapshot(directory, live, journal.lastSequence(), &journal);
+
+    record(cancel("C1", "A1"));
+    record(replace("A4", "A2", 150));
+    record(newOrder("A5", "MSFT", "310", 5));
+    record(cancel("C2", "MISSING"));  // Rejected live, so also rejected on replay
+
+    OrderManager recovered(64, 4);
+    RecoveryResult result = recoverOrders(directory, journal, recovered);
+    EXPECT_EQ(result.snapshot.journalSequence, 3u);
+    EXPECT_EQ(result.snapshot.orders, 3u);
+    EXPECT_EQ(result.replayedEvents, 4u);
+    EXPECT_EQ(result.journalSequence, 7u);
+    expectSameOrders(live, recovered);
+}
+
+TEST_F(OrderSnapshotTest, RecoveryWithoutSnapshotReplaysWholeJournal) {
+    OrderJournal journal(journalConfig);
+    journal.append(newOrder("A1", "AAPL", "1", 1));
+    journal.append(newOrder("A2", "AAPL", "1", 1));
+
+    OrderManager recovered;
+    RecoveryResult result = recoverOrders(directory, journal, recovered);
+    EXPECT_TRUE(result.snapshot.path.empty());
+    EXPECT_EQ(result.replayedEvents, 2u);
+    EXPECT_EQ(recovered.size(), 2u);
+}
+
+TEST_F(OrderSnapshotTest, FallsBackPastUnusableSnapshots) {
+    OrderJournal journal(journalConfig);
+    OrderManager live;
+    for (const char* id : {"A1", "A2", "A3", "A4"}) {
+        live.apply(journal.record(journal.append(newOrder(id, "AAPL", "1", 1))));
+        writeOrderSnapshot(directory, live, journal.lastSequence(), &journal);
+    }
+
+    // Newest is corrupt; the one before was taken from another journal
+    std::vector<std::string> snapshots = listOrderSnapshots(directory);
+    ASSERT_EQ(snapshots.size(), 4u);
+    {
+        std::fstream file(snapshots[0], std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(64 + 40);
+        file.put('\x5a');
+    }
+    {
+        std::string other = directory + "/other";
+        JournalConfig otherConfig = journalConfig;
+        otherConfig.path = directory + "/other.bin";
+        OrderJournal otherJournal(otherConfig);
+        OrderManager otherOrders;
+        for (int i = 0; i < 3; ++i) {
+            otherOrders.apply(otherJournal.record(otherJournal.append(newOrder("X", "IBM", "2", 2))));
+        }
+        SnapshotInfo foreign = writeOrderSnapshot(other, otherOrders, 3, &otherJournal);
+        std::filesystem::rename(foreign.path, snapshots[1]);
+    }
+
+    OrderManager recovered;
+    RecoveryResult result = recoverOrders(directory, journal, recovered);
+    EXPECT_EQ(result.skippedSnapshots, 2u);
+    EXPECT_EQ(result.snapshot.path, snapshots[2]);
+    EXPECT_EQ(result.replayedEvents, 2u);
+    expectSameOrders(live, recovered);
+}
+
+TEST_F(OrderSnapshotTest, SnapshotterFollowsTheDurableJournal) {
+    auto journal = std::make_shared<OrderJournal>(journalConfig);
+    OrderManager live;
+    auto record = [&](const JournalRecord& event) {
+        live.apply(journal->record(journal->append(event)));
+    };
+    record(newOrder("A1", "AAPL", "150", 100));
+    record(newOrder("A2", "IBM", "99", 10));
+    journal->flush();
+
+    SnapshotConfig config;
+    config.directory = directory + "/snapshots";
+    config.interval = std::chrono::seconds(3600);
+    config.retain = 2;
+    OrderSnapshotter snapshotter(config, journal);
+    EXPECT_EQ(snapshotter.snapshotNow(), 2u);
+
+    record(cancel("C1", "A1"));
+    record(newOrder("A3", "MSFT", "300", 1));
+    journal->flush();
+    EXPECT_EQ(snapshotter.snapshotNow(), 4u);
+    // Nothing new: no new file
+    EXPECT_EQ(snapshotter.snapshotNow(), 4u);
+
+    record(newOrder("A4", "MSFT", "301", 1));
+    journal->flush();
+    EXPECT_EQ(snapshotter.snapshotNow(), 5u);
+    EXPECT_EQ(listOrderSnapshots(config.directory).size(), 2u);
+
+    OrderManager recovered;
+    RecoveryResult result = recoverOrders(config.directory, *journal, recovered);
+    EXPECT_EQ(result.snapshot.journalSequence, 5u);
+    EXPECT_EQ(result.replayedEvents, 0u);
+    expectSameOrders(live, recovered);
+}
+
+TEST_F(OrderSnapshotTest, SnapshotsRetireJournalSegments) {
+    // Far more events than one segment holds
+    journalConfig.capacity = 4;
+    auto journal = std::make_shared<OrderJournal>(journalConfig);
+    OrderManager live;
+
+    SnapshotConfig config;
+    config.directory = directory + "/snapshots";
+    config.interval = std::chrono::seconds(3600);
+    config.retain = 2;
+    {
+        OrderSnapshotter snapshotter(config, journal);
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 3; ++i) {
+                std::string id = "R" + std::to_string(round) + "-" + std::to_string(i);
+                live.apply(journal->record(journal->append(newOrder(id.c_str(), "AAPL", "10", 1))));
+            }
+            live.apply(journal->record(journal->append(cancel("C", ("R" + std::to_string(round) + "-0").c_str()))));
+            journal->flush();
+            EXPECT_EQ(snapshotter.snapshotNow(), journal->lastSequence());
+        }
+    }
+    // Only the segments the two retained snapshots need are left
+    EXPECT_GT(journal->firstSequence(), 30u);
+    EXPECT_FALSE(std::filesystem::exists(journalConfig.path));
+
+    journal.reset();
+    OrderJournal reopened(journalConfig);
+    EXPECT_EQ(reopened.lastSequence(), 40u);
+    OrderManager recovered;
+    RecoveryResult result = recoverOrders(config.directory, reopened, recovered);
+    EXPECT_EQ(result.snapshot.journalSequence, 40u);
+    expectSameOrders(live, recovered);
+
+    // Without a snapshot the discarded events cannot be rebuilt
+    OrderManager unrecoverable;
+    EXPECT_THROW(recoverOrders(directory + "/none", reopened, unrecoverable), std::runtime_error);
+}
@@ -0,0 +1,71 @@
+// test/OutboundQueueTest.cpp
+#include <gtest/gtest.h>
+#include "OutboundQueue.hpp"
+#include <string>
+
+namespace {
+    std::string gathered(const OutboundQueue::Gather& buffers) {
+        std::string bytes;
+        for (const auto& buffer : buffers) {
+            bytes.append(static_cast<const char*>(buffer.data()), buffer.size());
+        }
+        return bytes;
+    }
+}
+
+TEST(OutboundQueueTest, OneWriteTakesEverythingQueued) {
+    OutboundQueue queue(16);
+    EXPECT_TRUE(queue.empty());
+    queue.append("ACK|OrderID=A1|", '\n');
+    queue.append("NAK|Error=x", '\n');
+    EXPECT_EQ(queue.pendingBytes(), 28u);
+
+    const auto& buffers = queue.beginWrite();
+    // Split over fixed-size chunks, gathered back in order
+    EXPECT_EQ(buffers.size(), 2u);
+    EXPECT_EQ(gathered(buffers), "ACK|OrderID=A1|\nNAK|Error=x\n");
+    EXPECT_TRUE(queue.writing());
+    EXPECT_TRUE(queue.empty());
+    queue.endWrite();
+    EXPECT_FALSE(queue.writing());
+}
+
+TEST(OutboundQueueTest, AppendsDuringAWriteWaitForTheNext) {
+    OutboundQueue queue(64);
+    queue.append("first", '\n');
+    std::string inFlight = gathered(queue.beginWrite());
+
+    queue.append("second", '\n');
+    queue.append("third", '\n');
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.pendingBytes(), 13u);
+    queue.endWrite();
+
+    EXPECT_EQ(inFlight, "first\n");
+    EXPECT_EQ(gathered(queue.beginWrite()), "second\nthird\n");
+    queue.endWrite();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(OutboundQueueTest, ReusesWrittenChunks) {
+    OutboundQueue queue(32);
+    queue.append("one", '\n');
+    const char* chunk = static_cast<const char*>(queue.beginWrite().front().data());
+    queue.endWrite();
+
+    queue.append("two", '\n');
+    const auto& buffers = queue.beginWrite();
+    EXPECT_EQ(buffers.front().data(), chunk);
+    EXPECT_EQ(gathered(buffers), "two\n");
+    queue.endWrite();
+}
+
+TEST(OutboundQueueTest, MessagesLongerThanAChunk) {
+    OutboundQueue queue(8);
+    std::string longMessage(50, 'x');
+    queue.append(longMessage, '\n');
+    const auto& buffers = queue.beginWrite();
+    EXPECT_EQ(buffers.size(), 7u);
+    EXPECT_EQ(gathered(buffers), longMessage + "\n");
+    queue.endWrite();
+}
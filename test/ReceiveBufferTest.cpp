@@ -0,0 +1,99 @@
+// test/ReceiveBufferTest.cpp
+#include <gtest/gtest.h>
+#include "ReceiveBuffer.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+    void receive(ReceiveBuffer& buffer, const std::string& bytes) {
+        ASSERT_LE(bytes.size(), buffer.writeSize());
+        std::memcpy(buffer.writeData(), bytes.data(), bytes.size());
+        buffer.commit(bytes.size());
+    }
+
+    std::vector<std::string> frames(ReceiveBuffer& buffer) {
+        std::vector<std::string> out;
+        buffer.consumeFrames('\n', [&](std::string_view frame) { out.emplace_back(frame); });
+        return out;
+    }
+}
+
+TEST(ReceiveBufferTest, HandsOutEveryCompleteFrameOfARead) {
+    ReceiveBuffer buffer(256);
+    receive(buffer, "35=D|11=A|\n35=D|11=B|\n\n35=F|11=C|\n");
+    EXPECT_EQ(frames(buffer), (std::vector<std::string>{"35=D|11=A|", "35=D|11=B|", "", "35=F|11=C|"}));
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_EQ(buffer.writeSize(), 256u);
+}
+
+TEST(ReceiveBufferTest, KeepsAPartialFrameForTheNextRead) {
+    ReceiveBuffer buffer(32);
+    receive(buffer, "35=D|11=A|\n35=D|1");
+    EXPECT_EQ(frames(buffer), (std::vector<std::string>{"35=D|11=A|"}));
+    // The partial frame moved to the front, freeing the space behind it
+    EXPECT_EQ(buffer.size(), 6u);
+    EXPECT_EQ(buffer.writeSize(), 26u);
+
+    receive(buffer, "1=B|\n35=F");
+    EXPECT_EQ(frames(buffer), (std::vector<std::string>{"35=D|11=B|"}));
+    receive(buffer, "|\n");
+    EXPECT_EQ(frames(buffer), (std::vector<std::string>{"35=F|"}));
+    EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST(ReceiveBufferTest, ScansFramesAcrossBlockBoundaries) {
+    // Longer than the scanner's 64-byte blocks, with frames of every length
+    ReceiveBuffer buffer(8192);
+    std::string bytes;
+    std::vector<std::string> expected;
+    for (int length = 0; length < 100; ++length) {
+        expected.push_back(std::string(length, 'x'));
+        bytes += expected.back() + "\n";
+    }
+    receive(buffer, bytes + "tail");
+    EXPECT_EQ(frames(buffer), expected);
+    EXPECT_EQ(buffer.size(), 4u);
+}
+
+TEST(ReceiveBufferTest, FullWhenAFrameCannotFit) {
+    ReceiveBuffer buffer(8);
+    receive(buffer, "12345678");
+    EXPECT_TRUE(frames(buffer).empty());
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.writeSize(), 0u);
+}
+
+TEST(ReceiveBufferTest, SwitchesFromDelimitedFramesToLengthPrefixedMessages) {
+    ReceiveBuffer buffer(64);
+    // A text logon, then a binary message and the start of another in the same read
+    receive(buffer, "35=A|\n" + std::string("\x04\x00" "ab" "\x05\x00", 6));
+    std::vector<std::string> text;
+    EXPECT_EQ(buffer.consumeFrames('\n', [&](std::string_view frame) {
+        text.emplace_back(frame);
+        return false;
+    }), 1u);
+    EXPECT_EQ(text, (std::vector<std::string>{"35=A|"}));
+    EXPECT_EQ(buffer.size(), 6u);
+
+    std::vector<std::string> binary;
+    EXPECT_EQ(buffer.consumeMessages([&](std::string_view message) { binary.emplace_back(message); }), 1u);
+    EXPECT_EQ(binary, (std::vector<std::string>{std::string("\x04\x00" "ab", 4)}));
+    EXPECT_EQ(buffer.size(), 2u);
+}
+
+TEST(ReceiveBufferTest, HandsOutWholeLengthPrefixedMessages) {
+    ReceiveBuffer buffer(64);
+    receive(buffer, std::string("\x04\x00" "ab" "\x03\x00" "z" "\x05\x00" "cd", 11));
+    std::vector<std::string> messages;
+    auto collect = [&](std::string_view message) { messages.emplace_back(message); };
+    EXPECT_EQ(buffer.consumeMessages(collect), 2u);
+    EXPECT_EQ(messages, (std::vector<std::string>{std::string("\x04\x00" "ab", 4), std::string("\x03\x00" "z", 3)}));
+    // The partial message moved to the front
+    EXPECT_EQ(buffer.size(), 4u);
+
+    receive(buffer, "e");
+    messages.clear();
+    EXPECT_EQ(buffer.consumeMessages(collect), 1u);
+    EXPECT_EQ(messages, (std::vector<std::string>{std::string("\x05\x00" "cde", 5)}));
+    EXPECT_EQ(buffer.size(), 0u);
+}
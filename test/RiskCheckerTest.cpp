@@ -0,0 +1,169 @@
+// test/RiskCheckerTest.cpp
+#include <gtest/gtest.h>
+#include "RiskChecker.hpp"
+#include "MatchingEngine.hpp"
+#include <thread>
+#include <vector>
+
+namespace {
+    class RiskCheckerTest : public ::testing::Test {
+    protected:
+        RiskCheckerTest()
+            : instruments(std::make_shared<InstrumentRegistry>())
+            , aapl(instruments->intern("AAPL")) {
+            limits.maxOrderQty = Qty(1000);
+            limits.maxOrderNotional = Price::parse("100000.00");
+            limits.priceBandBps = 1000;  // 10%
+            limits.maxOpenNotional = Price::parse("200000.00");
+            limits.maxOrdersPerSecond = 5;
+        }
+
+        fix::NewOrderSingle order(const char* price, int64_t qty) const {
+            fix::NewOrderSingle o;
+            o.symbol = "AAPL";
+            o.instrument = aapl;
+            o.side = fix::side::Buy;
+            o.ordType = fix::ord_type::Limit;
+            o.price = Price::parse(price);
+            o.orderQty = Qty(qty);
+            return o;
+        }
+
+        std::shared_ptr<InstrumentRegistry> instruments;
+        InstrumentId aapl;
+        RiskLimits limits;
+    };
+}
+
+TEST_F(RiskCheckerTest, RejectsOversizedOrders) {
+    RiskChecker risk(instruments, limits);
+    AccountId account = risk.account("ACC1");
+
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1001), account, 0), RiskCheck::ORDER_QTY);
+    EXPECT_EQ(risk.checkNewOrder(order("100.01", 1000), account, 0), RiskCheck::ORDER_NOTIONAL);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), account, 0), RiskCheck::PASSED);
+    EXPECT_EQ(risk.openNotional(account), RiskChecker::notional(Price::parse("100.00"), Qty(1000)));
+}
+
+TEST_F(RiskCheckerTest, BandsPricesAroundLastTrade) {
+    RiskChecker risk(instruments, limits);
+    AccountId account = risk.account("ACC1");
+
+    // No reference price yet
+    EXPECT_EQ(risk.checkNewOrder(order("500.00", 1), account, 0), RiskCheck::PASSED);
+
+    risk.onTrade(aapl, Price::parse("100.00"));
+    EXPECT_EQ(risk.checkNewOrder(order("110.00", 1), account, 0), RiskCheck::PASSED);
+    EXPECT_EQ(risk.checkNewOrder(order("110.01", 1), account, 0), RiskCheck::PRICE_BAND);
+    EXPECT_EQ(risk.checkNewOrder(order("89.99", 1), account, 0), RiskCheck::PRICE_BAND);
+
+    // Market orders are sized at the last trade
+    auto market = order("0", 1000);
+    market.ordType = fix::ord_type::Market;
+    risk.onTrade(aapl, Price::parse("100.01"));
+    EXPECT_EQ(risk.checkNewOrder(market, account, 0), RiskCheck::ORDER_NOTIONAL);
+}
+
+TEST_F(RiskCheckerTest, TracksOpenExposurePerAccount) {
+    RiskChecker risk(instruments, limits);
+    AccountId first = risk.account("ACC1");
+    AccountId second = risk.account("ACC2");
+
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), first, 0), RiskCheck::PASSED);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), first, 0), RiskCheck::PASSED);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1), first, 0), RiskCheck::OPEN_EXPOSURE);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), second, 0), RiskCheck::PASSED);
+
+    risk.release(first, Price::parse("100.00"), Qty(500));
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 500), first, 0), RiskCheck::PASSED);
+
+    risk.setAccountLimits(second, Price::parse("1000000.00"), 100);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), second, 0), RiskCheck::PASSED);
+    EXPECT_EQ(risk.checkNewOrder(order("100.00", 1000), second, 0), RiskCheck::PASSED);
+}
+
+TEST_F(RiskCheckerTest, LimitsOrderRatePerSecond) {
+    RiskChecker risk(instruments, limits);
+    AccountId account = risk.account("ACC1");
+    constexpr int64_t kSecond = 1'000'000'000;
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(risk.checkOrderRate(account, kSecond + i), RiskCheck::PASSED);
+    }
+    EXPECT_EQ(risk.checkOrderRate(account, kSecond + 10), RiskCheck::ORDER_RATE);
+    EXPECT_EQ(risk.checkOrderRate(account, 2 * kSecond + 10), RiskCheck::PASSED);
+}
+
+TEST_F(RiskCheckerTest, ReleasesExposureFromExecutions) {
+    auto risk = std::make_shared<RiskChecker>(instruments, limits);
+    MatchingEngine engine(1024, instruments);
+    engine.addSymbol("AAPL", BookConfig{Price::parse("1.00"), Price::parse("1000.00"), Price::parse("0.01")});
+    AccountId buyer = risk->account("BUYER");
+    AccountId seller = risk->account("SELLER");
+    std::vector<Execution> reports;
+
+    auto bid = order("100.00", 300);
+    bid.clOrdId = "B1";
+    ASSERT_EQ(risk->checkNewOrder(bid, buyer, 0), RiskCheck::PASSED);
+    engine.submit(bid, reports, buyer);
+
+    auto ask = order("100.00", 100);
+    ask.clOrdId = "S1";
+    ask.side = fix::side::Sell;
+    ASSERT_EQ(risk->checkNewOrder(ask, seller, 0), RiskCheck::PASSED);
+    engine.submit(ask, reports, seller);
+
+    fix::OrderCancelRequest cancel;
+    cancel.clOrdId = "C1";
+    cancel.origClOrdId = "B1";
+    engine.cancel(cancel, reports);
+
+    for (const auto& execution : reports) {
+        risk->onExecution(execution);
+    }
+    EXPECT_EQ(risk->openNotional(buyer), 0);
+    EXPECT_EQ(risk->openNotional(seller), 0);
+    EXPECT_EQ(risk->lastTrade(aapl), Price::parse("100.00"));
+}
+
+TEST_F(RiskCheckerTest, RestoresExposureOfRecoveredOrders) {
+    RiskChecker risk(instruments, limits);
+    Order order;
+    order.accountCode = AccountCode("ACC1");
+    order.ordType = fix::ord_type::Limit;
+    order.price = Price::parse("100.00");
+    order.orderQty = Qty(300);
+    order.cumQty = Qty(100);
+    risk.restoreOrder(order);
+    EXPECT_EQ(risk.openNotional(risk.account("ACC1")), RiskChecker::notional(order.price, Qty(200)));
+
+    // Market orders never reserved anything
+    order.ordType = fix::ord_type::Market;
+    risk.restoreOrder(order);
+    EXPECT_EQ(risk.openNotional(risk.account("ACC1")), RiskChecker::notional(order.price, Qty(200)));
+}
+
+TEST_F(RiskCheckerTest, ConcurrentReservationsNeverExceedLimit) {
+    limits.maxOrdersPerSecond = 1'000'000;
+    RiskChecker risk(instruments, limits);
+    AccountId account = risk.account("ACC1");
+    std::atomic<int> accepted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) {
+                if (risk.checkNewOrder(order("100.00", 10), account, 0) == RiskCheck::PASSED) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // 200,000.00 of headroom at 1,000.00 per order
+    EXPECT_LE(accepted.load(), 200);
+    EXPECT_LE(risk.openNotional(account), RiskChecker::notional(Price::parse("200000.00"), Qty(1)));
+}
@@ -0,0 +1,102 @@
+// test/SpscQueueTest.cpp
+#include <gtest/gtest.h>
+#include "SpscQueue.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueueTest, RoundsCapacityUpAndRejectsWhenFull) {
+    SpscQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(8));
+    EXPECT_EQ(queue.size(), 8u);
+
+    EXPECT_EQ(queue.try_pop(), 0);
+    EXPECT_TRUE(queue.try_push(8));
+    for (int i = 1; i <= 8; ++i) {
+        EXPECT_EQ(queue.try_pop(), i);
+    }
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, PushIntoAFullRingKeepsTheItem) {
+    SpscQueue<std::string> queue(2);
+    const std::string third(64, 'c');
+    queue.push(std::string(64, 'a'));
+    queue.push(std::string(64, 'b'));
+
+    std::string rejected = third;
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, third);
+
+    // Waits on the full ring until the consumer frees a slot
+    std::thread producer([&] { queue.push(third); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(queue.try_pop(), std::string(64, 'a'));
+    producer.join();
+    EXPECT_EQ(queue.try_pop(), std::string(64, 'b'));
+    EXPECT_EQ(queue.try_pop(), third);
+}
+
+TEST(SpscQueueTest, PopNTakesWhatIsAvailable) {
+    SpscQueue<std::string> queue(16);
+    for (int i = 0; i < 5; ++i) {
+        queue.push("m" + std::to_string(i));
+    }
+    std::vector<std::string> batch;
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 3), 3u);
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 10), 2u);
+    EXPECT_EQ(queue.pop_n(std::back_inserter(batch), 10), 0u);
+    EXPECT_EQ(batch, (std::vector<std::string>{"m0", "m1", "m2", "m3", "m4"}));
+}
+
+TEST(SpscQueueTest, PopTimesOutAndStops) {
+    SpscQueue<int> queue(4);
+    EXPECT_FALSE(queue.pop(std::chrono::milliseconds(1)).has_value());
+
+    std::thread consumer([&] { EXPECT_FALSE(queue.pop(std::chrono::seconds(30)).has_value()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    queue.stop();
+    consumer.join();
+}
+
+TEST(SpscQueueTest, DestroysItemsLeftInTheRing) {
+    auto tracked = std::make_shared<int>(0);
+    {
+        SpscQueue<std::shared_ptr<int>> queue(4);
+        queue.push(tracked);
+        queue.push(tracked);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(SpscQueueTest, ProducerAndConsumerThreadsKeepOrder) {
+    constexpr int kItems = 200'000;
+    SpscQueue<int> queue(64);
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            queue.push(i);
+        }
+    });
+
+    int expected = 0;
+    std::vector<int> batch;
+    while (expected < kItems) {
+        batch.clear();
+        if (queue.pop_n(std::back_inserter(batch), 16) == 0) {
+            if (auto value = queue.pop()) {
+                batch.push_back(*value);
+            }
+        }
+        for (int value : batch) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+}
@@ -0,0 +1,68 @@
+// test/WaitStrategyTest.cpp
+#include <gtest/gtest.h>
+#include "MessageQueue.hpp"
+#include "MpmcQueue.hpp"
+#include "SpscQueue.hpp"
+#include "WaitStrategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WaitStrategyTest : public ::testing::TestWithParam<WaitStrategy> {};
+
+TEST_P(WaitStrategyTest, TimesOutWhenNothingArrives) {
+    Waiter waiter(GetParam());
+    auto start = Waiter::Clock::now();
+    EXPECT_FALSE(waiter.waitUntil([] { return false; }, start + std::chrono::milliseconds(5)));
+    EXPECT_GE(Waiter::Clock::now() - start, std::chrono::milliseconds(5));
+}
+
+TEST_P(WaitStrategyTest, NotifyWakesAnUnboundedWait) {
+    Waiter waiter(GetParam());
+    std::atomic<bool> published{false};
+    std::thread consumer([&] { waiter.wait([&] { return published.load(std::memory_order_acquire); }); });
+    // Long enough for the sleeping strategies to be asleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    published.store(true, std::memory_order_release);
+    waiter.notify();
+    consumer.join();
+}
+
+TEST_P(WaitStrategyTest, QueuesHandOffAndStopWithEveryStrategy) {
+    constexpr int kItems = 20'000;
+    SpscQueue<int> spsc(16, GetParam());
+    MpmcQueue<int> mpmc(16, GetParam());
+    MessageQueue<int> unbounded(GetParam());
+    std::thread producer([&] {
+        for (int i = 0; i < kItems; ++i) {
+            spsc.push(i);
+            mpmc.push(i);
+            unbounded.push(i);
+        }
+    });
+    for (int i = 0; i < kItems; ++i) {
+        ASSERT_EQ(spsc.pop(std::chrono::seconds(10)), i);
+        ASSERT_EQ(mpmc.pop(std::chrono::seconds(10)), i);
+        ASSERT_EQ(unbounded.pop(std::chrono::seconds(10)), i);
+    }
+    producer.join();
+
+    std::thread idle([&] { EXPECT_FALSE(mpmc.pop(std::chrono::seconds(30)).has_value()); });
+    std::thread idleUnbounded([&] { EXPECT_FALSE(unbounded.pop(std::chrono::seconds(30)).has_value()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    mpmc.stop();
+    unbounded.stop();
+    idle.join();
+    idleUnbounded.join();
+}
+
+INSTANTIATE_TEST_SUITE_P(AllStrategies, WaitStrategyTest,
+                         ::testing::Values(WaitStrategy::BUSY_SPIN, WaitStrategy::SPIN_YIELD,
+                                           WaitStrategy::SPIN_PARK, WaitStrategy::BLOCKING),
+                         [](const ::testing::TestParamInfo<WaitStrategy>& info) {
+                             std::string name = waitStrategyName(info.param);
+                             name.erase(std::remove(name.begin(), name.end(), '-'), name.end());
+                             return name;
+                         });